@@ -258,6 +258,18 @@ BOOST_PYTHON_MODULE(_algorithm) {
 		.add_property("ftol",&algorithm::cmaes::get_ftol,&algorithm::cmaes::set_ftol)
 		.add_property("xtol",&algorithm::cmaes::get_xtol,&algorithm::cmaes::set_xtol);
 
+	// CMAES with restarts.
+	enum_<algorithm::cmaes_restart::restart_type>("_cmaes_restart_type")
+		.value("IPOP", algorithm::cmaes_restart::IPOP)
+		.value("BIPOP", algorithm::cmaes_restart::BIPOP);
+
+	algorithm_wrapper<algorithm::cmaes_restart>("cmaes_restart","CMAES with IPOP/BIPOP restarts")
+		.def(init<optional<const algorithm::cmaes &, int, algorithm::cmaes_restart::restart_type, double> >())
+		.add_property("cmaes",&algorithm::cmaes_restart::get_cmaes,&algorithm::cmaes_restart::set_cmaes)
+		.add_property("restarts",&algorithm::cmaes_restart::get_restarts,&algorithm::cmaes_restart::set_restarts)
+		.add_property("restart_type",&algorithm::cmaes_restart::get_restart_type,&algorithm::cmaes_restart::set_restart_type)
+		.add_property("inc_popsize",&algorithm::cmaes_restart::get_inc_popsize,&algorithm::cmaes_restart::set_inc_popsize);
+
 	// Monte-carlo.
 	algorithm_wrapper<algorithm::monte_carlo>("monte_carlo","Monte-Carlo search.")
 		.def(init<int>());
@@ -398,19 +410,23 @@ BOOST_PYTHON_MODULE(_algorithm) {
 	algorithm_wrapper<algorithm::de>("de", "Differential evolution algorithm.\n")
 		.def(init<optional<int,const double &, const double &, int, double, double> >())
 		.add_property("cr",&algorithm::de::get_cr,&algorithm::de::set_cr)
-		.add_property("f",&algorithm::de::get_f,&algorithm::de::set_f);
+		.add_property("f",&algorithm::de::get_f,&algorithm::de::set_f)
+		.add_property("batch_evaluation",&algorithm::de::get_batch_evaluation,&algorithm::de::set_batch_evaluation);
 
 	// Differential evolution (jDE)
 	algorithm_wrapper<algorithm::jde>("jde", "Self-Adaptive Differential Evolution Algorithm: jDE.\n")
-		.def( init<optional<int, int, int, double, double, bool> >());
+		.def( init<optional<int, int, int, double, double, bool> >())
+		.add_property("batch_evaluation",&algorithm::jde::get_batch_evaluation,&algorithm::jde::set_batch_evaluation);
 
 	// Differential evolution (mde_pbx)
 	algorithm_wrapper<algorithm::mde_pbx>("mde_pbx", "Self-Adaptive Differential Evolution Algorithm: mde_pbx.\n")
-		.def(init<optional<int, double, double, double, double> >());
+		.def(init<optional<int, double, double, double, double> >())
+		.add_property("batch_evaluation",&algorithm::mde_pbx::get_batch_evaluation,&algorithm::mde_pbx::set_batch_evaluation);
 
 	// Differential evolution (our own brew)
 	algorithm_wrapper<algorithm::de_1220>("de_1220", "Differential Evolution Algorithm (our brew ...).\n")
-		.def(init<optional<int, int, std::vector<int>, bool, double, double> >());
+		.def(init<optional<int, int, std::vector<int>, bool, double, double> >())
+		.add_property("batch_evaluation",&algorithm::de_1220::get_batch_evaluation,&algorithm::de_1220::set_batch_evaluation);
 		
 	// Simulated annealing, Corana's version.
 	algorithm_wrapper<algorithm::sa_corana>("sa_corana","Simulated annealing, Corana's version with adaptive neighbourhood.")
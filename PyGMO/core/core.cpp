@@ -135,6 +135,11 @@ inline static void population_set_x(population &pop, int n, const decision_vecto
 	pop.set_x(boost::numeric_cast<population::size_type>(n),x);
 }
 
+inline static void population_push_back(population &pop, const decision_vector &x)
+{
+	pop.push_back(x);
+}
+
 inline static void population_set_v(population &pop, int n, const decision_vector &v)
 {
 	pop.set_v(boost::numeric_cast<population::size_type>(n),v);
@@ -275,6 +280,7 @@ BOOST_PYTHON_MODULE(_core)
 	REGISTER_CONVERTER(std::vector<base_island_ptr>, variable_capacity_policy);
 	REGISTER_CONVERTER(std::vector<pagmo::algorithm::base_ptr>, variable_capacity_policy);
 	REGISTER_CONVERTER(std::vector<pagmo::problem::base_ptr>, variable_capacity_policy);
+	REGISTER_CONVERTER(std::vector<population::champion_type>, variable_capacity_policy);
 	
 #ifdef PAGMO_ENABLE_KEP_TOOLBOX
 	REGISTER_CONVERTER(std::vector<kep_toolbox::planet::planet_ptr>, variable_capacity_policy);
@@ -307,7 +313,7 @@ BOOST_PYTHON_MODULE(_core)
 		.def("get_worst_idx",&population::get_worst_idx,"Get index of worst individual.")
 		.def("set_x", &population_set_x,"Set decision vector of individual at position n.")
 		.def("set_v", &population_set_v,"Set velocity of individual at position n.")
-		.def("push_back", &population::push_back,"Append individual with given decision vector at the end of the population.")
+		.def("push_back", &population_push_back,"Append individual with given decision vector at the end of the population.")
 		.def("erase", &population::erase, "Erase individual at position")
 		.def("mean_velocity", &population::mean_velocity, "Calculates the mean velocity across particles")
 		.def("race", &race_return_tuple, "Race the individuals")
@@ -351,6 +357,8 @@ BOOST_PYTHON_MODULE(_core)
 		.def("get_evolution_time", &base_island::get_evolution_time,"Gives the evolution time in milliseconds.")
 		.def("evolve", &base_island::evolve,"Evolve island n times.")
 		.def("evolve_t", &base_island::evolve_t,"Evolve island for at least n milliseconds.")
+		.def("evolve_fevals", &base_island::evolve_fevals,"Evolve island for at least n function evaluations.")
+		.def("get_champion", &base_island::get_champion,"Get the champion of the island, without waiting for the evolution to terminate.")
 		.def("join", &base_island::join,"Wait for evolution to complete.")
 		.def("busy", &base_island::busy,"Check if island is evolving.")
 		.def("interrupt", &base_island::interrupt,"Interrupt evolution.")
@@ -398,13 +406,20 @@ BOOST_PYTHON_MODULE(_core)
 		.def("evolve", &archipelago::evolve,"Evolve archipelago *n* times.",boost::python::args("n"))
 		.def("evolve_batch", &archipelago::evolve_batch,"Evolve archipelago *n* times in batches of *b* islands.",boost::python::args("n","b"))
 		.def("evolve_t", &archipelago::evolve_t,"Evolve archipelago for at least *n* milliseconds.",boost::python::args("n"))
+		.def("evolve_fevals", &archipelago::evolve_fevals,"Evolve archipelago for at least *n* function evaluations on each island.",boost::python::args("n"))
+		.def("get_champions", &archipelago::get_champions,"Get the champions of the islands, without waiting for the evolution to terminate.")
 		.def("join", &archipelago::join,"Wait for evolution to complete.")
 		.def("interrupt", &archipelago::interrupt,"Interrupt evolution.")
 		.def("busy", &archipelago::busy,"Check if archipelago is evolving.")
 		.def("push_back", &archipelago::push_back,"Append island.")
 		.def("set_algorithm", &archipelago_set_algorithm,"Set algorithm on island.")
+		.def("set_checkpoint", &archipelago::set_checkpoint,"Save the islands into the files starting with *prefix* while evolving, at most every *t* milliseconds.",boost::python::args("prefix","t"))
+		.def("checkpoint", &archipelago::checkpoint,"Bring the checkpoint up to date.")
+		.def("load_checkpoint", &archipelago::load_checkpoint,"Restore the archipelago from the checkpoint files starting with *prefix*.",boost::python::args("prefix"))
 		.def("dump_migr_history", &archipelago::dump_migr_history)
 		.def("clear_migr_history", &archipelago::clear_migr_history)
+		.add_property("migr_history_capacity", &archipelago::get_migr_history_capacity, &archipelago::set_migr_history_capacity,
+			"Maximum number of records kept in the migration history.")
 		.def("cpp_loads", &py_cpp_loads<archipelago>,
 			"Load C++ serialized representation from string *str*.\n\n"
 			":Parameters:\n"
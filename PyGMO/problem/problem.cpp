@@ -202,6 +202,9 @@ BOOST_PYTHON_MODULE(_problem) {
 		.add_property("best_c",make_function(&problem::base::get_best_c,return_value_policy<copy_const_reference>()),"Best known constraints vector(s).")
 		.add_property("fevals",&problem::base::get_fevals,"Number of function evaluations.")
 		.add_property("cevals",&problem::base::get_cevals,"Number of constraints evaluations.")
+		.add_property("cache_capacity",&problem::base::get_cache_capacity,&problem::base::set_cache_capacity,"Capacity of the fitness and constraints caches.")
+		.add_property("cache_hits",&problem::base::get_cache_hits,"Number of fitness and constraints computations served by the caches.")
+		.add_property("cache_misses",&problem::base::get_cache_misses,"Number of fitness and constraints computations not found in the caches.")
 		.def_pickle(python_class_pickle_suite<problem::python_base>());
 
 	// Expose base stochastic problem class, including the virtual methods. Here we explicitly
@@ -87,6 +87,12 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		{
 			return this->base::get_name();
 		}
+		// Python objective functions cannot be called from the threads of the pool used by the default batch
+		// evaluation, hence batches are evaluated serially in the calling thread.
+		bool parallel_batch() const
+		{
+			return false;
+		}
 		std::string human_readable_extra() const
 		{
 			if (boost::python::override f = this->get_override("human_readable_extra")) {
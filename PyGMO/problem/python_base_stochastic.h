@@ -83,6 +83,12 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
 		{
 			return this->base_stochastic::get_name();
 		}
+		// Python objective functions cannot be called from the threads of the pool used by the default batch
+		// evaluation, hence batches are evaluated serially in the calling thread.
+		bool parallel_batch() const
+		{
+			return false;
+		}
 		std::string human_readable_extra() const
 		{
 			if (boost::python::override f = this->get_override("human_readable_extra")) {
@@ -0,0 +1,85 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <cstddef>
+#include <iostream>
+#include "../src/pagmo.h"
+
+
+/**
+DESCRITPION: This example times the computation of the Pareto fronts of populations of DTLZ2 individuals with 2, 3 and 5 objectives.
+The fast non-dominated sorting, used by the population when the problem adopts the standard Pareto dominance, is compared with
+the pre-existing code path, based on the domination lists of the individuals, which the population follows when
+problem::base::standard_dominance() returns false. The latter is skipped for more than 10^4 individuals.
+
+CPU TIME: the example completes in about a minute.
+*/
+
+using namespace pagmo;
+
+// DTLZ2 problem forcing the population to follow the code path based on the domination lists.
+class dtlz_pairwise: public problem::dtlz
+{
+	public:
+		dtlz_pairwise(fitness_vector::size_type fdim):problem::dtlz(2,5,fdim) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new dtlz_pairwise(*this));
+		}
+		bool standard_dominance() const
+		{
+			return false;
+		}
+};
+
+// Wall-clock time, in seconds, of the computation of the Pareto fronts of the population.
+double time_fronts(const population &pop) {
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	pop.compute_pareto_fronts();
+	return (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() * 1E-6;
+}
+
+int main()
+{
+	const population::size_type sizes[] = {100, 1000, 10000, 100000};
+	const fitness_vector::size_type dimensions[] = {2, 3, 5};
+	std::cout << "N\tM\tfast [s]\tdomination lists [s]" << std::endl;
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(population::size_type); ++i) {
+		for (std::size_t j = 0; j < sizeof(dimensions) / sizeof(fitness_vector::size_type); ++j) {
+			// Both populations are initialised with the same seed, hence they hold the same individuals.
+			const population pop(problem::dtlz(2,5,dimensions[j]),sizes[i],123);
+			std::cout << sizes[i] << "\t" << dimensions[j] << "\t" << time_fronts(pop) << "\t";
+			if (sizes[i] <= 10000) {
+				const population pop_pairwise(dtlz_pairwise(dimensions[j]),sizes[i],123);
+				std::cout << time_fronts(pop_pairwise);
+			} else {
+				std::cout << "-";
+			}
+			std::cout << std::endl;
+		}
+	}
+	return 0;
+}
@@ -81,7 +81,7 @@ cmaes::cmaes(int gen, double cc, double cs, double c1, double cmu, double sigma0
 	//Initialize the algorithm memory
 	m_mean = Eigen::VectorXd::Zero(1);
 	m_variation = Eigen::VectorXd::Zero(1);
-	m_newpop = std::vector<Eigen::VectorXd>();
+	m_newpop = Eigen::MatrixXd();
 	m_B = Eigen::MatrixXd::Identity(1,1);
 	m_D = Eigen::MatrixXd::Identity(1,1);
 	m_C = Eigen::MatrixXd::Identity(1,1);
@@ -115,7 +115,9 @@ struct cmp_using_cur
 
 /// Evolve implementation.
 /**
- * Run CMAES
+ * Run CMAES. The lam individuals of each generation are stored as the columns of a matrix, so that sampling and
+ * the rank-mu update of the covariance matrix are performed as single matrix products. Each generation is evaluated in batch
+ * via problem::base::batch_objfun(), hence in parallel.
  *
  * @param[in,out] pop input/output pagmo::population to be evolved.
  */
@@ -194,7 +196,7 @@ void cmaes::evolve(population &pop) const
 	// Algorithm's Memory. This allows the algorithm to start from its last "state"
 	VectorXd mean(m_mean);
 	VectorXd variation(m_variation);
-	std::vector<VectorXd> newpop(m_newpop);
+	MatrixXd newpop(m_newpop);
 	MatrixXd B(m_B);
 	MatrixXd D(m_D);
 	MatrixXd C(m_C);
@@ -206,21 +208,21 @@ void cmaes::evolve(population &pop) const
 	double sigma(m_sigma);
 	double var_norm = 0;
 
-	// Some buffers
+	// Some buffers. The individuals are stored as the columns of the matrices, so that each of them is contiguous in memory.
 	VectorXd meanold = VectorXd::Zero(N);
-	MatrixXd Dinv = MatrixXd::Identity(N,N);
-	MatrixXd Cold = MatrixXd::Identity(N,N);
-	VectorXd tmp = VectorXd::Zero(N);
-	std::vector<VectorXd> elite(mu,tmp);
-	decision_vector dumb(N,0);
+	MatrixXd Z(N,lam);
+	MatrixXd elite(N,mu);
+	MatrixXd BD(N,N);
+	std::vector<decision_vector> x(lam,decision_vector(N,0));
+	std::vector<fitness_vector> f;
 
 	// If the algorithm is called for the first time on this problem dimension / pop size or if m_memory is false we erease the memory of past calls
-	if ( (m_newpop.size() != lam) || ((unsigned int)(m_newpop[0].rows() ) != N) || (m_memory==false) ) {
+	if ( ((population::size_type)(m_newpop.cols()) != lam) || ((unsigned int)(m_newpop.rows() ) != N) || (m_memory==false) ) {
 		mean.resize(N);
 		for (problem::base::size_type i=0;i<N;++i){
 			mean(i) = pop.champion().x[i];
 		}
-		newpop = std::vector<VectorXd>(lam,tmp);
+		newpop.resize(N,lam);
 		variation.resize(N);
 
 		//We define the satrting B,D,C
@@ -241,6 +243,8 @@ void cmaes::evolve(population &pop) const
 		counteval = 0;
 		eigeneval = 0;
 	}
+	// B*D is only needed after an eigen-decomposition of C. As D is diagonal, the product costs O(N^2).
+	BD = B * D.diagonal().asDiagonal();
 	
 	// ----------------------------------------------//
 	// HERE WE START THE REAL ALGORITHM              //
@@ -264,24 +268,26 @@ void cmaes::evolve(population &pop) const
 	
 	SelfAdjointEigenSolver<MatrixXd> es(N);
 	for (std::size_t g = 0; g < m_gen; ++g) {
-		// 1 - We generate and evaluate lam new individuals
+		// 1 - We generate lam new individuals
 
+		// 1a - we create lam randomly normal distributed vectors (one per column)
 		for (population::size_type i = 0; i<lam; ++i ) {
-			// 1a - we create a randomly normal distributed vector
 			for (problem::base::size_type j=0; j<N; ++j){
-				tmp(j) = normally_distributed_number();
+				Z(j,i) = normally_distributed_number();
 			}
-			// 1b - and store its transformed value in the newpop
-			newpop[i] = mean + (sigma * B * D * tmp);
 		}
-		//This is evaluated here on the last generated tmp and will be used only as 
+		// 1b - and store their transformed values in the newpop, with a single matrix product
+		newpop.noalias() = BD * Z;
+		//This is evaluated here on the last generated vector and will be used only as 
 		//a stopping criteria
-		var_norm = (sigma * B * D * tmp).norm();
+		var_norm = sigma * newpop.col(lam - 1).norm();
+		newpop *= sigma;
+		newpop.colwise() += mean;
 		
 		//1b - Check the exit conditions (every 5 generations) // we need to do it here as 
-		//termination is defined on tmp
+		//termination is defined on the last generated vector
 		if (g%5 == 0) {
-			if  ( (sigma*B*D*tmp).norm() < m_xtol ) {
+			if  ( var_norm < m_xtol ) {
 				if (m_screen_output) { 
 					std::cout << "Exit condition -- xtol < " <<  m_xtol << std::endl;
 				}
@@ -298,13 +304,15 @@ void cmaes::evolve(population &pop) const
 			}
 		}
 
-		// 1c - we fix the bounds 
+		// 1c - we fix the bounds and copy the individuals into decision vectors
 		for (population::size_type i = 0; i<lam; ++i ) {
+			double *xi = newpop.col(i).data();
 			for (decision_vector::size_type j = 0; j<N; ++j ) {
-				if ( (newpop[i](j) < lb[j]) || (newpop[i](j) > ub[j]) ) {
-					newpop[i](j) = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
+				if ( (xi[j] < lb[j]) || (xi[j] > ub[j]) ) {
+					xi[j] = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
 				}
 			}
+			std::copy(xi,xi + N,x[i].begin());
 		}
 
 		// 2 - We Evaluate the new population (if the problem is stochastic change seed first)
@@ -313,22 +321,18 @@ void cmaes::evolve(population &pop) const
 			//would it make sense to use best_x also?
 			dynamic_cast<const pagmo::problem::base_stochastic &>(prob).set_seed(m_urng());
 			pop.clear(); // Removes memory based on different seeds (champion and best_x, best_f, best_c)
+			prob.batch_objfun(f,x);
 			for (population::size_type i = 0; i<lam; ++i ) {
-			  	for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
-				}
-				pop.push_back(dumb);
+				pop.push_back(x[i],f[i],constraint_vector());
 			}
 			counteval += lam;
 		}
 		catch (const std::bad_cast& e)
 		{
 			// Reinsertion (original method)
+			prob.batch_objfun(f,x);
 			for (population::size_type i = 0; i<lam; ++i ) {
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
-				}
-				pop.set_x(i,dumb);
+				pop.set_x(i,x[i],f[i],constraint_vector());
 			}
 			counteval += lam;
 		}
@@ -344,18 +348,14 @@ void cmaes::evolve(population &pop) const
 		std::sort(best_idx.begin(),best_idx.end(),cmp);
 		best_idx.resize(mu);
 		for (population::size_type i = 0; i<mu; ++i ) {
-			for (decision_vector::size_type j = 0; j<N; ++j ) {
-				elite[i](j) = pop.get_individual(best_idx[i]).cur_x[j];
-			}
+			const decision_vector &cur_x = pop.get_individual(best_idx[i]).cur_x;
+			std::copy(cur_x.begin(),cur_x.end(),elite.col(i).data());
 		}
 
 
 		// 3 - Compute the new elite mean storing the old one
 		meanold=mean;
-		mean = elite[0]*weights(0);
-		for (population::size_type i = 1; i<mu; ++i ) {
-			mean += elite[i]*weights(i);
-		}
+		mean.noalias() = elite * weights;
 
 		// 4 - Update evolution paths
 		ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * invsqrtC * (mean-meanold) / sigma;
@@ -363,16 +363,13 @@ void cmaes::evolve(population &pop) const
 		hsig = (ps.squaredNorm() / N / (1-std::pow((1-cs),(2.0*counteval/lam))) ) < (2.0 + 4/(N+1));
 		pc = (1-cc) * pc + hsig * std::sqrt(cc*(2-cc)*mueff) * (mean-meanold) / sigma;
 
-		// 5 - Adapt Covariance Matrix
-		Cold = C;
-		C = (elite[0]-meanold)*(elite[0]-meanold).transpose()*weights(0);
-		for (population::size_type i = 1; i<mu; ++i ) {
-			C += (elite[i]-meanold)*(elite[i]-meanold).transpose()*weights(i);
-		}
-		C /= sigma*sigma;
-		C = (1-c1-cmu) * Cold +
-			cmu * C +
-			c1 * ((pc * pc.transpose()) + (1-hsig) * cc * (2-cc) * Cold);
+		// 5 - Adapt Covariance Matrix. The rank-mu update is computed as a single matrix product
+		// of the (weighted) steps of the elite.
+		elite.colwise() -= meanold;
+		elite /= sigma;
+		C *= 1-c1-cmu + c1 * (1-hsig) * cc * (2-cc);
+		C.noalias() += c1 * pc * pc.transpose();
+		C.noalias() += (elite * (cmu * weights).asDiagonal()) * elite.transpose();
 
 		//6 - Adapt sigma
 		sigma *= std::exp( std::min( 0.6, (cs/damps) * (ps.norm()/chiN - 1) ) );
@@ -380,12 +377,12 @@ void cmaes::evolve(population &pop) const
 			std::cout << "eigen: " << es.info() << std::endl;
 			std::cout << "B: " << B << std::endl;
 			std::cout << "D: " << D << std::endl;
-			std::cout << "Dinv: " << D << std::endl;
 			std::cout << "invsqrtC: " << invsqrtC << std::endl;
 			pagmo_throw(value_error,"NaN!!!!! in CMAES");
 		}
 
-		//7 - Perform eigen-decomposition of C
+		//7 - Perform eigen-decomposition of C, lazily as in Hansen's tutorial: B and D are
+		// recomputed only once every lam/(c1+cmu)/N/10 function evaluations
 		if ( (counteval - eigeneval) > (lam/(c1+cmu)/N/10) ) {		//achieve O(N^2)
 			eigeneval = counteval;
 			C = (C+C.transpose())/2;				//enforce symmetry
@@ -396,10 +393,8 @@ void cmaes::evolve(population &pop) const
 				for (decision_vector::size_type j = 0; j<N; ++j ) {
 					D(j,j) = std::sqrt( std::max(1e-20,D(j,j)) );				//D contains standard deviations now
 				}
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					Dinv(j,j) = 1.0 / D(j,j);
-				}
-				invsqrtC = B*Dinv*B.transpose();
+				BD = B * D.diagonal().asDiagonal();
+				invsqrtC.noalias() = B * D.diagonal().cwiseInverse().asDiagonal() * B.transpose();
 			} //if eigendecomposition fails just skip it and keep pevious succesful one.
 		}
 		
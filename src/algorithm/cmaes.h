@@ -121,7 +121,7 @@ private:
 	// "Memory" data members (these are here as to enable control over each single generation)
 	mutable Eigen::VectorXd m_mean;
 	mutable Eigen::VectorXd m_variation;
-	mutable std::vector<Eigen::VectorXd> m_newpop;
+	mutable Eigen::MatrixXd m_newpop;
 	mutable Eigen::MatrixXd m_B;
 	mutable Eigen::MatrixXd m_D;
 	mutable Eigen::MatrixXd m_C;
@@ -0,0 +1,219 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "../exceptions.h"
+#include "../population.h"
+#include "../types.h"
+#include "base.h"
+#include "cmaes.h"
+#include "cmaes_restart.h"
+
+namespace pagmo { namespace algorithm {
+
+/// Constructor.
+/**
+ * @param[in] algo cmaes to be restarted (its memory setting is ignored, as each run starts from scratch).
+ * @param[in] restarts number of restarts (the total number of runs is restarts + 1).
+ * @param[in] type restart strategy.
+ * @param[in] inc_popsize factor by which the population size is multiplied at each restart in the large population regime.
+ * @throws value_error if restarts is negative or if inc_popsize is smaller than 1.
+ */
+cmaes_restart::cmaes_restart(const cmaes &algo, int restarts, restart_type type, double inc_popsize):
+	base(),m_cmaes(algo),m_restarts(restarts),m_type(type),m_inc_popsize(inc_popsize)
+{
+	if (restarts < 0) {
+		pagmo_throw(value_error,"number of restarts must be nonnegative");
+	}
+	if (!(inc_popsize >= 1)) {
+		pagmo_throw(value_error,"the population size increase factor must be at least 1");
+	}
+}
+
+/// Clone method.
+base_ptr cmaes_restart::clone() const
+{
+	return base_ptr(new cmaes_restart(*this));
+}
+
+/// Evolve implementation.
+/**
+ * Run cmaes with restarts.
+ *
+ * @param[in,out] pop input/output pagmo::population to be evolved.
+ */
+void cmaes_restart::evolve(population &pop) const
+{
+	// Let's store some useful variables.
+	const population::size_type lam0 = pop.size();
+
+	// Get out if there is nothing to do.
+	if (lam0 == 0 || m_cmaes.get_gen() == 0) {
+		return;
+	}
+
+	boost::uniform_real<double> uniform(0.0,1.0);
+	boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > randomly_distributed_number(m_drng,uniform);
+
+	const double sigma0 = m_cmaes.get_sigma();
+	// Population size of the last run in the large population regime, and evaluations spent
+	// in each regime (the first run belongs to the large population regime).
+	population::size_type large_size = lam0;
+	unsigned int large_evals = 0, small_evals = 0;
+
+	for (int r = 0; r <= m_restarts; ++r) {
+		population::size_type size = large_size;
+		double sigma = sigma0;
+		bool small = false;
+		if (r != 0) {
+			if (m_type == BIPOP && small_evals < large_evals) {
+				// lam = lam0 * (large_size / (2 lam0))^(u^2), sigma = sigma0 * 10^(-2u), with u uniform in [0,1].
+				const double u = randomly_distributed_number();
+				size = boost::numeric_cast<population::size_type>(std::floor(lam0 * std::pow(0.5 * large_size / lam0,u * u)));
+				sigma = sigma0 * std::pow(10.0,-2 * randomly_distributed_number());
+				small = true;
+			} else {
+				large_size = boost::numeric_cast<population::size_type>(std::floor(large_size * m_inc_popsize));
+				size = large_size;
+			}
+			// cmaes needs at least 5 individuals.
+			size = std::max<population::size_type>(size,5);
+		}
+
+		const unsigned int fevals = pop.problem().get_fevals();
+		population working_pop = (r == 0) ? pop : population(pop.problem(),boost::numeric_cast<int>(size),m_urng());
+		cmaes algo(m_cmaes.get_gen(),m_cmaes.get_cc(),m_cmaes.get_cs(),m_cmaes.get_c1(),m_cmaes.get_cmu(),sigma,m_cmaes.get_ftol(),m_cmaes.get_xtol(),false);
+		algo.reset_rngs(m_urng());
+		algo.evolve(working_pop);
+		// NOTE: the problem of the working population is a copy of the one of pop, hence its counter started from fevals.
+		const unsigned int run_evals = working_pop.problem().get_fevals() - fevals;
+		if (small) {
+			small_evals += run_evals;
+		} else {
+			large_evals += run_evals;
+		}
+		// Report the evaluations performed on the copy to the problem of pop.
+		pop.problem().add_fevals(run_evals);
+
+		const population::size_type best_idx = working_pop.get_best_idx(), worst_idx = pop.get_worst_idx();
+		const population::individual_type &best = working_pop.get_individual(best_idx);
+		if (working_pop.problem().compare_fc(best.cur_f,best.cur_c,pop.get_individual(worst_idx).cur_f,pop.get_individual(worst_idx).cur_c)) {
+			//update best population replacing its worst individual with the good one just produced,
+			//reusing its fitness and constraints (already evaluated and accounted for above).
+			pop.set_x(worst_idx,best.cur_x,best.cur_f,best.cur_c);
+			pop.set_v(worst_idx,best.cur_v);
+		}
+		if (m_screen_output) {
+			std::cout << r << ". " << "\tPopulation size: " << size << "\tsigma: " << sigma << "\tCurrent run best: "
+				<< best.cur_f << "\tOverall champion: " << pop.champion().f << std::endl;
+		}
+	}
+}
+
+/// Algorithm name
+std::string cmaes_restart::get_name() const
+{
+	return "CMAES with restarts";
+}
+
+/// Get a copy of the internal cmaes.
+/**
+ * @return copy of the cmaes being restarted.
+ */
+cmaes cmaes_restart::get_cmaes() const
+{
+	return m_cmaes;
+}
+
+/// Set the internal cmaes.
+/**
+ * @param[in] algo cmaes to be restarted.
+ */
+void cmaes_restart::set_cmaes(const cmaes &algo)
+{
+	m_cmaes = algo;
+}
+
+/// Setter for m_restarts
+/**
+ * @throws value_error if restarts is negative.
+ */
+void cmaes_restart::set_restarts(const int restarts)
+{
+	if (restarts < 0) {
+		pagmo_throw(value_error,"number of restarts must be nonnegative");
+	}
+	m_restarts = restarts;
+}
+/// Getter for m_restarts
+int cmaes_restart::get_restarts() const {return m_restarts;}
+
+/// Setter for m_type
+void cmaes_restart::set_restart_type(const restart_type type) {m_type = type;}
+/// Getter for m_type
+cmaes_restart::restart_type cmaes_restart::get_restart_type() const {return m_type;}
+
+/// Setter for m_inc_popsize
+/**
+ * @throws value_error if inc_popsize is smaller than 1.
+ */
+void cmaes_restart::set_inc_popsize(const double inc_popsize)
+{
+	if (!(inc_popsize >= 1)) {
+		pagmo_throw(value_error,"the population size increase factor must be at least 1");
+	}
+	m_inc_popsize = inc_popsize;
+}
+/// Getter for m_inc_popsize
+double cmaes_restart::get_inc_popsize() const {return m_inc_popsize;}
+
+/// Extra human readable algorithm info.
+/**
+ * Will return a formatted string displaying the parameters of the algorithm.
+ */
+std::string cmaes_restart::human_readable_extra() const
+{
+	std::ostringstream s;
+	s << "restarts:" << m_restarts << ' '
+	  << "type:" << (m_type == IPOP ? "IPOP" : "BIPOP") << ' '
+	  << "inc_popsize:" << m_inc_popsize << ' '
+	  << "gen:" << m_cmaes.get_gen() << ' '
+	  << "sigma0:" << m_cmaes.get_sigma() << ' '
+	  << "ftol:" << m_cmaes.get_ftol() << ' '
+	  << "xtol:" << m_cmaes.get_xtol();
+	return s.str();
+}
+
+}} //namespaces
+
+BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::algorithm::cmaes_restart)
@@ -0,0 +1,106 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_ALGORITHM_CMAES_RESTART_H
+#define PAGMO_ALGORITHM_CMAES_RESTART_H
+
+#include <string>
+
+#include "../config.h"
+#include "../population.h"
+#include "../serialization.h"
+#include "base.h"
+#include "cmaes.h"
+
+
+namespace pagmo { namespace algorithm {
+
+/// CMAES with restarts (IPOP and BIPOP)
+/**
+ * Runs algorithm::cmaes over and over, restarting it from freshly initialised populations. Each run starts from
+ * the parameters of the internal cmaes (sigma included) and without memory of the previous runs, and terminates
+ * according to the cmaes stopping criteria (or after its number of generations).
+ *
+ * Two restart strategies are available:
+ * - IPOP: the population size is multiplied by a constant factor at each restart
+ *   (A. Auger, N. Hansen, "A Restart CMA Evolution Strategy With Increasing Population Size", CEC 2005),
+ * - BIPOP: restarts with increasing population size are interlaced with restarts using small populations
+ *   and small initial steps, both drawn randomly, so that the two regimes spend a similar number of
+ *   objective function evaluations (N. Hansen, "Benchmarking a BI-Population CMA-ES on the BBOB-2009 Function Testbed", GECCO 2009).
+ *
+ * The first run evolves a copy of the input population, hence its size is the default population size. At the end of each run,
+ * the best individual found replaces the worst individual of the input population, if better (as in algorithm::ms).
+ *
+ * As cmaes evaluates each generation in batch, the large populations of the late restarts are evaluated in parallel.
+ */
+class __PAGMO_VISIBLE cmaes_restart: public base
+{
+public:
+	/// Restart strategy.
+	enum restart_type {
+		IPOP = 0, ///< Increasing population size.
+		BIPOP = 1 ///< Increasing population size interlaced with small populations.
+	};
+	cmaes_restart(const cmaes & = cmaes(), int restarts = 9, restart_type = IPOP, double inc_popsize = 2);
+	base_ptr clone() const;
+	void evolve(population &) const;
+	std::string get_name() const;
+
+	cmaes get_cmaes() const;
+	void set_cmaes(const cmaes &);
+
+	void set_restarts(const int);
+	int  get_restarts() const;
+
+	void set_restart_type(const restart_type);
+	restart_type get_restart_type() const;
+
+	void   set_inc_popsize(const double);
+	double get_inc_popsize() const;
+
+protected:
+	std::string human_readable_extra() const;
+private:
+	friend class boost::serialization::access;
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & boost::serialization::base_object<base>(*this);
+		ar & m_cmaes;
+		ar & m_restarts;
+		ar & m_type;
+		ar & m_inc_popsize;
+	}
+	cmaes m_cmaes;
+	int m_restarts;
+	restart_type m_type;
+	double m_inc_popsize;
+};
+
+}} //namespaces
+
+BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::cmaes_restart)
+
+#endif // PAGMO_ALGORITHM_CMAES_RESTART_H
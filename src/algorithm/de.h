@@ -61,6 +61,9 @@ namespace pagmo { namespace algorithm {
  *
  * NOTE3: the velocity is also updated along DE whenever a new chromosome is accepted.
  *
+ * NOTE4: all the trial vectors of a generation can be evaluated at once, in parallel (see set_batch_evaluation()).
+ * The results are the same as with serial evaluation.
+ *
  * @see http://www.icsi.berkeley.edu/~storn/code.html for the official DE web site
  * @see http://www.springerlink.com/content/x555692233083677/ for the paper that introduces Differential Evolution
  *
@@ -78,6 +81,8 @@ public:
 	double get_cr() const;
 	void set_f(double cr);
 	double get_f() const;
+	void set_batch_evaluation(bool);
+	bool get_batch_evaluation() const;
 protected:
 	std::string human_readable_extra() const;
 private:
@@ -92,6 +97,7 @@ private:
 		ar & const_cast<double &>(m_ftol);
 		ar & const_cast<double &>(m_xtol);
 		ar & const_cast<int &>(m_strategy);
+		ar & m_batch_evaluation;
 	}
 	// Number of generations.
 	const int m_gen;
@@ -103,7 +109,8 @@ private:
 	const int m_strategy;
 	const double m_ftol;
 	const double m_xtol;
-	
+	// Batch evaluation of the trial vectors
+	bool m_batch_evaluation;
 };
 
 }}
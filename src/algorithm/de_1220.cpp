@@ -53,7 +53,7 @@ namespace pagmo { namespace algorithm {
  * the [1,18] range
  */
 de_1220::de_1220(int gen, int variant_adptv, const std::vector<int> & allowed_variants, bool memory, double ftol, double xtol):base(), m_gen(gen),
-	 m_variant_adptv(variant_adptv), m_allowed_variants(allowed_variants), m_memory(memory), m_ftol(ftol), m_xtol(xtol), m_f(0), m_cr(0), m_variants(0) {
+	 m_variant_adptv(variant_adptv), m_allowed_variants(allowed_variants), m_memory(memory), m_ftol(ftol), m_xtol(xtol), m_f(0), m_cr(0), m_variants(0), m_batch_evaluation(false) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -116,9 +116,15 @@ void de_1220::evolve(population &pop) const
 	decision_vector dummy(D), tmp(D); //dummy is used for initialisation purposes, tmp to contain the mutated candidate
 	std::vector<decision_vector> popold(NP,dummy), popnew(NP,dummy);
 	decision_vector gbX(D),gbIter(D);
-	fitness_vector newfitness(1);	//new fitness of the mutaded candidate
 	fitness_vector gbfit(1);	//global best fitness
 	std::vector<fitness_vector> fit(NP,gbfit);
+	std::vector<decision_vector> trials(NP,dummy);	//trial vectors of the generation
+	std::vector<fitness_vector> trials_fit(NP,gbfit);	//fitness of the trial vectors
+	std::vector<double> trials_f(NP), trials_cr(NP);	//amplification factors and crossover probabilities of the trial vectors
+	std::vector<int> trials_variant(NP);	//variants of the trial vectors
+	// NOTE: with m_variant_adptv == 2 the trial vectors are built from the parameters accepted earlier in the same generation,
+	// hence they cannot be created all together.
+	const bool batch = m_batch_evaluation && m_variant_adptv == 1;
 
 	//We extract from pop the chromosomes and fitness associated
 	for (std::vector<double>::size_type i = 0; i < NP; ++i) {
@@ -506,31 +512,47 @@ void de_1220::evolve(population &pop) const
 				++i2;
 			}
 
+			trials[i] = tmp;
+			trials_f[i] = F;
+			trials_cr[i] = CR;
+			trials_variant[i] = VARIANT;
+			// In batch mode the trials are evaluated, all together, once the whole generation has been created.
+			if (batch && i + 1 < NP) {
+				continue;
+			}
+
 			//b) how good?
-			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] */
-			if ( pop.problem().compare_fitness(newfitness,fit[i]) ) {  /* improved objective function value ? */
-				fit[i]=newfitness;
-				popnew[i] = tmp;
-				
-				// Update the adapted parameters
-				m_cr[i] = CR;
-				m_f[i] = F;
-				m_variants[i] = VARIANT;
-				
-				// As a fitness improvment occured we move the point
-				// and thus can evaluate a new velocity
-				std::transform(tmp.begin(), tmp.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
-				
-				//updates x and v (cache avoids to recompute the objective function)
-				pop.set_x(i,popnew[i]);
-				pop.set_v(i,tmp);
-				if ( pop.problem().compare_fitness(newfitness,gbfit) ) {
-					/* if so...*/
-					gbfit=newfitness;          /* reset gbfit to new low...*/
-					gbX=popnew[i];
-				}
+			const size_t first = batch ? 0 : i;
+			if (batch) {
+				prob.batch_objfun(trials_fit, trials);    /* Evaluate all the new vectors in trials[] */
 			} else {
-				popnew[i] = popold[i];
+				prob.objfun(trials_fit[i], trials[i]);    /* Evaluate new vector in trials[i] */
+			}
+			for (size_t j = first; j <= i; ++j) {
+				if ( pop.problem().compare_fitness(trials_fit[j],fit[j]) ) {  /* improved objective function value ? */
+					fit[j]=trials_fit[j];
+					popnew[j] = trials[j];
+
+					// Update the adapted parameters
+					m_cr[j] = trials_cr[j];
+					m_f[j] = trials_f[j];
+					m_variants[j] = trials_variant[j];
+
+					// As a fitness improvment occured we move the point
+					// and thus can evaluate a new velocity
+					std::transform(trials[j].begin(), trials[j].end(), pop.get_individual(j).cur_x.begin(), tmp.begin(),std::minus<double>());
+
+					//updates x and v (the known fitness avoids to recompute the objective function)
+					pop.set_x(j,popnew[j],fit[j],constraint_vector());
+					pop.set_v(j,tmp);
+					if ( pop.problem().compare_fitness(fit[j],gbfit) ) {
+						/* if so...*/
+						gbfit=fit[j];          /* reset gbfit to new low...*/
+						gbX=popnew[j];
+					}
+				} else {
+					popnew[j] = popold[j];
+				}
 			}
 
 		}//End of the loop through the deme
@@ -545,8 +567,9 @@ void de_1220::evolve(population &pop) const
 		//9 - Check the exit conditions (every 40 generations)
 		if (gen%40) {
 			double dx = 0;
+			const population::individual_type &worst = pop.get_individual(pop.get_worst_idx()), &best = pop.get_individual(pop.get_best_idx());
 			for (decision_vector::size_type i = 0; i < D; ++i) {
-				tmp[i] = pop.get_individual(pop.get_worst_idx()).best_x[i] - pop.get_individual(pop.get_best_idx()).best_x[i];
+				tmp[i] = worst.best_x[i] - best.best_x[i];
 				dx += std::fabs(tmp[i]);
 			}
 			
@@ -557,7 +580,7 @@ void de_1220::evolve(population &pop) const
 				return;
 			}
 
-			double mah = std::fabs(pop.get_individual(pop.get_worst_idx()).best_f[0] - pop.get_individual(pop.get_best_idx()).best_f[0]);
+			double mah = std::fabs(worst.best_f[0] - best.best_f[0]);
 
 			if (mah < m_ftol) {
 				if (m_screen_output) {
@@ -581,6 +604,31 @@ std::string de_1220::get_name() const
 	return "DE - 1220";
 }
 
+/// Sets batch evaluation.
+/**
+ * In batch mode, all the trial vectors of a generation are created first and then evaluated at once via
+ * problem::base::batch_objfun(), which evaluates them in parallel. As the trial vectors are built from the previous
+ * generation only, the evolution is the same as in serial mode.
+ *
+ * Batch evaluation is available only for the self-adaptation scheme 1: with scheme 2 the trial vectors depend on the
+ * parameters accepted earlier in the same generation, and they are always evaluated one at a time.
+ *
+ * @param[in] b true to enable batch evaluation, false to evaluate the trial vectors one at a time.
+ */
+void de_1220::set_batch_evaluation(bool b)
+{
+	m_batch_evaluation = b;
+}
+
+/// Gets batch evaluation.
+/**
+ * @return true if batch evaluation is enabled, false otherwise.
+ */
+bool de_1220::get_batch_evaluation() const
+{
+	return m_batch_evaluation;
+}
+
 /// Extra human readable algorithm info.
 /**
  * @return a formatted string displaying the parameters of the algorithm.
@@ -49,6 +49,9 @@ namespace pagmo { namespace algorithm {
  *
  * NOTE3: the pagmo::population::individual_type::cur_v is also updated in DE 1220 as soon as a new chromosome is accepted.
  *
+ * NOTE4: with m_variant_adptv = 1, all the trial vectors of a generation can be evaluated at once, in parallel (see set_batch_evaluation()).
+ * The results are the same as with serial evaluation.
+ *
  * @author Dario Izzo (dario.izzo@googlemail.com)
  */
 
@@ -61,6 +64,8 @@ public:
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
+	void set_batch_evaluation(bool);
+	bool get_batch_evaluation() const;
 private:
 	static const std::vector<int> construct_default_strategies() {
 			const int tmp[8] = {2,3,7,10,13,14,15,16};
@@ -85,6 +90,7 @@ private:
 		ar & m_f;
 		ar & m_cr;
 		ar & m_variants;
+		ar & m_batch_evaluation;
 	}
 	
 	// Number of generations.
@@ -111,6 +117,9 @@ private:
 
 	// Variants of the mutation type
 	mutable std::vector<int> m_variants;
+
+	// Batch evaluation of the trial vectors
+	bool m_batch_evaluation;
 };
 
 }}
@@ -223,7 +223,8 @@ void inverover::evolve(population &pop) const
 					pos2_c2 = (pos2_c1 == Nv-1? 0:pos2_c1+1);
 					pos1_c2 = std::find(tmp_tour.begin(),tmp_tour.end(),my_pop[i2][pos2_c2])-tmp_tour.begin();
 				}
-				stop = (abs(pos1_c1-pos1_c2)==1 || static_cast<problem::base::size_type>(abs(pos1_c1-pos1_c2))==Nv-1);
+				const size_t dist_c1_c2 = (pos1_c1 > pos1_c2 ? pos1_c1 - pos1_c2 : pos1_c2 - pos1_c1);
+				stop = (dist_c1_c2 == 1 || static_cast<problem::base::size_type>(dist_c1_c2) == Nv-1);
 				if(!stop) {
 					changed = true;
 					if(pos1_c1<pos1_c2) {
@@ -53,6 +53,9 @@ namespace pagmo { namespace algorithm {
  *
  * NOTE3: the pagmo::population::individual_type::cur_v is also updated along DE as soon as a new chromosome is accepted.
  *
+ * NOTE4: with m_variant_adptv = 1, all the trial vectors of a generation can be evaluated at once, in parallel (see set_batch_evaluation()).
+ * The results are the same as with serial evaluation.
+ *
  *
  * @see http://labraj.uni-mb.si/images/0/05/CEC09_slides_Brest.pdf  where m_variant_adptv = 1 is studied.
  * @see http://sci2s.ugr.es/EAMHCO/pdfs/contributionsCEC11/05949732.pdf for a paper where a similar apporach to m_variant_adptv=2 is described
@@ -68,6 +71,8 @@ public:
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
+	void set_batch_evaluation(bool);
+	bool get_batch_evaluation() const;
 
 protected:
 	std::string human_readable_extra() const;
@@ -85,6 +90,7 @@ private:
 		ar & m_f;
 		ar & m_cr;
 		ar & const_cast<bool &>(m_memory);
+		ar & m_batch_evaluation;
 	}
 	
 	// Number of generations.
@@ -105,6 +111,9 @@ private:
 
 	// Memory option
 	const bool m_memory;
+
+	// Batch evaluation of the trial vectors
+	bool m_batch_evaluation;
 };
 
 }}
@@ -54,7 +54,7 @@ namespace pagmo { namespace algorithm {
 */
 
 mde_pbx::mde_pbx(int gen, double qperc, double nexp, double ftol, double xtol):base(), m_gen(gen), m_fsuccess(), m_fm(0.5),
-		 m_crsuccess(), m_crm(0.7), m_qperc(qperc), m_nexp(nexp), m_ftol(ftol), m_xtol(xtol) {
+		 m_crsuccess(), m_crm(0.7), m_qperc(qperc), m_nexp(nexp), m_ftol(ftol), m_xtol(xtol), m_batch_evaluation(false) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -115,7 +115,9 @@ void mde_pbx::evolve(population &pop) const
 	}
 	// Some vectors used during evolution are allocated here.
 	decision_vector dummy(D), tmp(D); 		//dummy is used for initialisation purposes, tmp to contain the mutated candidate
-	fitness_vector newfitness(1);			//new fitness of the mutated candidate
+	std::vector<decision_vector> trials(NP,dummy);	//trial vectors of the generation
+	std::vector<fitness_vector> trials_fit(NP,fitness_vector(1));	//fitness of the trial vectors
+	std::vector<double> trials_cr(NP), trials_f(NP);	//crossover probabilities and scale factors of the trial vectors
 
 	// reserve space for saving successful values for f and cr. This guarantees that no memory is allocated during
 	// the main loop
@@ -226,21 +228,34 @@ void mde_pbx::evolve(population &pop) const
 			}
 			
 			/*=======Trial mutation now in tmp[] and feasible. Test how good this choice really was.==========*/
-
+			trials[i] = tmp;
+			trials_cr[i] = cri;
+			trials_f[i] = fi;
+			// In batch mode the trials are evaluated, all together, once the whole generation has been created.
+			if (m_batch_evaluation && i + 1 < NP) {
+				continue;
+			}
 			
 			// b) Compare with the objective function
-			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] and records it fitness in newfitness */
-			if ( pop.problem().compare_fitness(newfitness,pop_old.get_individual(i).cur_f) ) {  /* improved objective function value ? */
-				// As a fitness improvement occured we 
-				pop.set_x(i,tmp);
-				// and thus can evaluate a new velocity
-				std::transform(tmp.begin(), tmp.end(), pop_old.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
-				// updates  v (cache avoids to recompute the objective function)
-				pop.set_v(i,tmp);
-				// pop_old.set_x(i,tmp); (un-comment for a steady-state version)
-				// remember the successful scale factors
-				m_crsuccess.push_back(cri);
-				m_fsuccess.push_back(fi);
+			const population::size_type first = m_batch_evaluation ? 0 : i;
+			if (m_batch_evaluation) {
+				prob.batch_objfun(trials_fit, trials);    /* Evaluate all the new vectors in trials[] */
+			} else {
+				prob.objfun(trials_fit[i], trials[i]);    /* Evaluate new vector in trials[i] and records it fitness in trials_fit[i] */
+			}
+			for (population::size_type j = first; j <= i; ++j) {
+				if ( pop.problem().compare_fitness(trials_fit[j],pop_old.get_individual(j).cur_f) ) {  /* improved objective function value ? */
+					// As a fitness improvement occured we 
+					pop.set_x(j,trials[j],trials_fit[j],constraint_vector());
+					// and thus can evaluate a new velocity
+					std::transform(trials[j].begin(), trials[j].end(), pop_old.get_individual(j).cur_x.begin(), tmp.begin(),std::minus<double>());
+					// updates  v
+					pop.set_v(j,tmp);
+					// pop_old.set_x(j,tmp); (un-comment for a steady-state version)
+					// remember the successful scale factors
+					m_crsuccess.push_back(trials_cr[j]);
+					m_fsuccess.push_back(trials_f[j]);
+				}
 			}
 		} // end of one generation (loop over individuals)
 		
@@ -260,9 +275,10 @@ void mde_pbx::evolve(population &pop) const
 		//Check the exit conditions (every 30 generations)
 		if (gen % 30 == 0) {
 			double dx = 0;
+			const population::individual_type &worst = pop.get_individual(pop.get_worst_idx()), &best = pop.get_individual(pop.get_best_idx());
 			
 			for (decision_vector::size_type k = 0; k < D; ++k) {
-				tmp[k] = pop.get_individual(pop.get_worst_idx()).best_x[k] - pop.get_individual(pop.get_best_idx()).best_x[k];
+				tmp[k] = worst.best_x[k] - best.best_x[k];
 				dx += std::fabs(tmp[k]);
 			}
 			
@@ -273,7 +289,7 @@ void mde_pbx::evolve(population &pop) const
 				return;
 			}
 
-			double mah = std::fabs(pop.get_individual(pop.get_worst_idx()).best_f[0] - pop.get_individual(pop.get_best_idx()).best_f[0]);
+			double mah = std::fabs(worst.best_f[0] - best.best_f[0]);
 			
 			if (mah < m_ftol) {
 				if (m_screen_output) {
@@ -297,6 +313,28 @@ void mde_pbx::evolve(population &pop) const
 	}
 }
 
+/// Sets batch evaluation.
+/**
+ * In batch mode, all the trial vectors of a generation are created first and then evaluated at once via
+ * problem::base::batch_objfun(), which evaluates them in parallel. As the trial vectors are built from the previous
+ * generation only, the evolution is the same as in serial mode.
+ *
+ * @param[in] b true to enable batch evaluation, false to evaluate the trial vectors one at a time.
+ */
+void mde_pbx::set_batch_evaluation(bool b)
+{
+	m_batch_evaluation = b;
+}
+
+/// Gets batch evaluation.
+/**
+ * @return true if batch evaluation is enabled, false otherwise.
+ */
+bool mde_pbx::get_batch_evaluation() const
+{
+	return m_batch_evaluation;
+}
+
 /// Algorithm name
 std::string mde_pbx::get_name() const
 {
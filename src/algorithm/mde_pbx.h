@@ -49,6 +49,8 @@ namespace pagmo { namespace algorithm {
  * is used to perturb the original random distributions, in order to generate better Cr and F
  * in the next generation.
  *
+ * All the trial vectors of a generation can be evaluated at once, in parallel (see set_batch_evaluation()).
+ * The results are the same as with serial evaluation.
  *
  * NOTE: No memory parameter is used, since the algorithm depends on the current generation (it is recommended to use a high
  * number of generations in order to exploit this adaptive feature. Running this algorithm 1000 times with just 10 Generations 
@@ -67,6 +69,8 @@ public:
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
+	void set_batch_evaluation(bool);
+	bool get_batch_evaluation() const;
 protected:
 	std::string human_readable_extra() const;
 	double powermean(std::vector<double>, double) const;
@@ -85,6 +89,7 @@ private:
 		ar & m_crm;
 		ar & m_fsuccess;
 		ar & m_crsuccess;
+		ar & m_batch_evaluation;
 	}
 	
 	// Number of generations.
@@ -110,6 +115,8 @@ private:
 	const double m_ftol;
 	const double m_xtol;
 
+	// Batch evaluation of the trial vectors
+	bool m_batch_evaluation;
 };
 
 }}
@@ -341,6 +341,7 @@ void moead::evolve(population &pop) const
 	for(pagmo::population::size_type i=0; i < shuffle.size(); ++i) shuffle[i] = i;
 	
 	fitness_vector new_f(prob.get_f_dimension()), f1(1), f2(1); 
+	constraint_vector new_c(prob.get_c_dimension());
 
 	// Main MOEA/D loop
 	for (int g = 0; g<m_gen; ++g) {
@@ -379,6 +380,7 @@ void moead::evolve(population &pop) const
 			// Note that we do not use prob, hence the cache of prob does not get these values.
 			// Note that the ideal point is here updated too
 			prob_decomposed.compute_original_fitness(new_f, candidate);
+			prob.compute_constraints(new_c, candidate);
 			
 			// 3 - We update the ideal point (Not needed as its done in decomposed when the flag adapt_weight is true)
 			//for (fitness_vector::size_type j=0; j<prob.get_f_dimension(); ++j){
@@ -393,7 +395,7 @@ void moead::evolve(population &pop) const
 			prob_decomposed.compute_decomposed_fitness(f2,new_f,weights[n]);
 			if(f2[0]<f1[0])
 			{
-				pop.set_x(n,candidate);
+				pop.set_x(n,candidate,new_f,new_c);
 				time++;
 			}
 			// Then on neighbouring problems up to m_limit (to preserve diversity)
@@ -411,7 +413,7 @@ void moead::evolve(population &pop) const
 				prob_decomposed.compute_decomposed_fitness(f2,new_f,weights[pick]);
 				if(f2[0]<f1[0])
 				{
-					pop.set_x(pick,candidate);
+					pop.set_x(pick,candidate,new_f,new_c);
 					time++;
 				}
 				// the maximal number of solutions updated is not allowed to exceed 'limit' if diversity is to be preserved
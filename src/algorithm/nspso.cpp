@@ -38,6 +38,7 @@
 #include "../problem/base.h"
 #include "../population.h"
 #include "../util/neighbourhood.h"
+#include "../util/non_dominated_sorting.h"
 #include "base.h"
 #include "nspso.h"
 
@@ -524,6 +525,11 @@ std::vector<std::vector<population::size_type> > nspso::compute_pareto_fronts(co
 																			  const std::vector<fitness_vector> &fit,
 																			  const std::vector<constraint_vector> &cons) const
 {
+	// Unconstrained problems using the standard dominance do not need the domination lists.
+	if (prob.standard_dominance() && prob.get_c_dimension() == 0) {
+		const std::vector<std::size_t> ranks = util::non_dominated_sorting::compute_ranks(fit);
+		return compute_pareto_fronts(std::vector<population::size_type>(ranks.begin(),ranks.end()));
+	}
 	std::vector<std::vector<population::size_type> > dom_list = compute_domination_list(prob,fit,cons);
 	std::vector<population::size_type> pareto_rank = compute_pareto_rank(dom_list);
 
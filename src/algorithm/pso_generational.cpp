@@ -24,6 +24,7 @@
 
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <algorithm>
 #include <vector>
 #include <cmath>
 #include <iostream>
@@ -129,18 +130,20 @@ void pso_generational::evolve(population &pop) const
 		return;
 	}
 
-	// Some vectors used during evolution are allocated here.
-	std::vector<double> dummy(Dc,0);				// used for initialisation purposes
+	// Non-null if the problem is stochastic.
+	const problem::base_stochastic *stochastic_prob = dynamic_cast<const problem::base_stochastic *>(&prob);
 
-	std::vector<decision_vector>  X(swarm_size,dummy);	// particles' current positions
-	std::vector<fitness_vector>   fit(swarm_size);		// particles' current fitness values
+	// The swarm is stored as a structure of arrays: the positions, velocities and previous best positions of all the
+	// particles are kept in contiguous blocks (one row of D components per particle), so that the updates below run on
+	// plain arrays and can be vectorised.
+	std::vector<double>          X(swarm_size * D);	// particles' current positions
+	std::vector<fitness_vector>  fit(swarm_size);		// particles' current fitness values
 
-	std::vector<decision_vector > V(swarm_size,dummy);	// particles' velocities
+	std::vector<double>          V(swarm_size * D);	// particles' velocities
 
-	std::vector<decision_vector> lbX(swarm_size,dummy);	// particles' previous best positions
+	std::vector<double>          lbX(swarm_size * D);	// particles' previous best positions
 	std::vector<fitness_vector>  lbfit(swarm_size);		// particles' fitness values at their previous best positions
 
-
 	std::vector< std::vector<int> > neighb(swarm_size);	// swarm topology (iterators over indexes of each particle's neighbors in the swarm)
 
 	decision_vector best_neighb(Dc);			// search space position of particles' best neighbor
@@ -150,8 +153,14 @@ void pso_generational::evolve(population &pop) const
 
 	decision_vector minv(Dc), maxv(Dc);			// Maximum and minumum velocity allowed
 
+	// Blocks of random numbers for the velocity update of a particle. They are generated before the update,
+	// in the same order in which the update consumes them.
+	std::vector<double> R1(Dc), R2(Dc), R;
+
+	std::vector<decision_vector> X_eval(swarm_size,decision_vector(D));	// positions of the particles, to be evaluated in batch
+	std::vector<decision_vector> lbX_eval;			// previous best positions of the particles, to be re-evaluated in batch (stochastic problems only)
+
 	double vwidth;						// Temporary variable
-	double new_x;						// Temporary variable
 
 	population::size_type    p;		// for iterating over particles
 	population::size_type    n;		// for iterating over particles's neighbours
@@ -167,15 +176,17 @@ void pso_generational::evolve(population &pop) const
 
 	// Copy the particle positions, their velocities and their fitness
 	for( p = 0; p < swarm_size; p++ ){
-		X[p]   = pop.get_individual(p).cur_x;
-		V[p]   = pop.get_individual(p).cur_v;
-		fit[p] = pop.get_individual(p).cur_f;
+		const population::individual_type &ind = pop.get_individual(p);
+		std::copy( ind.cur_x.begin(), ind.cur_x.end(), X.begin() + p * D );
+		std::copy( ind.cur_v.begin(), ind.cur_v.end(), V.begin() + p * D );
+		fit[p] = ind.cur_f;
 	}
 
 	// Initialise particles' previous best positions
 	for( p = 0; p < swarm_size; p++ ){
-		lbX[p]   = pop.get_individual(p).best_x;
-		lbfit[p] = pop.get_individual(p).best_f;
+		const population::individual_type &ind = pop.get_individual(p);
+		std::copy( ind.best_x.begin(), ind.best_x.end(), lbX.begin() + p * D );
+		lbfit[p] = ind.best_f;
 	}
 
 	// Initialize the Swarm's topology
@@ -205,20 +216,26 @@ void pso_generational::evolve(population &pop) const
 		// Update Velocity
 		for( p = 0; p < swarm_size; p++ ){
 
+			double *x = &X[p * D], *v = &V[p * D];
+			const double *lbx = &lbX[p * D];
+
 			// identify the current particle's best neighbour
 			// . not needed if m_neighb_type == 1 (gbest): best_neighb directly tracked in this function
 			// . not needed if m_variant == 6 (FIPS): all neighbours are considered, no need to identify the best one
+			const double *bnx = &best_neighb[0];
 			if( m_neighb_type != 1 && m_variant != 6)
-				best_neighb = particle__get_best_neighbor( p, neighb, lbX, lbfit, prob );
+				bnx = &lbX[particle__get_best_neighbor( p, neighb, lbfit, prob ) * D];
 
 
 			/*-------PSO canonical (with inertia weight) ---------------------------------------------*/
 			/*-------Original algorithm used in PaGMO paper-------------------------------------------*/
 			if( m_variant == 1 ){
 				for( d = 0; d < Dc; d++ ){
-					r1 = m_drng();
-					r2 = m_drng();
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]);
+					R1[d] = m_drng();
+					R2[d] = m_drng();
+				}
+				for( d = 0; d < Dc; d++ ){
+					v[d] = m_omega * v[d] + m_eta1 * R1[d] * (lbx[d] - x[d]) + m_eta2 * R2[d] * (bnx[d] - x[d]);
 				}
 			}
 
@@ -227,8 +244,10 @@ void pso_generational::evolve(population &pop) const
 			/*-------Check with Rastrigin-------------------------------------------------------------*/
 			else if( m_variant == 2 ){
 				for( d = 0; d < Dc; d++ ){
-					r1 = m_drng();
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r1 * (best_neighb[d] - X[p][d]);
+					R1[d] = m_drng();
+				}
+				for( d = 0; d < Dc; d++ ){
+					v[d] = m_omega * v[d] + m_eta1 * R1[d] * (lbx[d] - x[d]) + m_eta2 * R1[d] * (bnx[d] - x[d]);
 				}
 			}
 
@@ -238,7 +257,7 @@ void pso_generational::evolve(population &pop) const
 				r1 = m_drng();
 				r2 = m_drng();
 				for( d = 0; d < Dc; d++ ){
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]);
+					v[d] = m_omega * v[d] + m_eta1 * r1 * (lbx[d] - x[d]) + m_eta2 * r2 * (bnx[d] - x[d]);
 				}
 			}
 
@@ -248,7 +267,7 @@ void pso_generational::evolve(population &pop) const
 			else if( m_variant == 4 ){
 				r1 = m_drng();
 				for( d = 0; d < Dc; d++ ){
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r1 * (best_neighb[d] - X[p][d]);
+					v[d] = m_omega * v[d] + m_eta1 * r1 * (lbx[d] - x[d]) + m_eta2 * r1 * (bnx[d] - x[d]);
 				}
 			}
 
@@ -267,9 +286,11 @@ void pso_generational::evolve(population &pop) const
 			 *-------------------------------------------------------------------------------------*/
 			else if( m_variant == 5 ){
 				for( d = 0; d < Dc; d++ ){
-					r1 = m_drng();
-					r2 = m_drng();
-					V[p][d] = m_omega * ( V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]) );
+					R1[d] = m_drng();
+					R2[d] = m_drng();
+				}
+				for( d = 0; d < Dc; d++ ){
+					v[d] = m_omega * ( v[d] + m_eta1 * R1[d] * (lbx[d] - x[d]) + m_eta2 * R2[d] * (bnx[d] - x[d]) );
 				}
 			}
 
@@ -284,89 +305,64 @@ void pso_generational::evolve(population &pop) const
 			 *  [Mendes et al., 2004] http://dx.doi.org/10.1109/TEVC.2004.826074
 			 *-------------------------------------------------------------------------------------*/
 			else if( m_variant == 6 ){
+				const std::vector<int>::size_type n_neighb = neighb[p].size();
+				R.resize( Dc * n_neighb );
+				for( d = 0; d < R.size(); d++ ){
+					R[d] = m_drng();
+				}
 				for( d = 0; d < Dc; d++ ){
 					sum_forces = 0.0;
-					for( n = 0; n < neighb[p].size(); n++ )
-						sum_forces += m_drng() * acceleration_coefficient * ( lbX[ neighb[p][n] ][d] - X[p][d] );
+					for( n = 0; n < n_neighb; n++ )
+						sum_forces += R[d * n_neighb + n] * acceleration_coefficient * ( lbX[ neighb[p][n] * D + d ] - x[d] );
 
-					V[p][d] = m_omega * ( V[p][d] + sum_forces / neighb[p].size() );
+					v[d] = m_omega * ( v[d] + sum_forces / n_neighb );
 				}
 			}
 		}
 
 		// Update Position
 		for( p = 0; p < swarm_size; p++ ){
+			double *x = &X[p * D], *v = &V[p * D];
 			// We now check that the velocity does not exceed the maximum allowed per component
 			// and we perform the position update and the feasibility correction
+			// (velocity updated to that which would have taken the previous position
+			// to the newly corrected feasible position)
 			for( d = 0; d < Dc; d++ ){
-
-				if( V[p][d] > maxv[d] )
-					V[p][d] = maxv[d];
-
-				else if( V[p][d] < minv[d] )
-					V[p][d] = minv[d];
-
-				// update position
-				new_x = X[p][d] + V[p][d];
-
-				// feasibility correction
-				// (velocity updated to that which would have taken the previous position
-				// to the newly corrected feasible position)
-				if( new_x < lb[d] ){
-					new_x = lb[d];
-					V[p][d] = 0.0;
-//					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
-//					V[p][d] = new_x - X[p][d];
-//					V[p][d] = 0;
-				}
-				else if( new_x > ub[d] ){
-					new_x = ub[d];
-					V[p][d] = 0.0;
-//					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
-//					V[p][d] = new_x - X[p][d];
-//					V[p][d] = 0;
-				}
-				X[p][d] = new_x;
+				v[d] = std::min( std::max( v[d], minv[d] ), maxv[d] );
+				const double new_x = x[d] + v[d];
+				v[d] = ( new_x < lb[d] || new_x > ub[d] ) ? 0.0 : v[d];
+				x[d] = std::min( std::max( new_x, lb[d] ), ub[d] );
 			}
+			std::copy( x, x + D, X_eval[p].begin() );
 		}
 
 		// If the problem is a stochastic optimization chage the seed and re-evaluate taking care to update also best and local bests
-		try
-		{
-			dynamic_cast<const pagmo::problem::base_stochastic &>(prob).set_seed(m_urng());
-			pop.clear(); // Removes memory based on different seeds (champion and best_x, best_f, best_c)
+		// NOTE: the whole swarm is evaluated in batch (hence in parallel), while the population is written only once at the end.
+		if( stochastic_prob ){
+			stochastic_prob->set_seed(m_urng());
 
 			// Re-evaluate wrt new seed the particle position and memory
+			lbX_eval.resize( swarm_size );
 			for( p = 0; p < swarm_size; p++ ){
-				// We evaluate here the new individual fitness
-				prob.objfun( fit[p], X[p] );
-				// We re-evaluate the fitness of the particle memory
-				prob.objfun( lbfit[p], lbX[p] );
-				///We now set the cleared pop. cur_x is the best_x, re-evaluated with new seed.
-				pop.push_back(lbX[p]);
-				pop.set_x(p,X[p]);
-				pop.set_v(p,V[p]);
+				lbX_eval[p].assign( lbX.begin() + p * D, lbX.begin() + (p + 1) * D );
 			}
+			prob.batch_objfun( fit, X_eval );
+			prob.batch_objfun( lbfit, lbX_eval );
+
 			//UPDATE BEST_FIT and BEST to account for the new seed
 			best_fit = fit[0];
-			best_neighb = X[0];
+			best_neighb = X_eval[0];
 			for( p = 1; p < swarm_size; p++ ){
 				if( prob.compare_fitness( fit[p], best_fit ) ){
 					best_fit = fit[p];
-					best_neighb = X[p];
+					best_neighb = X_eval[p];
 				}
 			}
-
 		}
-		catch (const std::bad_cast& e)
+		else
 		{
 			//Only evaluate new position
-			for( p = 0; p < swarm_size; p++ ){
-				// We evaluate here the new individual fitness
-				prob.objfun( fit[p], X[p] );
-				pop.set_x(p,X[p]);
-				pop.set_v(p,V[p]);
-			}
+			prob.batch_objfun( fit, X_eval );
 		}
 
 
@@ -377,12 +373,12 @@ void pso_generational::evolve(population &pop) const
 			if( prob.compare_fitness( fit[p], lbfit[p] ) ){
 				// update the particle's previous best position
 				lbfit[p] = fit[p];
-				lbX[p] = X[p];
+				std::copy( X_eval[p].begin(), X_eval[p].end(), lbX.begin() + p * D );
 
 				// update the best position observed so far by any particle in the swarm
 				// (only performed if swarm topology is gbest or random varying)
 				if( ( m_neighb_type == 1 || m_neighb_type == 4 ) && prob.compare_fitness( fit[p], best_fit ) ){
-					best_neighb = X[p];
+					best_neighb = X_eval[p];
 					best_fit    = fit[p];
 					best_fit_improved = true;
 				}
@@ -395,6 +391,25 @@ void pso_generational::evolve(population &pop) const
 			initialize_topology__adaptive_random( neighb );
 		}
 	} // end of main PSO loop
+
+	// copy particles' positions, velocities and previous bests back to the main population, with a single
+	// write per particle and without re-evaluations
+	if( stochastic_prob ){
+		// Removes memory based on different seeds (champion and best_x, best_f, best_c)
+		pop.clear();
+		for( p = 0; p < swarm_size; p++ ){
+			pop.push_back( decision_vector( lbX.begin() + p * D, lbX.begin() + (p + 1) * D ), lbfit[p], constraint_vector() );
+		}
+	}
+	population::individual_type ind;
+	for( p = 0; p < swarm_size; p++ ){
+		ind.cur_x.assign( X.begin() + p * D, X.begin() + (p + 1) * D );
+		ind.cur_v.assign( V.begin() + p * D, V.begin() + (p + 1) * D );
+		ind.cur_f = fit[p];
+		ind.best_x.assign( lbX.begin() + p * D, lbX.begin() + (p + 1) * D );
+		ind.best_f = lbfit[p];
+		pop.set_individual( p, ind );
+	}
 }
 
 
@@ -403,12 +418,11 @@ void pso_generational::evolve(population &pop) const
  *  2
  *  @param[in] pidx index to the particle under consideration
  *  @param[in] neighb definition of the swarm's topology
- *  @param[in] lbX particles' previous best positions
  *  @param[in] lbfit particles' fitness values at their previous best positions
  *  @param[in] prob problem undergoing optimization
- *  @return best position already visited by any of the considered particle's neighbours
+ *  @return index of the neighbour whose previous best position is the best one already visited by any of the considered particle's neighbours
  */
-decision_vector pso_generational::particle__get_best_neighbor( population::size_type pidx, std::vector< std::vector<int> > &neighb, const std::vector<decision_vector> &lbX, const std::vector<fitness_vector> &lbfit, const problem::base &prob ) const
+population::size_type pso_generational::particle__get_best_neighbor( population::size_type pidx, std::vector< std::vector<int> > &neighb, const std::vector<fitness_vector> &lbfit, const problem::base &prob ) const
 {
 	population::size_type  nidx, bnidx;		// neighbour index; best neighbour index
 
@@ -426,7 +440,7 @@ decision_vector pso_generational::particle__get_best_neighbor( population::size_
 			for( nidx = 1; nidx < neighb[pidx].size(); nidx++ )
 				if( prob.compare_fitness( lbfit[ neighb[pidx][nidx] ], lbfit[ bnidx ] ) )
 					bnidx = neighb[pidx][nidx];
-			return lbX[bnidx];
+			return bnidx;
 	}
 }
 
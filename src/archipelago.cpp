@@ -22,16 +22,28 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_int.hpp>
-#include <boost/thread/barrier.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/tuple/tuple_io.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
 #include <cstddef>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <iterator>
+#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -50,6 +62,8 @@
 
 namespace pagmo {
 
+const archipelago::size_type archipelago::default_migr_hist_capacity;
+
 // Check we are not using bogus values for the enums.
 void archipelago::check_migr_attributes() const
 {
@@ -65,9 +79,10 @@ void archipelago::check_migr_attributes() const
  * @param[in] dt distribution type.
  * @param[in] md migration direction.
  */
-archipelago::archipelago(distribution_type dt, migration_direction md):m_islands_sync_point(),m_topology(new topology::unconnected()),
+archipelago::archipelago(distribution_type dt, migration_direction md):m_topology(new topology::unconnected()),
 	m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_mailboxes(),m_urng(rng_generator::get<rng_uint32>()),m_migr_hist_mutex(),
+	m_migr_hist(default_migr_hist_capacity)
 {
 	check_migr_attributes();
 }
@@ -82,8 +97,9 @@ archipelago::archipelago(distribution_type dt, migration_direction md):m_islands
  * @param[in] md migration direction.
  */
 archipelago::archipelago(const topology::base &t, distribution_type dt, migration_direction md):
-	m_islands_sync_point(),m_topology(),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_topology(),m_dist_type(dt),m_migr_dir(md),
+	m_mailboxes(),m_urng(rng_generator::get<rng_uint32>()),m_migr_hist_mutex(),
+	m_migr_hist(default_migr_hist_capacity)
 {
 	// NOTE: we cannot set the topology in the initialiser list directly,
 	// since we do not know if the topology is suitable. Set it here.
@@ -105,8 +121,9 @@ archipelago::archipelago(const topology::base &t, distribution_type dt, migratio
  * @param[in] md migration direction.
  */
 archipelago::archipelago(const algorithm::base &a, const problem::base &p, int n, int m, const topology::base &t, distribution_type dt, migration_direction md):
-	m_islands_sync_point(),m_topology(new topology::unconnected()),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_topology(new topology::unconnected()),m_dist_type(dt),m_migr_dir(md),
+	m_mailboxes(),m_urng(rng_generator::get<rng_uint32>()),m_migr_hist_mutex(),
+	m_migr_hist(default_migr_hist_capacity)
 {
 	check_migr_attributes();
 	for (size_type i = 0; i < boost::numeric_cast<size_type>(n); ++i) {
@@ -134,8 +151,12 @@ archipelago::archipelago(const archipelago &a)
 	m_topology = a.m_topology->clone();
 	m_dist_type = a.m_dist_type;
 	m_migr_dir = a.m_migr_dir;
-	m_migr_map = a.m_migr_map;
-	m_drng = a.m_drng;
+	// Deep copy of the mailboxes, as they carry their own mutexes.
+	for (size_type i = 0; i < a.m_mailboxes.size(); ++i) {
+		m_mailboxes.push_back(mailbox_ptr(new migration_mailbox(*a.m_mailboxes[i])));
+	}
+	m_problem_groups = a.m_problem_groups;
+	m_group_reps = a.m_group_reps;
 	m_urng = a.m_urng;
 	m_migr_hist = a.m_migr_hist;
 }
@@ -162,10 +183,15 @@ archipelago &archipelago::operator=(const archipelago &a)
 		m_topology = a.m_topology->clone();
 		m_dist_type = a.m_dist_type;
 		m_migr_dir = a.m_migr_dir;
-		m_migr_map = a.m_migr_map;
-		m_drng = a.m_drng;
+		m_mailboxes.clear();
+		for (size_type i = 0; i < a.m_mailboxes.size(); ++i) {
+			m_mailboxes.push_back(mailbox_ptr(new migration_mailbox(*a.m_mailboxes[i])));
+		}
+		m_problem_groups = a.m_problem_groups;
+		m_group_reps = a.m_group_reps;
 		m_urng = a.m_urng;
 		m_migr_hist = a.m_migr_hist;
+		m_checkpoint.m_dirty = true;
 	}
 	return *this;
 }
@@ -182,7 +208,8 @@ archipelago::~archipelago()
 
 /// Wait until evolution on each island has terminated.
 /**
- * Will call iteratively island::join() on all islands of the archipelago.
+ * Will call iteratively island::join() on all islands of the archipelago, and then wait for the island files of the checkpoint
+ * to be written (see set_checkpoint()).
  */
 void archipelago::join() const
 {
@@ -190,6 +217,7 @@ void archipelago::join() const
 	for (const_iterator it = m_container.begin(); it != it_f; ++it) {
 		(*it)->join();
 	}
+	flush_checkpoint();
 }
 
 archipelago::size_type archipelago::locate_island(const base_island &isl) const
@@ -222,11 +250,62 @@ void archipelago::push_back(const base_island &isl)
 	if (!check_island(isl)) {
 		pagmo_throw(value_error,"cannot push_back() incompatible island");
 	}
-	m_container.push_back(isl.clone());
+	m_mailboxes.push_back(new_mailbox(isl));
+	try {
+		m_container.push_back(isl.clone());
+	} catch (...) {
+		m_mailboxes.pop_back();
+		throw;
+	}
 	// Tell the island that it is living in an archipelago now.
 	m_container.back()->m_archi = this;
+	m_problem_groups.push_back(0);
+	assign_problem_group(m_container.size() - 1);
 	// Insert the island in the topology.
 	m_topology->push_back();
+	m_checkpoint.m_dirty = true;
+}
+
+// Two problems are considered the same if they are equal according to problem::base::operator==() and if equality implies that
+// they produce the same fitness and constraints (see problem::base::exact_equality()). No evaluation is needed.
+static bool same_problem(const problem::base &p1, const problem::base &p2)
+{
+	return p1.exact_equality() && p2.exact_equality() && p1 == p2 && p1.get_f_dimension() == p2.get_f_dimension();
+}
+
+// Assign island idx to the group of the first representative holding the same problem, or make it the representative of a new group.
+void archipelago::assign_problem_group(const size_type &idx)
+{
+	pagmo_assert(idx < m_container.size() && idx < m_problem_groups.size());
+	const problem::base &prob = m_container[idx]->m_pop.problem();
+	for (size_type g = 0; g < m_group_reps.size(); ++g) {
+		if (same_problem(m_container[m_group_reps[g]]->m_pop.problem(),prob)) {
+			m_problem_groups[idx] = g;
+			return;
+		}
+	}
+	m_problem_groups[idx] = m_group_reps.size();
+	m_group_reps.push_back(idx);
+}
+
+// Recompute from scratch the problem groups of all islands.
+void archipelago::build_problem_groups()
+{
+	m_problem_groups.assign(m_container.size(),0);
+	m_group_reps.clear();
+	for (size_type i = 0; i < m_container.size(); ++i) {
+		assign_problem_group(i);
+	}
+}
+
+// Create the migration mailbox for island isl, seeding its rngs from the archipelago's rng.
+archipelago::mailbox_ptr archipelago::new_mailbox(const base_island &isl)
+{
+	mailbox_ptr retval(new migration_mailbox());
+	retval->m_capacity = isl.get_size();
+	retval->m_drng.seed(m_urng());
+	retval->m_urng.seed(m_urng());
+	return retval;
 }
 
 /// Set island algorithm.
@@ -245,6 +324,7 @@ void archipelago::set_algorithm(const size_type &idx, const algorithm::base &a)
 		pagmo_throw(index_error,"invalid island index");
 	}
 	m_container[idx]->set_algorithm(a);
+	m_checkpoint.m_dirty = true;
 }
 
 /// Get the size of the archipelago.
@@ -313,6 +393,7 @@ void archipelago::set_topology(const topology::base &tp)
 	}
 	// The topology is ok, assign it.
 	m_topology = t;
+	m_checkpoint.m_dirty = true;
 }
 
 /// Return a copy of the distribution type.
@@ -333,6 +414,7 @@ archipelago::distribution_type archipelago::get_distribution_type() const {
 
 void archipelago::set_distribution_type(const archipelago::distribution_type &dt) {
 	m_dist_type = dt;
+	m_checkpoint.m_dirty = true;
 }
 
 /// Check whether an island is compatible with the archipelago.
@@ -360,15 +442,6 @@ bool archipelago::check_island(const base_island &isl) const
 	return true;
 }
 
-// Reset island synchronisation barrier. This method is intended as a shortcut,
-// do NOT use it if the archipelago has not been joined!
-void archipelago::reset_barrier(const size_type &size)
-{
-	if (size) {
-		m_islands_sync_point.reset(new boost::barrier(boost::numeric_cast<unsigned int>(size)));
-	}
-}
-
 // Return true if all islands in the archipelago have a m_archi pointer to this and the shared pointer count is 1, false otherwise. Used for debugging.
 bool archipelago::destruction_checks() const
 {
@@ -380,9 +453,9 @@ bool archipelago::destruction_checks() const
 	return true;
 }
 
-// Helper function to insert a list of candidates immigrants into an immigrants vector, given the source and destination island.
-void archipelago::build_immigrants_vector(std::vector<std::pair<population::size_type, individual_type > > &immigrants, const base_island &src_isl,
-	base_island &dest_isl, const std::vector<individual_type> &candidates) const
+// Helper function to insert a list of candidates immigrants into an immigrants vector, given the index of the source island and the destination island.
+void archipelago::build_immigrants_vector(std::vector<std::pair<population::size_type, individual_type > > &immigrants, const size_type &src_idx,
+	const base_island &dest_isl, const std::vector<individual_type> &candidates) const
 {
 	for (std::vector<individual_type>::const_iterator ind_it = candidates.begin();
 		ind_it != candidates.end(); ++ind_it)
@@ -392,12 +465,65 @@ void archipelago::build_immigrants_vector(std::vector<std::pair<population::size
 		if (!dest_isl.m_pop.problem().verify_x(ind_it->cur_x)) {
 			continue;
 		}
-		immigrants.push_back(std::make_pair(locate_island(src_isl),*ind_it));
+		immigrants.push_back(std::make_pair(src_idx,*ind_it));
+	}
+}
+
+// Move the content of an individual into another one, leaving the source in an unspecified state.
+static void move_individual(population::individual_type &dest, population::individual_type &src)
+{
+	dest.cur_x.swap(src.cur_x);
+	dest.cur_v.swap(src.cur_v);
+	dest.cur_c.swap(src.cur_c);
+	dest.cur_f.swap(src.cur_f);
+	dest.best_x.swap(src.best_x);
+	dest.best_c.swap(src.best_c);
+	dest.best_f.swap(src.best_f);
+}
+
+// Same as build_immigrants_vector(), but the candidates are moved into the immigrants vector instead of being copied.
+void archipelago::move_immigrants_vector(std::vector<std::pair<population::size_type, individual_type > > &immigrants, const size_type &src_idx,
+	const base_island &dest_isl, std::vector<individual_type> &candidates) const
+{
+	for (std::vector<individual_type>::iterator ind_it = candidates.begin();
+		ind_it != candidates.end(); ++ind_it)
+	{
+		if (!dest_isl.m_pop.problem().verify_x(ind_it->cur_x)) {
+			continue;
+		}
+		immigrants.push_back(std::make_pair(src_idx,individual_type()));
+		move_individual(immigrants.back().second,*ind_it);
+	}
+}
+
+// Append emigrants coming from island src_idx to the inbox of a mailbox. If move is true, the emigrants are moved instead of copied.
+// The individuals pending from src_idx are capped to the capacity of the mailbox, discarding the oldest ones.
+void archipelago::deliver_emigrants(migration_mailbox &mailbox, const size_type &src_idx, std::vector<individual_type> &emigrants, bool move)
+{
+	lock_type lock(mailbox.m_mutex);
+	std::vector<individual_type> &pending = mailbox.m_inbox[src_idx];
+	if (move && pending.empty()) {
+		pending.swap(emigrants);
+	} else {
+		const std::vector<individual_type>::size_type old_size = pending.size();
+		pending.resize(old_size + emigrants.size());
+		for (std::vector<individual_type>::size_type i = 0; i < emigrants.size(); ++i) {
+			if (move) {
+				move_individual(pending[old_size + i],emigrants[i]);
+			} else {
+				pending[old_size + i] = emigrants[i];
+			}
+		}
+	}
+	if (pending.size() > mailbox.m_capacity) {
+		pending.erase(pending.begin(),pending.end() - mailbox.m_capacity);
 	}
 }
 
-// Re-evaluate vector of immigrants before insertion into destination island.
-void archipelago::reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &immigrants, const base_island &isl) const
+// Re-evaluate vector of immigrants before insertion into destination island. Immigrants coming from islands with the same problem
+// as the destination island (isl_idx) keep their fitness and constraints.
+void archipelago::reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &immigrants, const base_island &isl,
+	const size_type &isl_idx) const
 {
 	individual_type tmp;
 	tmp.cur_v.resize(isl.m_pop.problem().get_dimension());
@@ -405,8 +531,14 @@ void archipelago::reevaluate_immigrants(std::vector<std::pair<population::size_t
 	tmp.cur_c.resize(isl.m_pop.problem().get_c_dimension());
 	for (std::vector<std::pair<population::size_type, individual_type> >::iterator ind_it = immigrants.begin(); ind_it != immigrants.end(); ++ind_it) {
 		tmp.cur_x = (*ind_it).second.cur_x;
-		isl.m_pop.problem().objfun(tmp.cur_f,tmp.cur_x);
-		isl.m_pop.problem().compute_constraints(tmp.cur_c,tmp.cur_x);
+		pagmo_assert((*ind_it).first < m_problem_groups.size());
+		if (m_problem_groups[(*ind_it).first] == m_problem_groups[isl_idx]) {
+			tmp.cur_f = (*ind_it).second.cur_f;
+			tmp.cur_c = (*ind_it).second.cur_c;
+		} else {
+			isl.m_pop.problem().objfun(tmp.cur_f,tmp.cur_x);
+			isl.m_pop.problem().compute_constraints(tmp.cur_c,tmp.cur_x);
+		}
 		// Set the best properties to the current ones. (TODO: maybe here one could
 		// reevaluate the old best in the new environment and keep it if still better than the
 		// reevaluated current ...... discuss!! (Anche no, grazie!!)
@@ -425,8 +557,12 @@ void archipelago::reevaluate_immigrants(std::vector<std::pair<population::size_t
  * @param[in] seed Seed for generating pseudo-random sequences
  */
 void archipelago::set_seeds(unsigned int seed) {
-	m_drng.seed(seed);
-	m_urng.seed(seed+1); // we do not care if it overflows
+	m_urng.seed(seed);
+	for (size_type i = 0; i < m_mailboxes.size(); ++i) {
+		m_mailboxes[i]->m_drng.seed(m_urng());
+		m_mailboxes[i]->m_urng.seed(m_urng());
+	}
+	m_checkpoint.m_dirty = true;
 }
 
 
@@ -443,28 +579,29 @@ void archipelago::pre_evolution(base_island &isl)
 	// Determine the island's index in the archipelago.
 	const size_type isl_idx = locate_island(isl);
 	pagmo_assert(isl_idx < m_container.size());
+	migration_mailbox &mailbox = *m_mailboxes[isl_idx];
 	//1. Obtain immigrants.
 	std::vector<std::pair<population::size_type, individual_type> > immigrants;
 	switch (m_migr_dir) {
 		case source:
 		{
-			lock_type lock(m_migr_mutex);
-			// For source migration direction, migration map contains islands' "inboxes". Or, in other words, it contains
+			// For source migration direction, mailboxes are islands' "inboxes". Or, in other words, they contain
 			// the individuals that are destined to go into the island. Such inboxes have been assembled previously,
-			// during a post_evolution operation.
-			// Iterate over all the vectors of individuals provided by the different islands.
-			for (boost::unordered_map<size_type,std::vector<individual_type> >::iterator it = m_migr_map[isl_idx].begin();
-				it != m_migr_map[isl_idx].end(); ++it)
+			// during a post_evolution operation. Empty the inbox while holding its lock, and process its content afterwards.
+			migration_mailbox::inbox_type inbox;
 			{
+				lock_type lock(mailbox.m_mutex);
+				inbox.swap(mailbox.m_inbox);
+			}
+			// Iterate over all the vectors of individuals provided by the different islands.
+			for (migration_mailbox::inbox_type::iterator it = inbox.begin(); it != inbox.end(); ++it) {
 				pagmo_assert(it->first < m_container.size());
-				build_immigrants_vector(immigrants,*m_container[it->first],isl,it->second);
+				move_immigrants_vector(immigrants,it->first,isl,it->second);
 			}
-			// Delete stuff in the migration map.
-			m_migr_map.erase(isl_idx);
 			break;
 		}
 		case destination:
-			// For destination migration direction, items in the migration map behave like "outboxes", i.e. each one is a
+			// For destination migration direction, mailboxes behave like "outboxes", i.e. each one is a
 			// "database of best individuals" seen in the islands of the archipelago.
 			// Get neighbours connecting into isl.
 			const std::vector<topology::base::vertices_size_type> inv_adj_islands(m_topology->get_v_inv_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
@@ -473,32 +610,40 @@ void archipelago::pre_evolution(base_island &isl)
 				switch (m_dist_type) {
 					case point_to_point:
 					{
-						lock_type lock(m_migr_mutex);
 						// Get the index of a random island connecting into isl.
 						boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,inv_adj_islands.size() - 1);
-						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[u_int(m_urng)]);
-						// Get the immigrants from the outbox of the random island. Note the redundant information in the last
-						// argument of the function.
-						pagmo_assert(m_migr_map[rn_isl_idx].size() <= 1);
-
-						double next_rng = m_drng();
+						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[u_int(mailbox.m_urng)]);
+						double next_rng = mailbox.m_drng();
 						double migr_prob = m_topology->get_weight(rn_isl_idx, isl_idx);
 						if (next_rng < migr_prob) {
-							build_immigrants_vector(immigrants,*m_container[rn_isl_idx],isl,m_migr_map[rn_isl_idx][rn_isl_idx]);
+							// Get the immigrants from the outbox of the random island.
+							migration_mailbox::outbox_type outbox;
+							{
+								lock_type lock(m_mailboxes[rn_isl_idx]->m_mutex);
+								outbox = m_mailboxes[rn_isl_idx]->m_outbox;
+							}
+							if (outbox) {
+								build_immigrants_vector(immigrants,rn_isl_idx,isl,*outbox);
+							}
 						}
 						break;
 					}
 					case broadcast:
 					{
-						lock_type lock(m_migr_mutex);
 						// For broadcast migration fetch immigrants from all neighbour islands' databases.
 						for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < inv_adj_islands.size(); ++i) {
 							const size_type src_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[i]);
-							pagmo_assert(m_migr_map[src_isl_idx].size() <= 1);
-							double next_rng = m_drng();
+							double next_rng = mailbox.m_drng();
 							double migr_prob = m_topology->get_weight(src_isl_idx, isl_idx);
 							if (next_rng < migr_prob) {
-								build_immigrants_vector(immigrants,*m_container[src_isl_idx],isl,m_migr_map[src_isl_idx][src_isl_idx]);
+								migration_mailbox::outbox_type outbox;
+								{
+									lock_type lock(m_mailboxes[src_isl_idx]->m_mutex);
+									outbox = m_mailboxes[src_isl_idx]->m_outbox;
+								}
+								if (outbox) {
+									build_immigrants_vector(immigrants,src_isl_idx,isl,*outbox);
+								}
 							}
 						}
 					}
@@ -510,18 +655,21 @@ void archipelago::pre_evolution(base_island &isl)
 		// We re-evaluate the incoming individuals according
 		// to destination island's problem. This will make sure that stochastic problems
 		// are correctly dealt with
-		reevaluate_immigrants(immigrants,isl);
+		reevaluate_immigrants(immigrants,isl,isl_idx);
 		// We then insert the incoming individuals into the population, storing how many from where
 		std::vector<std::pair<population::size_type, size_type> > rec_history;
 		rec_history = isl.accept_immigrants(immigrants);
-		lock_type lock(m_migr_mutex);
-		// Record the migration history.
+		lock_type lock(m_migr_hist_mutex);
+		// Record the migration history. When the history is full, the oldest records are overwritten.
 		for (size_t i =0; i< rec_history.size(); ++i) {
 			m_migr_hist.push_back( boost::make_tuple(
 				rec_history[i].first,
 				rec_history[i].second,
 				isl_idx)
 			);
+			if (m_migr_hist_sink) {
+				m_migr_hist_sink(rec_history[i].first,rec_history[i].second,isl_idx);
+			}
 		}
 	}
 }
@@ -538,6 +686,7 @@ void archipelago::post_evolution(base_island &isl)
 	// Determine the island's index in the archipelago.
 	const size_type isl_idx = locate_island(isl);
 	pagmo_assert(isl_idx < m_container.size());
+	migration_mailbox &mailbox = *m_mailboxes[isl_idx];
 	// Create the vector of emigrants.
 	std::vector<individual_type> emigrants;
 	switch (m_migr_dir) {
@@ -553,30 +702,31 @@ void archipelago::post_evolution(base_island &isl)
 					{
 						case point_to_point:
 						{
-							lock_type lock(m_migr_mutex);
-							// For one-to-one migration choose a random neighbour island and put immigrants to its inbox.
+							// For one-to-one migration choose a random neighbour island and move the emigrants to its inbox.
 							boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,adj_islands.size() - 1);
-							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands[u_int(m_urng)]);
-							double next_rng = m_drng();
+							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands[u_int(mailbox.m_urng)]);
+							double next_rng = mailbox.m_drng();
 							double migr_prob = m_topology->get_weight(isl_idx, chosen_adj);
 							if (next_rng < migr_prob) {
-								m_migr_map[chosen_adj][isl_idx].insert(m_migr_map[chosen_adj][isl_idx].end(),emigrants.begin(),emigrants.end());
+								deliver_emigrants(*m_mailboxes[chosen_adj],isl_idx,emigrants,true);
 							}
 							break;
 						}
 						case broadcast:
 						{
-							lock_type lock(m_migr_mutex);
-							// For broadcast migration put immigrants to all neighbour islands' inboxes.
+							// For broadcast migration put the emigrants into all neighbour islands' inboxes. Select the recipients first,
+							// so that the emigrants can be moved into the last one.
+							std::vector<size_type> recipients;
 							for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < adj_islands.size(); ++i) {
-								double next_rng = m_drng();
+								double next_rng = mailbox.m_drng();
 								double migr_prob = m_topology->get_weight(isl_idx, adj_islands[i]);
 								if (next_rng < migr_prob) {
-									m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx]
-										.insert(m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx].end(),
-										emigrants.begin(),emigrants.end());
+									recipients.push_back(boost::numeric_cast<size_type>(adj_islands[i]));
 								}
 							}
+							for (std::vector<size_type>::size_type i = 0; i < recipients.size(); ++i) {
+								deliver_emigrants(*m_mailboxes[recipients[i]],isl_idx,emigrants,i + 1 == recipients.size());
+							}
 						}
 					}
 				}
@@ -585,11 +735,14 @@ void archipelago::post_evolution(base_island &isl)
 		}
 		case destination:
 		{
-			// For destination migration direction, migration map behaves like "outboxes", i.e. each is a "database of best individuals" for corresponding island.
+			// For destination migration direction, mailboxes behave like "outboxes", i.e. each is a "database of best individuals" for corresponding island.
+			// The outbox is replaced by a new one, and the old one is released outside the lock (the neighbours might still be reading it).
 			emigrants = isl.get_emigrants();
-			lock_type lock(m_migr_mutex);
-			pagmo_assert(m_migr_map[isl_idx].size() <= 1);
-			m_migr_map[isl_idx][isl_idx].swap(emigrants);
+			boost::shared_ptr<std::vector<individual_type> > new_outbox(new std::vector<individual_type>());
+			new_outbox->swap(emigrants);
+			migration_mailbox::outbox_type old_outbox(new_outbox);
+			lock_type lock(mailbox.m_mutex);
+			mailbox.m_outbox.swap(old_outbox);
 		}
 	}
 }
@@ -597,15 +750,16 @@ void archipelago::post_evolution(base_island &isl)
 /// Run the evolution for the given number of iterations.
 /**
  * Will iteratively call island::evolve(n) on each island of the archipelago and then return.
+ * The iterations of all the islands are interleaved on the process-wide thread pool (see base_island::evolve()),
+ * hence the number of islands is not limited by the number of threads.
  *
  * \param[in] n number of time each island will be evolved.
  */
 void archipelago::evolve(int n)
 {
 	join();
+	update_checkpoint();
 	const iterator it_f = m_container.end();
-	// Reset thread barrier.
-	reset_barrier(m_container.size());
 	for (iterator it = m_container.begin(); it != it_f; ++it) {
 		(*it)->evolve(n);
 	}
@@ -617,6 +771,8 @@ void archipelago::evolve(int n)
  * Each batch will wait to complete the n evolves before ending. It is typically called with n=1 as 
  * for n>1 this set-up creates a strange effect on the migration flux (the first batch that evolves does not
  * make use of the islands in the remaining batches).
+ * Since islands are evolved on a thread pool sized according to the hardware (see base_island::evolve()), this method is not needed
+ * to limit the number of threads: it is kept for the control it offers on the order of evolution of the islands.
  *
  * \param[in] n number of time each island will be evolved.
  * \param[in] b the size of the batch of islands to evolve at the same time.
@@ -625,6 +781,7 @@ void archipelago::evolve(int n)
 void archipelago::evolve_batch(int n, unsigned int b, bool randomize)
 {
 	join();
+	update_checkpoint();
 	container_type::size_type arch_size = this->get_size();
 	// Order of populations to evolve, by default biased by the index (lowest first)
 	std::vector<population::size_type> pop_order(arch_size);
@@ -640,11 +797,6 @@ void archipelago::evolve_batch(int n, unsigned int b, bool randomize)
 	}
 	
 	for(size_type p = 0; p < arch_size/b + 1; ++p) {
-		if(p == arch_size/b) { //for the last batch of islands decrease the barrier
-			reset_barrier(arch_size - p*b);
-		} else {
-			reset_barrier(b);
-		}
 		for(size_type i=0; i<b && p*b+i < arch_size; ++i) {
 			m_container[pop_order[p*b+i]]->evolve(n);
 		}
@@ -663,13 +815,49 @@ void archipelago::evolve_batch(int n, unsigned int b, bool randomize)
 void archipelago::evolve_t(int t)
 {
 	join();
+	update_checkpoint();
 	const iterator it_f = m_container.end();
-	reset_barrier(m_container.size());
 	for (iterator it = m_container.begin(); it != it_f; ++it) {
 		(*it)->evolve_t(t);
 	}
 }
 
+/// Run the evolution for a minimum number of function evaluations.
+/**
+ * Will iteratively call island::evolve_fevals(n) on each island of the archipelago and then return.
+ *
+ * \param[in] n number of function evaluations to be performed by each island.
+ */
+void archipelago::evolve_fevals(int n)
+{
+	join();
+	update_checkpoint();
+	const iterator it_f = m_container.end();
+	for (iterator it = m_container.begin(); it != it_f; ++it) {
+		(*it)->evolve_fevals(n);
+	}
+}
+
+/// Get the champions of the islands.
+/**
+ * This method does not wait for the evolution to terminate: for the islands which are evolving, the champions
+ * at the end of their last completed iteration are returned (see base_island::get_champion()).
+ *
+ * @return the champions of the islands, in the order of the islands.
+ *
+ * @throws pagmo::value_error if the champion of an island has not been determined yet.
+ */
+std::vector<population::champion_type> archipelago::get_champions() const
+{
+	std::vector<population::champion_type> retval;
+	retval.reserve(m_container.size());
+	const const_iterator it_f = m_container.end();
+	for (const_iterator it = m_container.begin(); it != it_f; ++it) {
+		retval.push_back((*it)->get_champion());
+	}
+	return retval;
+}
+
 /// Query the status of the archipelago.
 /**
  * @return true if at least one island is evolving, false otherwise.
@@ -737,6 +925,14 @@ void archipelago::set_island(const size_type &idx, const base_island &isl)
 	m_container[idx] = isl.clone();
 	// Tell the island that it is living in an archipelago now.
 	m_container[idx]->m_archi = this;
+	m_mailboxes[idx]->m_capacity = isl.get_size();
+	// The groups need to be rebuilt only if the replaced island was the representative of its group.
+	if (std::find(m_group_reps.begin(),m_group_reps.end(),idx) == m_group_reps.end()) {
+		assign_problem_group(idx);
+	} else {
+		build_problem_groups();
+	}
+	m_checkpoint.m_dirty = true;
 }
 
 /// Get vector of islands in the archipelago.
@@ -755,15 +951,10 @@ std::vector<base_island_ptr> archipelago::get_islands() const
 	return retval;
 }
 
-// Synchronise the start of evolution in each island so that all threads are created and initialised
-// before actually doing any computation.
-void archipelago::sync_island_start() const
-{
-	m_islands_sync_point->wait();
-}
-
 /// Dumps the archipelago migration history
 /**
+ * Only the most recent records are kept in memory (see set_migr_history_capacity()).
+ *
  * @return A string formatted as follows: (x1,y1,z1)\n(x2,y2,z2)..... where x is the number of individuals
  * accepted in island z and coming from island y
  */
@@ -791,6 +982,364 @@ void archipelago::clear_migr_history()
 	m_migr_hist.clear();
 }
 
+/// Get the capacity of the migration history.
+/**
+ * @return the maximum number of records kept in the migration history.
+ */
+archipelago::size_type archipelago::get_migr_history_capacity() const
+{
+	join();
+	return m_migr_hist.capacity();
+}
+
+/// Set the capacity of the migration history.
+/**
+ * The migration history keeps only the most recent records, up to the given capacity, so that its memory footprint stays bounded
+ * in long runs. If the new capacity is smaller than the number of records, the oldest records are discarded. A null capacity disables
+ * the in-memory history (the sink set with set_migr_history_sink() will still receive the records).
+ *
+ * @param[in] capacity maximum number of records kept in the migration history.
+ */
+void archipelago::set_migr_history_capacity(const size_type &capacity)
+{
+	join();
+	m_migr_hist.rset_capacity(capacity);
+	m_checkpoint.m_dirty = true;
+}
+
+/// Set the migration history sink.
+/**
+ * The sink will be called for each migration record, in addition to storing it in the in-memory history. This allows to stream the complete
+ * history (e.g., to a file) while keeping a bounded history in memory. The sink is called from the threads evolving the islands,
+ * but calls are serialised. An empty function removes the sink.
+ *
+ * The sink is neither copied nor serialized along with the archipelago.
+ *
+ * @param[in] sink function to be called for each migration record.
+ */
+void archipelago::set_migr_history_sink(const migr_hist_sink_type &sink)
+{
+	join();
+	m_migr_hist_sink = sink;
+}
+
+// Write data into a file. The data is written into a temporary file first, which is then renamed, so that an interruption
+// during the write never leaves a truncated file behind.
+static void write_checkpoint_file(const std::string &name, const std::string &data)
+{
+	const std::string tmp_name = name + ".tmp";
+	std::ofstream ofs(tmp_name.c_str(),std::ios::out | std::ios::binary | std::ios::trunc);
+	ofs.write(data.data(),boost::numeric_cast<std::streamsize>(data.size()));
+	ofs.close();
+	if (!ofs) {
+		std::remove(tmp_name.c_str());
+		pagmo_throw(io_error,std::string("cannot write the checkpoint file ") + tmp_name);
+	}
+	if (std::rename(tmp_name.c_str(),name.c_str())) {
+		std::remove(tmp_name.c_str());
+		pagmo_throw(io_error,std::string("cannot rename the checkpoint file ") + tmp_name);
+	}
+}
+
+// Name of the file holding the state of island idx.
+static std::string checkpoint_island_file(const std::string &prefix, const archipelago::size_type &idx)
+{
+	return prefix + ".island" + boost::lexical_cast<std::string>(idx);
+}
+
+// The island files saved during the evolution are written by a dedicated thread, so that the threads of the pool evolving
+// the islands never wait for the file system. The thread is started when a file is queued and terminates once the queue
+// is empty. Only the most recent data of each file is kept in the queue.
+struct archipelago::checkpoint_writer
+{
+	checkpoint_writer():m_active(false) {}
+	// Queue data for writing into the file name. The content of data is consumed.
+	static void post(const boost::shared_ptr<checkpoint_writer> &w, const std::string &name, std::string &data)
+	{
+		lock_type lock(w->m_mutex);
+		w->m_pending[name].swap(data);
+		if (w->m_active) {
+			return;
+		}
+		try {
+			boost::thread(boost::bind(&checkpoint_writer::run,w)).detach();
+		} catch (...) {
+			w->m_pending.erase(name);
+			throw;
+		}
+		w->m_active = true;
+	}
+	// Write the queued files until the queue is empty.
+	static void run(const boost::shared_ptr<checkpoint_writer> &w)
+	{
+		while (true) {
+			std::string name, data;
+			{
+				lock_type lock(w->m_mutex);
+				if (w->m_pending.empty()) {
+					w->m_active = false;
+					w->m_cond.notify_all();
+					return;
+				}
+				const std::map<std::string,std::string>::iterator it = w->m_pending.begin();
+				name = it->first;
+				data.swap(it->second);
+				w->m_pending.erase(it);
+			}
+			try {
+				write_checkpoint_file(name,data);
+			} catch (const std::exception &e) {
+				std::cout << "Error during the checkpoint: " << e.what() << std::endl;
+			}
+		}
+	}
+	// Wait until all the queued files have been written.
+	void wait()
+	{
+		boost::unique_lock<boost::mutex> lock(m_mutex);
+		while (m_active) {
+			m_cond.wait(lock);
+		}
+	}
+	std::map<std::string,std::string>	m_pending;
+	bool					m_active;
+	boost::mutex				m_mutex;
+	boost::condition_variable		m_cond;
+};
+
+/// Enable periodic checkpointing.
+/**
+ * Once checkpointing is enabled, the state of the archipelago is saved into binary files whose names start with prefix:
+ * - the structure file, prefix.archipelago, holds the whole archipelago (as saved by Boost serialization) and is written
+ *   by this method and whenever the structure of the archipelago has changed (e.g., after push_back(), set_island(), set_algorithm(), etc.),
+ *   before the next evolution;
+ * - the island files, prefix.island0, prefix.island1, ..., hold the state of each island which changes during the evolution:
+ *   population (without the problem, of which only the evaluation counters are saved), algorithm (including its random number generators), evolution time and migration mailbox (i.e., the individuals
+ *   waiting to migrate and the random number generators used in migration).
+ *
+ * The island files are saved in the background: at the end of each iteration, the thread evolving an island serialises the state of the island
+ * in memory if at least t milliseconds have passed since its last save, and hands it over to a dedicated thread which writes the file. Hence no island
+ * waits for the others or for the file system, and the islands which are not evolving never rewrite their files. join() waits for the pending
+ * files to be written. checkpoint() can be used to save the islands which have evolved since their last save at the end of an evolution.
+ *
+ * Each file is written into a temporary file and then renamed, so that the checkpoint stays consistent even if the process is terminated during a write.
+ * Errors while writing an island file are reported on the standard output and do not interrupt the evolution.
+ *
+ * The archipelago can be restored with load_checkpoint(). Since the islands are saved independently, the individuals sent by an island
+ * to another one after the latter was saved can be lost. The migration history is restored as it was when the structure file was written.
+ * The binary format is not portable across platforms.
+ *
+ * Copies of the archipelago are not checkpointed. An empty prefix disables checkpointing.
+ *
+ * @param[in] prefix prefix of the names of the checkpoint files.
+ * @param[in] t minimum interval between two writes of the file of an island (in milliseconds).
+ *
+ * @throws value_error if t is negative.
+ * @throws io_error if the structure file cannot be written.
+ */
+void archipelago::set_checkpoint(const std::string &prefix, int t)
+{
+	join();
+	if (t < 0) {
+		pagmo_throw(value_error,"the checkpoint interval must be non-negative");
+	}
+	m_checkpoint = checkpoint_state();
+	if (prefix.empty()) {
+		return;
+	}
+	m_checkpoint.m_prefix = prefix;
+	m_checkpoint.m_interval = t;
+	m_checkpoint.m_writer.reset(new checkpoint_writer());
+	try {
+		write_checkpoint_structure();
+	} catch (...) {
+		m_checkpoint = checkpoint_state();
+		throw;
+	}
+}
+
+/// Save the checkpoint.
+/**
+ * Will wait for the evolution to terminate and then bring the checkpoint up to date, writing the structure file if the structure
+ * of the archipelago has changed, the files of the islands which have evolved since their last write otherwise. See set_checkpoint().
+ *
+ * @throws value_error if checkpointing has not been enabled.
+ * @throws io_error if a checkpoint file cannot be written.
+ */
+void archipelago::checkpoint()
+{
+	join();
+	if (m_checkpoint.m_prefix.empty()) {
+		pagmo_throw(value_error,"checkpointing has not been enabled");
+	}
+	if (m_checkpoint.m_dirty) {
+		write_checkpoint_structure();
+		return;
+	}
+	for (size_type i = 0; i < m_checkpoint.m_islands.size(); ++i) {
+		if (m_checkpoint.m_islands[i].m_iterations != m_checkpoint.m_islands[i].m_written) {
+			write_checkpoint_file(checkpoint_island_file(m_checkpoint.m_prefix,i),checkpoint_island_data(i));
+		}
+	}
+}
+
+/// Restore the archipelago from a checkpoint.
+/**
+ * The archipelago is loaded from the structure file written by set_checkpoint() with the given prefix, and the state of each island
+ * is then loaded from its file, if present. Island files left over by a previous structure file are ignored. Checkpointing is disabled
+ * on the restored archipelago.
+ *
+ * @param[in] prefix prefix of the names of the checkpoint files.
+ *
+ * @throws io_error if the structure file cannot be read, or if an island file is inconsistent.
+ */
+void archipelago::load_checkpoint(const std::string &prefix)
+{
+	join();
+	const std::string name = prefix + ".archipelago";
+	std::ifstream ifs(name.c_str(),std::ios::in | std::ios::binary);
+	if (!ifs) {
+		pagmo_throw(io_error,std::string("cannot read the checkpoint file ") + name);
+	}
+	archipelago archi;
+	boost::uint64_t stamp;
+	{
+		boost::archive::binary_iarchive ia(ifs);
+		ia >> stamp;
+		ia >> archi;
+	}
+	for (size_type i = 0; i < archi.m_container.size(); ++i) {
+		const std::string isl_name = checkpoint_island_file(prefix,i);
+		std::ifstream isl_ifs(isl_name.c_str(),std::ios::in | std::ios::binary);
+		if (!isl_ifs) {
+			continue;
+		}
+		boost::archive::binary_iarchive ia(isl_ifs);
+		boost::uint64_t isl_stamp;
+		ia >> isl_stamp;
+		if (isl_stamp != stamp) {
+			continue;
+		}
+		size_type idx;
+		ia >> idx;
+		if (idx != i) {
+			pagmo_throw(io_error,std::string("inconsistent checkpoint file ") + isl_name);
+		}
+		base_island &isl = *archi.m_container[i];
+		ia >> isl.m_evo_time;
+		ia >> isl.m_algo;
+		// Bring the counters of the problem restored from the structure file up to date.
+		// NOTE: unsigned arithmetic takes care of the wrapping of the counters.
+		unsigned int fevals, cevals;
+		ia >> fevals;
+		ia >> cevals;
+		const problem::base &prob = isl.m_pop.problem();
+		prob.add_fevals(fevals - prob.get_fevals());
+		prob.add_cevals(cevals - prob.get_cevals());
+		population::state_proxy proxy(isl.m_pop);
+		ia >> proxy;
+		ia >> *archi.m_mailboxes[i];
+	}
+	*this = archi;
+	m_checkpoint = checkpoint_state();
+}
+
+// Write the structure file, if checkpointing is enabled and the structure of the archipelago has changed. Must be called after join().
+void archipelago::update_checkpoint()
+{
+	if (!m_checkpoint.m_prefix.empty() && m_checkpoint.m_dirty) {
+		write_checkpoint_structure();
+	}
+}
+
+// Write the structure file, and reset the records of the islands. The stamp is taken from the clock, so that
+// the island files left over by another process are recognised as stale. Must be called after join().
+void archipelago::write_checkpoint_structure()
+{
+	pagmo_assert(!m_checkpoint.m_prefix.empty());
+	const boost::posix_time::ptime now = boost::posix_time::microsec_clock::local_time();
+	const boost::uint64_t stamp = std::max<boost::uint64_t>(m_checkpoint.m_stamp + 1u,
+		boost::numeric_cast<boost::uint64_t>((boost::posix_time::microsec_clock::universal_time() - boost::posix_time::from_time_t(0)).total_microseconds()));
+	std::ostringstream oss;
+	{
+		boost::archive::binary_oarchive oa(oss);
+		const archipelago &self = *this;
+		oa << stamp;
+		oa << self;
+	}
+	write_checkpoint_file(m_checkpoint.m_prefix + ".archipelago",oss.str());
+	m_checkpoint.m_stamp = stamp;
+	m_checkpoint.m_dirty = false;
+	m_checkpoint.m_islands.assign(m_container.size(),checkpoint_state::island_record());
+	for (size_type i = 0; i < m_checkpoint.m_islands.size(); ++i) {
+		m_checkpoint.m_islands[i].m_last = now;
+	}
+}
+
+// Serialise the state of island idx into the content of its file, and update the record of the island. Must be called either after join()
+// or by the thread evolving the island.
+std::string archipelago::checkpoint_island_data(const size_type &idx)
+{
+	pagmo_assert(idx < m_container.size() && idx < m_checkpoint.m_islands.size());
+	base_island &isl = *m_container[idx];
+	// The neighbours might be delivering emigrants to the mailbox: take a snapshot under its lock.
+	boost::scoped_ptr<const migration_mailbox> mailbox;
+	{
+		lock_type lock(m_mailboxes[idx]->m_mutex);
+		mailbox.reset(new migration_mailbox(*m_mailboxes[idx]));
+	}
+	std::ostringstream oss;
+	{
+		boost::archive::binary_oarchive oa(oss);
+		oa << m_checkpoint.m_stamp;
+		oa << idx;
+		oa << isl.m_evo_time;
+		oa << isl.m_algo;
+		// NOTE: the problem is in the structure file, only its evaluation counters change during the evolution.
+		const unsigned int fevals = isl.m_pop.problem().get_fevals(), cevals = isl.m_pop.problem().get_cevals();
+		oa << fevals;
+		oa << cevals;
+		population::state_proxy proxy(isl.m_pop);
+		oa << proxy;
+		oa << *mailbox;
+	}
+	checkpoint_state::island_record &record = m_checkpoint.m_islands[idx];
+	record.m_written = record.m_iterations;
+	record.m_last = boost::posix_time::microsec_clock::local_time();
+	return oss.str();
+}
+
+// This method will be called by each island of the archipelago at the end of each iteration of the evolution. Its task is
+// to queue the file of the island for writing if checkpointing is enabled and the checkpoint interval has elapsed since the last save.
+void archipelago::checkpoint_island(base_island &isl)
+{
+	if (m_checkpoint.m_prefix.empty()) {
+		return;
+	}
+	pagmo_assert(isl.m_archi == this);
+	const size_type isl_idx = locate_island(isl);
+	pagmo_assert(isl_idx < m_checkpoint.m_islands.size());
+	checkpoint_state::island_record &record = m_checkpoint.m_islands[isl_idx];
+	++record.m_iterations;
+	if ((boost::posix_time::microsec_clock::local_time() - record.m_last).total_milliseconds() < m_checkpoint.m_interval) {
+		return;
+	}
+	try {
+		std::string data = checkpoint_island_data(isl_idx);
+		checkpoint_writer::post(m_checkpoint.m_writer,checkpoint_island_file(m_checkpoint.m_prefix,isl_idx),data);
+	} catch (const std::exception &e) {
+		std::cout << "Error during the checkpoint of island " << isl_idx << ": " << e.what() << std::endl;
+	}
+}
+
+// Wait for the island files queued during the evolution to be written.
+void archipelago::flush_checkpoint() const
+{
+	if (m_checkpoint.m_writer) {
+		m_checkpoint.m_writer->wait();
+	}
+}
+
 /// Overload stream operator for pagmo::archipelago.
 /**
  * Equivalent to printing archipelago::human_readable() to stream.
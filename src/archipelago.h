@@ -25,12 +25,16 @@
 #ifndef PAGMO_ARCHIPELAGO_H
 #define PAGMO_ARCHIPELAGO_H
 
-#include <boost/scoped_ptr.hpp>
-#include <boost/thread/barrier.hpp>
+#include <boost/circular_buffer.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/function.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/shared_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/unordered_map.hpp>
 #include <iostream>
 #include <string>
@@ -51,6 +55,16 @@ namespace pagmo {
 
 /// Archipelago class.
 /**
+ * The islands of an archipelago evolve independently from each other, without any synchronisation: each island migrates individuals
+ * to/from its neighbours at the end/beginning of each of its iterations (i.e., of each call to algorithm::base::evolve()).
+ * Hence, besides evolve(), which performs the same number of iterations on each island, the archipelago can be evolved asynchronously
+ * by giving each island a budget of wall-clock time (evolve_t()) or of function evaluations (evolve_fevals()): fast islands will then perform
+ * more iterations than slow ones, instead of waiting for them. The progress of the evolution can be monitored with get_champions(),
+ * which does not wait for the evolution to terminate.
+ *
+ * Long runs can be protected against interruptions with set_checkpoint(): the state of the islands is then saved periodically, while the
+ * archipelago is evolving, and can be restored with load_checkpoint() (see set_checkpoint() for details).
+ *
  * @author Francesco Biscani (bluescarni@gmail.com)
  * @author Marek Ruciński (marek.rucinski@gmail.com)
  */
@@ -105,21 +119,112 @@ class __PAGMO_VISIBLE archipelago
 			 */
 			destination = 1
 		};
+		/// Migration history sink type.
+		/**
+		 * Function called with the number of individuals, the index of the source island and the index of the destination island
+		 * of each migration (see set_migr_history_sink()).
+		 */
+		typedef boost::function<void (population::size_type, size_type, size_type)> migr_hist_sink_type;
+		/// Default capacity of the migration history.
+		static const size_type default_migr_hist_capacity = 10000;
 	private:
 		// Iterators.
 		typedef container_type::iterator iterator;
 		typedef container_type::const_iterator const_iterator;
-		// Container for migrating individuals. This a hash map containing hash maps as values.
-		// Please NOTE carefully: in case of desination migration, item n in the outer hash map is supposed to contain a hash map with a single
-		// (n,emigrants vector) pair (in other words, containing redundantly n twice). In case of source migration, item n will contain a map of
-		// emigrants from other islands.
-		typedef boost::unordered_map<size_type,boost::unordered_map<size_type,std::vector<individual_type> > > migration_map_type;
 		// Lock type.
 		typedef boost::lock_guard<boost::mutex> lock_type;
+		// Migration mailbox of an island. Each mailbox has its own mutex, so that islands exchanging individuals
+		// contend only with their neighbours and never on an archipelago-wide lock.
+		// In case of source migration direction, the mailbox is an "inbox" collecting the emigrants sent to the island,
+		// grouped by source island. The number of individuals pending from each source is bounded by the capacity of the
+		// mailbox, the oldest ones being dropped first.
+		// In case of destination migration direction, the mailbox is an "outbox" holding the best individuals of the island.
+		// The outbox is replaced as a whole after each evolution and never modified in place, hence the neighbours can share it
+		// without copying it under the lock.
+		struct migration_mailbox
+		{
+			typedef boost::unordered_map<size_type,std::vector<individual_type> > inbox_type;
+			typedef boost::shared_ptr<const std::vector<individual_type> > outbox_type;
+			migration_mailbox():m_capacity(0) {}
+			migration_mailbox(const migration_mailbox &other):m_mutex(),m_inbox(other.m_inbox),m_outbox(other.m_outbox),
+				m_capacity(other.m_capacity),m_drng(other.m_drng),m_urng(other.m_urng) {}
+			template <class Archive>
+			void save(Archive &ar, const unsigned int) const
+			{
+				ar << m_inbox;
+				const bool has_outbox = static_cast<bool>(m_outbox);
+				ar << has_outbox;
+				if (has_outbox) {
+					ar << *m_outbox;
+				}
+				ar << m_capacity;
+				ar << m_drng;
+				ar << m_urng;
+			}
+			template <class Archive>
+			void load(Archive &ar, const unsigned int)
+			{
+				ar >> m_inbox;
+				bool has_outbox;
+				ar >> has_outbox;
+				if (has_outbox) {
+					boost::shared_ptr<std::vector<individual_type> > outbox(new std::vector<individual_type>());
+					ar >> *outbox;
+					m_outbox = outbox;
+				} else {
+					m_outbox.reset();
+				}
+				ar >> m_capacity;
+				ar >> m_drng;
+				ar >> m_urng;
+			}
+			BOOST_SERIALIZATION_SPLIT_MEMBER()
+			boost::mutex				m_mutex;
+			inbox_type				m_inbox;
+			outbox_type				m_outbox;
+			// Maximum number of individuals pending in the inbox from each source island.
+			population::size_type			m_capacity;
+			// Rngs used during migration. They are accessed only by the island owning the mailbox, hence they need no locking.
+			rng_double				m_drng;
+			rng_uint32				m_urng;
+		};
+		// Shared pointer to mailbox.
+		typedef boost::shared_ptr<migration_mailbox> mailbox_ptr;
+		// Container of mailboxes, one per island.
+		typedef std::vector<mailbox_ptr> mailbox_container_type;
 		// Migration history item: (n_individuals,orig_island,dest_island) tuple.
 		typedef boost::tuple<population::size_type,size_type,size_type> migr_hist_item;
-		// Container of migration history: vector of history items.
-		typedef std::vector<migr_hist_item> migr_hist_type;
+		// Container of migration history: ring buffer of the most recent history items.
+		typedef boost::circular_buffer<migr_hist_item> migr_hist_type;
+		// Background writer of the island files (see archipelago.cpp).
+		struct checkpoint_writer;
+		// Checkpoint settings and bookkeeping. The checkpoint consists of a structure file, holding the whole archipelago,
+		// and of one file per island, holding the state of the island which changes during the evolution.
+		struct checkpoint_state
+		{
+			// Record of an island. Each record is accessed only by the thread evolving the island, hence it needs no locking.
+			struct island_record
+			{
+				island_record():m_iterations(0),m_written(0) {}
+				// Time of the last write of the island file.
+				boost::posix_time::ptime	m_last;
+				// Number of iterations performed by the island, and number of iterations at the time of the last write.
+				std::size_t			m_iterations;
+				std::size_t			m_written;
+			};
+			checkpoint_state():m_interval(0),m_stamp(0),m_dirty(false) {}
+			// Prefix of the file names. An empty prefix disables checkpointing.
+			std::string			m_prefix;
+			// Minimum interval between two writes of an island file (in milliseconds).
+			int				m_interval;
+			// Stamp of the structure file, written in the island files to detect stale ones.
+			boost::uint64_t			m_stamp;
+			// Flag signalling that the structure of the archipelago has changed since the last write of the structure file.
+			bool				m_dirty;
+			std::vector<island_record>	m_islands;
+			// Writer of the island files saved during the evolution.
+			boost::shared_ptr<checkpoint_writer>	m_writer;
+		};
 	public:
 		explicit archipelago(distribution_type = point_to_point, migration_direction = destination);
 		explicit archipelago(const topology::base &, distribution_type = point_to_point, migration_direction = destination);
@@ -141,27 +246,45 @@ class __PAGMO_VISIBLE archipelago
 		void evolve(int = 1);
 		void evolve_batch(int, unsigned int, bool = true);
 		void evolve_t(int);
+		void evolve_fevals(int);
+		std::vector<population::champion_type> get_champions() const;
 		bool busy() const;
 		void interrupt();
 		std::string dump_migr_history() const;
 		void clear_migr_history();
+		size_type get_migr_history_capacity() const;
+		void set_migr_history_capacity(const size_type &);
+		void set_migr_history_sink(const migr_hist_sink_type &);
 		void set_island(const size_type &, const base_island &);
 		std::vector<base_island_ptr> get_islands() const;
 		base_island_ptr get_island(const size_type &) const;
 		void set_seeds(unsigned int);
+		void set_checkpoint(const std::string &, int);
+		void checkpoint();
+		void load_checkpoint(const std::string &);
 	private:
 		void pre_evolution(base_island &);
 		void post_evolution(base_island &);
-		void reset_barrier(const size_type &);
 		void build_immigrants_vector(std::vector<std::pair<population::size_type, individual_type > > &,
-			const base_island &, base_island &,
+			const size_type &, const base_island &,
 			const std::vector<individual_type> &) const;
+		void move_immigrants_vector(std::vector<std::pair<population::size_type, individual_type > > &,
+			const size_type &, const base_island &,
+			std::vector<individual_type> &) const;
+		mailbox_ptr new_mailbox(const base_island &);
+		static void deliver_emigrants(migration_mailbox &, const size_type &, std::vector<individual_type> &, bool);
 		void check_migr_attributes() const;
-		void sync_island_start() const;
 		size_type locate_island(const base_island &) const;
 		bool destruction_checks() const;
 		void reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &,
-			const base_island &) const;
+			const base_island &, const size_type &) const;
+		void assign_problem_group(const size_type &);
+		void build_problem_groups();
+		void update_checkpoint();
+		void write_checkpoint_structure();
+		std::string checkpoint_island_data(const size_type &);
+		void checkpoint_island(base_island &);
+		void flush_checkpoint() const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -172,20 +295,25 @@ class __PAGMO_VISIBLE archipelago
 			ar & m_topology;
 			ar & m_dist_type;
 			ar & m_migr_dir;
-			ar & m_migr_map;
-			ar & m_drng;
+			ar & m_mailboxes;
 			ar & m_urng;
-			// NOTE: this would need tuple serialization...
-			//ar & m_migr_hist;
+			// NOTE: the content of the migration history is not serialized (it would need tuple serialization),
+			// only its capacity is.
 			boost::serialization::split_member(ar, *this, version);
 		}
 
 		template <class Archive>
-		void save(Archive &, const unsigned int) const
-		{}
+		void save(Archive &ar, const unsigned int) const
+		{
+			const size_type capacity = m_migr_hist.capacity();
+			ar << capacity;
+		}
 		template <class Archive>
-		void load(Archive &, const unsigned int)
+		void load(Archive &ar, const unsigned int)
 		{
+			size_type capacity;
+			ar >> capacity;
+			m_migr_hist.set_capacity(capacity);
 			// NOTE: archi pointer is not saved during island serialization. Hence, upon loading,
 			// we are going to set the archi pointer of the islands to this. 
 			for (size_type i = 0; i < m_container.size(); ++i) {
@@ -193,26 +321,34 @@ class __PAGMO_VISIBLE archipelago
 			}
 			// NOTE: migr history is not saved, so upon loading we clear it.
 			m_migr_hist.clear();
+			build_problem_groups();
+			m_checkpoint.m_dirty = true;
 		}
 		// Container of islands.
 		container_type				m_container;
-		// A barrier used to synchronise the start time of islands.
-		boost::scoped_ptr<boost::barrier>	m_islands_sync_point;
 		// Topology.
 		topology::base_ptr			m_topology;
 		// Distribution type.
 		distribution_type			m_dist_type;
 		// Migration direction.
 		migration_direction			m_migr_dir;
-		// Migration container.
-		migration_map_type			m_migr_map;
-		// Rngs used during migration.
-		rng_double					m_drng;
+		// Migration mailboxes.
+		mailbox_container_type			m_mailboxes;
+		// Problem groups: islands in the same group hold the same deterministic problem, hence individuals migrating
+		// among them need not be re-evaluated. Element i is the group of island i.
+		std::vector<size_type>			m_problem_groups;
+		// Representative island of each group.
+		std::vector<size_type>			m_group_reps;
+		// Rng used to seed the rngs of the mailboxes and to shuffle islands in evolve_batch().
 		rng_uint32					m_urng;
-		// Migration mutex.
-		boost::mutex				m_migr_mutex;
+		// Migration history mutex.
+		boost::mutex				m_migr_hist_mutex;
 		// Migration history.
 		migr_hist_type				m_migr_hist;
+		// Migration history sink.
+		migr_hist_sink_type			m_migr_hist_sink;
+		// Checkpoint state.
+		checkpoint_state			m_checkpoint;
 
 };
 
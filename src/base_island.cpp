@@ -24,6 +24,10 @@
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/variate_generator.hpp>
@@ -46,9 +50,25 @@
 #include "population.h"
 #include "problem/base.h"
 #include "types.h"
+#include "util/thread_pool.h"
 
 namespace pagmo
 {
+
+// State of the evolution of an island, shared between the island and its evolution tasks.
+struct base_island::evolution_state
+{
+	evolution_state():m_running(false),m_interrupt(false) {}
+	boost::mutex			m_mutex;
+	boost::condition_variable	m_cond;
+	// Flag signalling that an evolution is undergoing.
+	bool				m_running;
+	// Flag signalling that the evolution must stop at the end of the current iteration.
+	bool				m_interrupt;
+	// Snapshot of the champion of the population, published after each iteration of the evolution.
+	population::champion_type	m_champion;
+};
+
 /// Constructor from problem::base, algorithm::base, number of individuals, migration probability and selection/replacement policies.
 /**
  * Will store a copy of the problem, of the algorithm and of the policies internally, will initialise internal population to n individuals
@@ -64,7 +84,8 @@ namespace pagmo
  */
 base_island::base_island(const algorithm::base &a, const problem::base &p, int n,
 	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
-	m_algo(a.clone()),m_pop(p,n),m_archi(0),m_evo_time(0),m_s_policy(s_policy.clone()),m_r_policy(r_policy.clone()) { }
+	m_algo(a.clone()),m_pop(p,n),m_archi(0),m_evo_time(0),m_s_policy(s_policy.clone()),m_r_policy(r_policy.clone()),
+	m_evo_state(new evolution_state()) { }
 
 /// Copy constructor.
 /**
@@ -72,7 +93,7 @@ base_island::base_island(const algorithm::base &a, const problem::base &p, int n
  *
  * @param[in] isl island to be copied.
  */
-base_island::base_island(const base_island &isl):m_pop(isl.get_population())
+base_island::base_island(const base_island &isl):m_pop(isl.get_population()),m_evo_state(new evolution_state())
 {
 	// Population has already been done and get_population() above already called join().
 	m_algo = isl.m_algo->clone();
@@ -80,7 +101,6 @@ base_island::base_island(const base_island &isl):m_pop(isl.get_population())
 	m_evo_time = isl.m_evo_time;
 	m_s_policy = isl.m_s_policy->clone();
 	m_r_policy = isl.m_r_policy->clone();
-	m_evo_thread.reset(0);
 }
 
 /// Constructor from population.
@@ -96,7 +116,8 @@ base_island::base_island(const base_island &isl):m_pop(isl.get_population())
  */
 base_island::base_island(const algorithm::base &a, const population &pop,
 	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
-	m_algo(a.clone()),m_pop(pop),m_archi(0),m_evo_time(0),m_s_policy(s_policy.clone()),m_r_policy(r_policy.clone()) { }
+	m_algo(a.clone()),m_pop(pop),m_archi(0),m_evo_time(0),m_s_policy(s_policy.clone()),m_r_policy(r_policy.clone()),
+	m_evo_state(new evolution_state()) { }
 
 /// Assignment operator.
 /**
@@ -119,7 +140,6 @@ base_island &base_island::operator=(const base_island &isl)
 		m_evo_time = isl.m_evo_time;
 		m_s_policy = isl.m_s_policy->clone();
 		m_r_policy = isl.m_r_policy->clone();
-		m_evo_thread.reset(0);
 	}
 	return *this;
 }
@@ -192,29 +212,51 @@ std::string base_island::human_readable() const
 /// Join island.
 /**
  * This method is intended to block the flow of the program until any ongoing evolution has terminated.
- * The default implementation will join on the internal thread object if an evolution is ongoing,
- * otherwise it will be a no-op.
+ * The default implementation will wait for the last evolution task of the island to complete if an evolution is ongoing,
+ * otherwise it will be a no-op. When called from a worker of the process-wide thread pool, the calling thread executes the pending
+ * tasks of the pool while waiting, so that islands can be evolved and joined from within the evolution of another island.
  * Re-implementation of this method should always call the default implementation.
  */
 void base_island::join() const
 {
-	if (m_evo_thread && m_evo_thread->joinable()) {
+	boost::unique_lock<boost::mutex> lock(m_evo_state->m_mutex);
+	util::thread_pool &pool = util::thread_pool::get_default();
+	if (!pool.is_worker() || m_evo_thread) {
+		while (m_evo_state->m_running) {
+			m_evo_state->m_cond.wait(lock);
+		}
+	} else {
+		// We are being joined from a task of the pool (e.g., an algorithm evolving islands of its own, like algorithm::pade):
+		// the evolution might be queued behind the calling task, hence run the pending tasks while waiting.
+		while (m_evo_state->m_running) {
+			lock.unlock();
+			const bool ran = pool.run_pending_task();
+			lock.lock();
+			if (!ran && m_evo_state->m_running) {
+				// Nothing to do: the evolution is running on another worker. Check periodically for new tasks.
+				m_evo_state->m_cond.timed_wait(lock,boost::posix_time::milliseconds(1));
+			}
+		}
+	}
+	// The dedicated thread of a blocking island terminates right after marking the evolution as completed.
+	// NOTE: the thread does not need the mutex any more, hence it can be joined while holding it.
+	if (m_evo_thread) {
 		m_evo_thread->join();
+		m_evo_thread.reset();
 	}
 }
 
 /// Thread entry hook.
 /**
- * This method will be called before any other operation takes place in the threads spawned during
- * evolution. Default implementation is a no-op.
+ * This method will be called in the worker thread before each iteration of the evolution (iterations of the same evolution
+ * may be executed by different threads). Default implementation is a no-op.
  */
 void base_island::thread_entry()
 {}
 
 /// Thread exit hook.
 /**
- * This method will be called after any other operation has taken place in the threads spawned during
- * evolution. Default implementation is a no-op.
+ * This method will be called in the worker thread after each iteration of the evolution. Default implementation is a no-op.
  */
 void base_island::thread_exit()
 {}
@@ -233,65 +275,176 @@ struct base_island::raii_thread_hook
 	base_island *m_ptr;
 };
 
-// Evolver thread object. This is a callable helper object used to launch an evolution for a given number of iterations.
-struct base_island::int_evolver {
-	int_evolver(base_island *i, const std::size_t &n):m_i(i),m_n(n) {}
+/// Blocking evolution.
+/**
+ * Return true if perform_evolution() spends most of its time waiting for results computed elsewhere (e.g., by other processes or by
+ * other machines). The evolutions of such islands are run on dedicated threads rather than on the process-wide thread pool, so that
+ * the number of concurrent remote evolutions is not limited by the size of the pool, and the other islands are not held up.
+ * Default implementation returns false.
+ *
+ * @return true if the evolution of the island blocks waiting for external results, false otherwise.
+ */
+bool base_island::blocking() const
+{
+	return false;
+}
+
+// Evolution task. It runs the iterations of the evolver until step() returns false: blocking islands run all of them in a loop on their
+// dedicated thread, the other islands run one iteration per task of the process-wide thread pool, re-enqueueing the task after each one.
+template <class Evolver>
+struct base_island::evolution_task {
+	explicit evolution_task(const Evolver &evolver):m_evolver(evolver) {}
 	void operator()();
-	void juice_impl(boost::posix_time::ptime &);
-	base_island 		*m_i;
-	const std::size_t	m_n;
+	Evolver	m_evolver;
 };
 
-void base_island::int_evolver::juice_impl(boost::posix_time::ptime &start)
+template <class Evolver>
+void base_island::evolution_task<Evolver>::operator()()
 {
-	start = boost::posix_time::microsec_clock::local_time();
-	// Synchronise start with all other threads if we are in an archi.
-	if (m_i->m_archi) {
-		m_i->m_archi->sync_island_start();
-	}
-	const raii_thread_hook hook(m_i);
-	for (std::size_t i = 0; i < m_n; ++i) {
-		// Call pre-evolve hooks.
-		if (m_i->m_archi) {
-			m_i->m_archi->pre_evolution(*m_i);
+	base_island *isl = m_evolver.m_i;
+	while (m_evolver.step()) {
+		if (isl->blocking()) {
+			continue;
 		}
-		m_i->m_pop.problem().pre_evolution(m_i->m_pop);
-		// Call the evolution.
-		m_i->perform_evolution(*m_i->m_algo,m_i->m_pop);
-		// Post-evolve hooks.
-		if (m_i->m_archi) {
-			m_i->m_archi->post_evolution(*m_i);
+		try {
+			util::thread_pool::get_default().enqueue(*this);
+			return;
+		} catch (...) {
+			std::cout << "Error during island evolution using " << isl->m_algo->get_name() << ": failed to enqueue the next iteration." << std::endl;
+			break;
 		}
-		m_i->m_pop.problem().post_evolution(m_i->m_pop);
-		// Set the interruption point.
-		boost::this_thread::interruption_point();
 	}
+	stop_evolution(m_evolver.m_state);
+}
+
+// Launch an evolution on the process-wide thread pool or, for blocking islands, on a new dedicated thread. Must be called after join().
+template <class Evolver>
+void base_island::launch(const Evolver &evolver)
+{
+	pagmo_assert(!m_evo_thread);
+	start_evolution();
+	try {
+		if (blocking()) {
+			// NOTE: the thread is created under the mutex, so that concurrent calls to join() see it as soon as the evolution is running.
+			boost::lock_guard<boost::mutex> lock(m_evo_state->m_mutex);
+			m_evo_thread.reset(new boost::thread(evolution_task<Evolver>(evolver)));
+		} else {
+			util::thread_pool::get_default().enqueue(evolution_task<Evolver>(evolver));
+		}
+	} catch (...) {
+		stop_evolution(m_evo_state);
+		pagmo_throw(std::runtime_error,"failed to launch the evolution");
+	}
+}
+
+// Perform one iteration of the evolution, including the pre/post evolution hooks.
+void base_island::evolve_once()
+{
+	const raii_thread_hook hook(this);
+	// Call pre-evolve hooks.
+	if (m_archi) {
+		m_archi->pre_evolution(*this);
+	}
+	m_pop.problem().pre_evolution(m_pop);
+	// Call the evolution.
+	perform_evolution(*m_algo,m_pop);
+	// Post-evolve hooks.
+	if (m_archi) {
+		m_archi->post_evolution(*this);
+	}
+	m_pop.problem().post_evolution(m_pop);
 }
 
-// Implementation of int_evolver's juice.
-void base_island::int_evolver::operator()()
+// Perform one iteration of the evolution and accumulate its duration into the evolution time. Return false if the evolution failed.
+bool base_island::timed_evolve_once()
 {
-	boost::posix_time::ptime start;
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	bool retval = true;
 	try {
-		juice_impl(start);
-	} catch (const boost::thread_interrupted &) {
-		// In case of interruption, don't do anything special.
+		evolve_once();
 	} catch (const std::exception &e) {
-		std::cout << "Error during island evolution using " << m_i->m_algo->get_name() << ": " << e.what() << std::endl;
+		std::cout << "Error during island evolution using " << m_algo->get_name() << ": " << e.what() << std::endl;
+		retval = false;
 	} catch (...) {
-		std::cout << "Error during island evolution using " << m_i->m_algo->get_name() << ", unknown exception caught. :(" << std::endl;
+		std::cout << "Error during island evolution using " << m_algo->get_name() << ", unknown exception caught. :(" << std::endl;
+		retval = false;
 	}
-	// Try to compute the evolution time before exiting. In case something goes wrong, do not do anything.
+	// Try to compute the evolution time. In case something goes wrong, do not do anything.
 	try {
 		// We must take care of potentially low-accuracy clocks, where the time difference could be negative for
 		// _really_ short evolution times. In that case do not add anything to the total evolution time.
 		const boost::posix_time::time_duration diff = boost::posix_time::microsec_clock::local_time() - start;
 		if (diff.total_milliseconds() >= 0) {
-			m_i->m_evo_time += boost::numeric_cast<std::size_t>(diff.total_milliseconds());
+			m_evo_time += boost::numeric_cast<std::size_t>(diff.total_milliseconds());
 		}
 	} catch (...) {
 		std::cout << "Error calculating evolution time.\n";
 	}
+	publish_champion();
+	// Let the archipelago checkpoint the island.
+	if (retval && m_archi) {
+		m_archi->checkpoint_island(*this);
+	}
+	return retval;
+}
+
+// Publish a snapshot of the champion of the population, so that it can be queried while the evolution is undergoing.
+void base_island::publish_champion()
+{
+	population::champion_type champion;
+	try {
+		champion = m_pop.champion();
+	} catch (const value_error &) {
+		// The champion has not been determined yet: publish an empty one.
+	}
+	boost::lock_guard<boost::mutex> lock(m_evo_state->m_mutex);
+	m_evo_state->m_champion = champion;
+}
+
+// Mark the evolution as started. Must be called after join().
+void base_island::start_evolution()
+{
+	population::champion_type champion;
+	try {
+		champion = m_pop.champion();
+	} catch (const value_error &) {}
+	boost::lock_guard<boost::mutex> lock(m_evo_state->m_mutex);
+	pagmo_assert(!m_evo_state->m_running);
+	m_evo_state->m_running = true;
+	m_evo_state->m_interrupt = false;
+	m_evo_state->m_champion = champion;
+}
+
+// Mark the evolution as completed and wake up the threads waiting in join(). As the island might be destroyed as soon
+// as the flag is reset, the state is accessed via a shared pointer owned by the caller.
+void base_island::stop_evolution(const boost::shared_ptr<evolution_state> &state)
+{
+	boost::lock_guard<boost::mutex> lock(state->m_mutex);
+	state->m_running = false;
+	state->m_interrupt = false;
+	state->m_cond.notify_all();
+}
+
+// Test whether the evolution has been interrupted.
+bool base_island::interrupted() const
+{
+	boost::lock_guard<boost::mutex> lock(m_evo_state->m_mutex);
+	return m_evo_state->m_interrupt;
+}
+
+// Evolver. This is a helper object which performs the iterations of an evolution for a given number of iterations.
+struct base_island::int_evolver {
+	int_evolver(base_island *i, const std::size_t &n):m_i(i),m_state(i->m_evo_state),m_n(n) {}
+	bool step();
+	base_island				*m_i;
+	boost::shared_ptr<evolution_state>	m_state;
+	std::size_t				m_n;
+};
+
+// Perform one iteration. Return true if another one is needed.
+bool base_island::int_evolver::step()
+{
+	return m_i->timed_evolve_once() && --m_n && !m_i->interrupted();
 }
 
 /// Evolve island n times.
@@ -299,6 +452,11 @@ void base_island::int_evolver::operator()()
  * Call the internal algorithm's algorithm::base::evolve() method n times on the internal population, using an island-specific
  * mechanism for the actual execution of the code.
  *
+ * The evolution is performed asynchronously by the process-wide thread pool (util::thread_pool::get_default()), one iteration at a time:
+ * after each iteration, the evolution task is re-enqueued in the pool. Hence any number of islands can be evolved concurrently
+ * on a number of threads matching the hardware concurrency, and all of them will make progress. Islands whose evolution blocks
+ * waiting for external results (see blocking()) run all the iterations on a dedicated thread instead.
+ *
  * During evolution, the island is locked down and no actions on it are possible,
  * but the flow of the rest of the program might continue without waiting for all evolutions to finish. To explicitly block the program until all evolution runs
  * have been performed on the island, call the join() method.
@@ -309,72 +467,32 @@ void base_island::evolve(int n)
 {
 	join();
 	const std::size_t n_evo = boost::numeric_cast<std::size_t>(n);
-	try {
-		m_evo_thread.reset(new boost::thread(int_evolver(this,n_evo)));
-	} catch (...) {
-		pagmo_throw(std::runtime_error,"failed to launch the thread");
+	if (!n_evo) {
+		return;
 	}
+	launch(int_evolver(this,n_evo));
 }
 
-// Time-dependent evolver thread object. This is a callable helper object used to launch an evolution for a specified amount of time.
+// Time-dependent evolver. This is a helper object which performs the iterations of an evolution for a specified amount of time.
 struct base_island::t_evolver {
-	t_evolver(base_island *i, const std::size_t &t):m_i(i),m_t(t) {}
-	void operator()();
-	void juice_impl(boost::posix_time::ptime &);
-	base_island 		*m_i;
-	const std::size_t	m_t;
+	t_evolver(base_island *i, const std::size_t &t):m_i(i),m_state(i->m_evo_state),m_t(t),
+		m_start(boost::posix_time::microsec_clock::local_time()) {}
+	bool step();
+	base_island				*m_i;
+	boost::shared_ptr<evolution_state>	m_state;
+	std::size_t				m_t;
+	boost::posix_time::ptime		m_start;
 };
 
-void base_island::t_evolver::juice_impl(boost::posix_time::ptime &start)
+// Perform one iteration. Return true if another one is needed, i.e., if the specified amount of time has not passed yet.
+bool base_island::t_evolver::step()
 {
-	boost::posix_time::time_duration diff;
-	start = boost::posix_time::microsec_clock::local_time();
-	// Synchronise start.
-	if (m_i->m_archi) {
-		m_i->m_archi->sync_island_start();
-	}
-	const raii_thread_hook hook(m_i);
-	do {
-		if (m_i->m_archi) {
-			m_i->m_archi->pre_evolution(*m_i);
-		}
-		m_i->m_pop.problem().pre_evolution(m_i->m_pop);
-		m_i->perform_evolution(*m_i->m_algo,m_i->m_pop);
-		if (m_i->m_archi) {
-			m_i->m_archi->post_evolution(*m_i);
-		}
-		m_i->m_pop.problem().post_evolution(m_i->m_pop);
-		// Set the interruption point.
-		boost::this_thread::interruption_point();
-		diff = boost::posix_time::microsec_clock::local_time() - start;
-		// Take care of negative timings.
-	} while (diff.total_milliseconds() < 0 || boost::numeric_cast<std::size_t>(diff.total_milliseconds()) < m_t);
-}
-
-// Perform at least one evolution, and continue evolving until at least a certain amount of time has passed.
-void base_island::t_evolver::operator()()
-{
-	boost::posix_time::ptime start;
-	try {
-		juice_impl(start);
-	} catch (const boost::thread_interrupted &) {
-		// In case of interruption, don't do anything special.
-	} catch (const std::exception &e) {
-		std::cout << "Error during island evolution using " << m_i->m_algo->get_name() << ": " << e.what() << std::endl;
-	} catch (...) {
-		std::cout << "Error during island evolution using " << m_i->m_algo->get_name() << ", unknown exception caught. :(" << std::endl;
-	}
-	// Try to compute the evolution time before exiting. In case something goes wrong, do not do anything.
-	try {
-		// We must take care of potentially low-accuracy clocks, where the time difference could be negative for
-		// _really_ short evolution times. In that case do not add anything to the total evolution time.
-		const boost::posix_time::time_duration diff = boost::posix_time::microsec_clock::local_time() - start;
-		if (diff.total_milliseconds() >= 0) {
-			m_i->m_evo_time += boost::numeric_cast<std::size_t>(diff.total_milliseconds());
-		}
-	} catch (...) {
-		std::cout << "Error calculating evolution time.\n";
+	if (!m_i->timed_evolve_once() || m_i->interrupted()) {
+		return false;
 	}
+	const boost::posix_time::time_duration diff = boost::posix_time::microsec_clock::local_time() - m_start;
+	// Take care of negative timings.
+	return diff.total_milliseconds() < 0 || boost::numeric_cast<std::size_t>(diff.total_milliseconds()) < m_t;
 }
 
 /// Evolve island for a specified minimum amount of time.
@@ -382,6 +500,9 @@ void base_island::t_evolver::operator()()
  * Call the internal algorithm's algorithm::base::evolve() method on the population at least once, and keep calling it until at least t milliseconds
  * (in "wall clock" time) have elapsed. Will fail if t is negative.
  *
+ * As in evolve(), the iterations are performed one at a time by the process-wide thread pool. The time is measured from the call to this method,
+ * hence it includes the time spent waiting in the queue of the pool.
+ *
  * During evolution, the island is locked down and no actions on it are possible,
  * but the flow of the rest of the program might continue without waiting for all evolutions to finish. To explicitly block the program until all evolution runs
  * have been performed on the island, call the join() method.
@@ -392,24 +513,78 @@ void base_island::evolve_t(int t)
 {
 	join();
 	const std::size_t t_evo = boost::numeric_cast<std::size_t>(t);
-	try {
-		m_evo_thread.reset(new boost::thread(t_evolver(this,t_evo)));
-	} catch (...) {
-		pagmo_throw(std::runtime_error,"failed to launch the thread");
+	launch(t_evolver(this,t_evo));
+}
+
+// Evaluations-dependent evolver. This is a helper object which performs the iterations of an evolution until a certain number
+// of function evaluations has been performed.
+struct base_island::f_evolver {
+	f_evolver(base_island *i, const std::size_t &n):m_i(i),m_state(i->m_evo_state),m_n(n),m_fevals(0),m_stalled(0) {}
+	bool step();
+	// Maximum number of consecutive iterations without evaluations.
+	static const std::size_t max_stalled = 10;
+	base_island				*m_i;
+	boost::shared_ptr<evolution_state>	m_state;
+	std::size_t				m_n;
+	std::size_t				m_fevals;
+	std::size_t				m_stalled;
+};
+
+const std::size_t base_island::f_evolver::max_stalled;
+
+// Perform one iteration. Return true if another one is needed, i.e., if less than a certain number of function evaluations has been performed
+// and not too many consecutive iterations have been performed without any evaluation.
+bool base_island::f_evolver::step()
+{
+	const unsigned int start = m_i->m_pop.problem().get_fevals();
+	if (!m_i->timed_evolve_once() || m_i->interrupted()) {
+		return false;
 	}
+	// NOTE: unsigned arithmetic takes care of the wrapping of the counter.
+	const unsigned int fevals = m_i->m_pop.problem().get_fevals() - start;
+	m_fevals += fevals;
+	m_stalled = fevals ? 0 : m_stalled + 1;
+	return m_stalled < max_stalled && m_fevals < m_n;
+}
+
+/// Evolve island for a specified minimum number of function evaluations.
+/**
+ * Call the internal algorithm's algorithm::base::evolve() method on the population at least once, and keep calling it until at least n
+ * objective function evaluations have been performed on the problem of the island (as counted by problem::base::get_fevals(), hence
+ * including the evaluations of the immigrants). Will fail if n is negative.
+ *
+ * The evaluations performed on copies of the problem are reported to the problem of the island when the evolution returns: pagmo::mpi_island and
+ * pagmo::process_island add the evaluations performed by their workers, and algorithms evaluating copies of the problem (e.g., algorithm::cmaes_restart)
+ * add those evaluations via problem::base::add_fevals(). The evolution stops also after 10 consecutive iterations which do not
+ * increase the counter, e.g., because the algorithm does not evaluate the objective function, or because the population has converged and all the
+ * evaluations are served by the cache of the problem.
+ *
+ * Like evolve_t(), this method is meant to run archipelagos asynchronously, giving a budget to each island rather than a number of
+ * iterations, so that fast islands are not held back by slow ones.
+ *
+ * @param[in] n minimum number of function evaluations.
+ */
+void base_island::evolve_fevals(int n)
+{
+	join();
+	const std::size_t n_evo = boost::numeric_cast<std::size_t>(n);
+	launch(f_evolver(this,n_evo));
 }
 
 /// Interrupt evolution.
 /**
- * If an evolution is undergoing, the evolution will be stopped the first time the flow reaches one of the internal interruption points.
- * The method will block until the interruption point has been reached.
+ * If an evolution is undergoing, the evolution will be stopped at the end of the current iteration.
+ * The method will block until the iteration has been completed.
  */
 void base_island::interrupt()
 {
-	if (m_evo_thread) {
-		m_evo_thread->interrupt();
-		join();
+	{
+		boost::lock_guard<boost::mutex> lock(m_evo_state->m_mutex);
+		if (m_evo_state->m_running) {
+			m_evo_state->m_interrupt = true;
+		}
 	}
+	join();
 }
 
 /// Query the status of the island.
@@ -418,10 +593,30 @@ void base_island::interrupt()
  */
 bool base_island::busy() const
 {
-	if (!m_evo_thread) {
-		return false;
+	boost::lock_guard<boost::mutex> lock(m_evo_state->m_mutex);
+	return m_evo_state->m_running;
+}
+
+/// Get the champion of the island.
+/**
+ * Unlike the other getters, this method does not wait for an ongoing evolution to terminate: in such case, the champion
+ * at the end of the last completed iteration (or at the beginning of the evolution) is returned.
+ *
+ * @return a copy of the champion of the population.
+ *
+ * @throws pagmo::value_error if the champion has not been determined yet.
+ */
+population::champion_type base_island::get_champion() const
+{
+	boost::lock_guard<boost::mutex> lock(m_evo_state->m_mutex);
+	if (!m_evo_state->m_running) {
+		// NOTE: evolutions cannot start while the lock is held, hence the population can be accessed safely.
+		return m_pop.champion();
+	}
+	if (!m_evo_state->m_champion.x.size()) {
+		pagmo_throw(value_error,"champion has not been determined yet");
 	}
-	return (!m_evo_thread->timed_join(boost::posix_time::milliseconds(1)));
+	return m_evo_state->m_champion;
 }
 
 /// Return the total evolution time in milliseconds.
@@ -579,6 +774,7 @@ std::vector<std::pair<population::size_type, archipelago::size_type> > base_isla
 		m_pop.m_container[(*rep_it).first] = immigrants[(*rep_it).second];
 		m_pop.update_champion((*rep_it).first);
 		m_pop.update_dom((*rep_it).first);
+		m_pop.update_extrema((*rep_it).first);
 		std::pair<population::size_type, archipelago::size_type> pair = std::make_pair(1.0, immigrant_pairs[(*rep_it).second].first);
 		std::vector<std::pair<population::size_type, archipelago::size_type> >::iterator where;
 		where = std::find_if(retval.begin(), retval.end(), unary_predicate(pair));
@@ -53,7 +53,7 @@ typedef boost::shared_ptr<base_island> base_island_ptr;
 
 /// Base island class.
 /**
- * This class incorporates a pagmo::population and a pagmo::algorithm::base used to evolve the population. Each time the evolve() (or evolve_t()) method is called,
+ * This class incorporates a pagmo::population and a pagmo::algorithm::base used to evolve the population. Each time the evolve() (or evolve_t(), or evolve_fevals()) method is called,
  * a derived island class will execute the algorithm's evolve method on the population. The actual mechanism of launching the evolve method is defined in the
  * derived class - see \ref evolution_details "below" for more details. While evolution is undergoing, the island is locked down and no further operations will be allowed. The method join() can be used to wait until
  * evolution on the island has terminated. The busy() methods can be used to query the state of the island.
@@ -72,8 +72,16 @@ typedef boost::shared_ptr<base_island> base_island_ptr;
  *
  * \section evolution_details Implementation of the evolution methods
  *
- * When one of the evolution methods (evolve() or evolve_t()) is launched,
- * a local thread is opened and the perform_evolution() method is called from the new thread using as arguments the population and the algorithm stored in the island.
+ * When one of the evolution methods (evolve(), evolve_t() or evolve_fevals()) is launched, an evolution task is submitted to the process-wide
+ * thread pool (util::thread_pool::get_default()). The task calls the perform_evolution() method from one of the worker threads of the pool,
+ * using as arguments the population and the algorithm stored in the island, and then re-enqueues itself until the evolution is completed.
+ * Hence islands do not own threads, and the number of islands which can be evolved concurrently is not bound to the number of threads.
+ * Islands which offload the evolution elsewhere (e.g., pagmo::mpi_island) declare it by reimplementing blocking(): each of their evolutions runs all
+ * its iterations on a dedicated thread owned by the island, as it would otherwise keep the workers of the pool waiting. Islands can be evolved and joined from within the evolution
+ * of another island (e.g., by algorithm::pade): join() keeps the calling worker busy with the pending tasks of the pool.
+ *
+ * The champion of an island can be queried while the island is evolving with get_champion(), which does not wait for the evolution to terminate:
+ * after each iteration, the evolution task publishes a snapshot of the champion of the population.
  *
  * @author Francesco Biscani (bluescarni@gmail.com)
  * @author Marek Ruciński (marek.rucinski@gmail.com)
@@ -120,11 +128,14 @@ class __PAGMO_VISIBLE base_island
 		bool busy() const;
 		void evolve(int = 1);
 		void evolve_t(int);
+		void evolve_fevals(int);
 		void interrupt();
 		std::size_t get_evolution_time() const;
+		population::champion_type get_champion() const;
 	protected:
 		/// Method that implements the evolution of the population.
 		virtual void perform_evolution(const algorithm::base &, population &) const = 0;
+		virtual bool blocking() const;
 		virtual void thread_entry();
 		virtual void thread_exit();
 		//@}
@@ -147,13 +158,28 @@ class __PAGMO_VISIBLE base_island
 		// but this creates problems as at this point archipelago::siz_type is not defined and cannot be!!!
 		std::vector<std::pair<population::size_type, population::size_type> > accept_immigrants(std::vector<std::pair<population::size_type, population::individual_type> > &);
 		std::vector<population::individual_type> get_emigrants();
-		// Evolver thread object. This is a callable helper object used to launch an evolution for a given number of iterations.
+		// Evolution state shared with the evolution tasks.
+		struct evolution_state;
+		// Evolver. This is a helper object used to perform an evolution for a given number of iterations.
 		struct int_evolver;
-		// Time-dependent evolver thread object. This is a callable helper object used to launch an evolution for a specified amount of time.
+		// Time-dependent evolver. This is a helper object used to perform an evolution for a specified amount of time.
 		struct t_evolver;
+		// Evaluations-dependent evolver. This is a helper object used to perform an evolution for a specified number of function evaluations.
+		struct f_evolver;
+		// Task running the iterations of an evolver, on the thread pool or on the dedicated thread of a blocking island.
+		template <class Evolver>
+		struct evolution_task;
 		// RAII threads hook object.
 		struct raii_thread_hook;
 		friend struct raii_thread_hook;
+		void evolve_once();
+		bool timed_evolve_once();
+		template <class Evolver>
+		void launch(const Evolver &);
+		void publish_champion();
+		void start_evolution();
+		static void stop_evolution(const boost::shared_ptr<evolution_state> &);
+		bool interrupted() const;
 	protected:
 		/// Algorithm.
 		algorithm::base_ptr			m_algo;
@@ -167,9 +193,11 @@ class __PAGMO_VISIBLE base_island
 		migration::base_s_policy_ptr		m_s_policy;
 		/// Migration replacement policy.
 		migration::base_r_policy_ptr		m_r_policy;
-		/// Evolution thread.
-		boost::scoped_ptr<boost::thread>	m_evo_thread;
 	private:
+		// Evolution state.
+		boost::shared_ptr<evolution_state>	m_evo_state;
+		// Dedicated thread running the evolution of a blocking island (joined, and reset, by join()).
+		mutable boost::scoped_ptr<boost::thread>	m_evo_thread;
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int version)
@@ -190,9 +218,8 @@ class __PAGMO_VISIBLE base_island
 		template <class Archive>
 		void load(Archive &, const unsigned int)
 		{
-			// Upon loading we are going to set the archi pointer and the evo thread to 0.
+			// Upon loading we are going to set the archi pointer to 0.
 			m_archi = 0;
-			m_evo_thread.reset(0);
 		}
 };
 
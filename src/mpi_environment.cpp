@@ -22,47 +22,265 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/numeric/conversion/cast.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstddef>
 #include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <map>
 #include <mpi.h>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "exceptions.h"
 #include "algorithm/base.h"
 #include "population.h"
 #include "mpi_environment.h"
+#include "util/thread_pool.h"
 
 namespace pagmo
 {
 
+// Progress engine of the root process. A single thread owns all the MPI communications of the root process after initialisation:
+// islands submit their request-reply exchanges to a queue and block until the engine has completed them. The engine posts the
+// transfers of all the exchanges with non-blocking calls and tests them for completion together, so that the transfers of
+// different islands overlap and each island is woken up as soon as its reply has arrived.
+// NOTE: MPI_Waitany cannot be used here, as it would not return when a new exchange is submitted while all the pending ones
+// are waiting for long evolutions. The engine tests the pending transfers with MPI_Testsome instead, backing off exponentially
+// (up to max_backoff) while nothing happens, and it is woken up immediately by new submissions.
+struct mpi_environment::progress_engine
+{
+	// State of a request-reply exchange with a worker. The messages follow the protocol of send_buffer() and recv_buffer():
+	// the size of the payload with tag 0 (or reply_tag, for the reply), followed by the payload with the next tag.
+	struct exchange_state
+	{
+		exchange_state(const std::string &request, int processor, int reply_tag):m_processor(processor),m_reply_tag(reply_tag),
+			m_request_size(boost::numeric_cast<int>(request.size())),m_request(request.begin(),request.end()),
+			m_reply_size(0),m_pending_sends(0),m_received(false),m_done(false)
+		{
+			// Make sure the buffer is never empty, so that its first element can always be addressed.
+			m_request.push_back(0);
+		}
+		const int		m_processor;
+		const int		m_reply_tag;
+		int			m_request_size;
+		std::vector<char>	m_request;
+		int			m_reply_size;
+		std::vector<char>	m_reply;
+		int			m_pending_sends;
+		bool			m_received;
+		// Completion flag, protected by the mutex of the engine.
+		bool			m_done;
+		boost::condition_variable	m_cond;
+	};
+	// Kinds of MPI transfers.
+	enum transfer_kind {send_transfer, recv_size_transfer, recv_payload_transfer};
+	// An MPI transfer in progress, belonging to an exchange.
+	struct transfer
+	{
+		transfer(exchange_state *e, transfer_kind k):m_exchange(e),m_kind(k) {}
+		exchange_state	*m_exchange;
+		transfer_kind	m_kind;
+	};
+	// Maximum time between two tests of the pending transfers.
+	static const long max_backoff = 1000;
+	progress_engine():m_stop(false),m_thread(boost::bind(&progress_engine::run,this)) {}
+	~progress_engine()
+	{
+		{
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_cond.notify_all();
+		m_thread.join();
+	}
+	void submit(exchange_state &e)
+	{
+		boost::unique_lock<boost::mutex> lock(m_mutex);
+		m_queue.push_back(&e);
+		m_cond.notify_all();
+		while (!e.m_done) {
+			e.m_cond.wait(lock);
+		}
+	}
+	// Post a non-blocking transfer.
+	void post(exchange_state *e, transfer_kind k)
+	{
+		MPI_Request request;
+		switch (k) {
+			case send_transfer:
+				MPI_Isend(static_cast<void *>(&e->m_request_size),1,MPI_INT,e->m_processor,0,MPI_COMM_WORLD,&request);
+				m_requests.push_back(request);
+				m_transfers.push_back(transfer(e,k));
+				MPI_Isend(static_cast<void *>(&e->m_request[0]),e->m_request_size,MPI_CHAR,e->m_processor,1,MPI_COMM_WORLD,&request);
+				e->m_pending_sends += 2;
+				break;
+			case recv_size_transfer:
+				MPI_Irecv(static_cast<void *>(&e->m_reply_size),1,MPI_INT,e->m_processor,e->m_reply_tag,MPI_COMM_WORLD,&request);
+				break;
+			case recv_payload_transfer:
+				MPI_Irecv(static_cast<void *>(&e->m_reply[0]),e->m_reply_size,MPI_CHAR,e->m_processor,e->m_reply_tag + 1,MPI_COMM_WORLD,&request);
+		}
+		m_requests.push_back(request);
+		m_transfers.push_back(transfer(e,k));
+	}
+	// Process a completed transfer. Return the exchange if it has been completed, null otherwise.
+	exchange_state *complete(const transfer &t)
+	{
+		exchange_state *e = t.m_exchange;
+		switch (t.m_kind) {
+			case send_transfer:
+				--e->m_pending_sends;
+				break;
+			case recv_size_transfer:
+				e->m_reply.resize(boost::numeric_cast<std::vector<char>::size_type>(e->m_reply_size) + 1u);
+				post(e,recv_payload_transfer);
+				break;
+			case recv_payload_transfer:
+				e->m_received = true;
+		}
+		return (e->m_received && !e->m_pending_sends) ? e : 0;
+	}
+	void run()
+	{
+		long backoff = 0;
+		while (true) {
+			std::deque<exchange_state *> queue;
+			{
+				boost::unique_lock<boost::mutex> lock(m_mutex);
+				if (m_requests.empty()) {
+					// Nothing in flight: sleep until something is submitted.
+					while (!m_stop && m_queue.empty()) {
+						m_cond.wait(lock);
+					}
+					if (m_queue.empty()) {
+						pagmo_assert(m_stop);
+						return;
+					}
+				} else if (m_queue.empty() && backoff) {
+					m_cond.timed_wait(lock,boost::posix_time::microseconds(backoff));
+				}
+				queue.swap(m_queue);
+			}
+			for (std::deque<exchange_state *>::iterator it = queue.begin(); it != queue.end(); ++it) {
+				post(*it,send_transfer);
+				post(*it,recv_size_transfer);
+			}
+			// Test all the transfers in flight.
+			int n_completed = 0;
+			std::vector<int> indices(m_requests.size());
+			std::vector<MPI_Status> statuses(m_requests.size());
+			MPI_Testsome(boost::numeric_cast<int>(m_requests.size()),&m_requests[0],&n_completed,&indices[0],&statuses[0]);
+			if (n_completed == MPI_UNDEFINED || !n_completed) {
+				backoff = queue.empty() ? std::min<long>(max_backoff,backoff ? 2 * backoff : 1) : 0;
+				continue;
+			}
+			backoff = 0;
+			std::vector<exchange_state *> done;
+			// NOTE: new transfers are appended to m_transfers by complete(), hence the indices of the completed ones stay valid.
+			for (int i = 0; i < n_completed; ++i) {
+				exchange_state *e = complete(m_transfers[static_cast<std::size_t>(indices[static_cast<std::size_t>(i)])]);
+				if (e) {
+					done.push_back(e);
+				}
+			}
+			// Remove the completed transfers, which have been set to MPI_REQUEST_NULL by MPI_Testsome.
+			std::size_t j = 0;
+			for (std::size_t i = 0; i < m_requests.size(); ++i) {
+				if (m_requests[i] != MPI_REQUEST_NULL) {
+					m_requests[j] = m_requests[i];
+					m_transfers[j] = m_transfers[i];
+					++j;
+				}
+			}
+			m_requests.resize(j);
+			m_transfers.erase(m_transfers.begin() + static_cast<std::vector<transfer>::difference_type>(j),m_transfers.end());
+			// Wake up the islands whose exchanges have been completed.
+			if (!done.empty()) {
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				for (std::vector<exchange_state *>::iterator it = done.begin(); it != done.end(); ++it) {
+					(*it)->m_done = true;
+					(*it)->m_cond.notify_all();
+				}
+			}
+		}
+	}
+	boost::mutex			m_mutex;
+	boost::condition_variable	m_cond;
+	// Exchanges submitted and not yet posted.
+	std::deque<exchange_state *>	m_queue;
+	bool				m_stop;
+	// Transfers in flight, and the corresponding MPI requests. They are accessed only by the engine thread.
+	std::vector<MPI_Request>	m_requests;
+	std::vector<transfer>		m_transfers;
+	boost::thread			m_thread;
+};
+
+const long mpi_environment::progress_engine::max_backoff;
+
 bool mpi_environment::m_initialised = false;
 bool mpi_environment::m_multithread = false;
+int mpi_environment::m_size = 0;
+int mpi_environment::m_rank = 0;
+std::vector<int> mpi_environment::m_capacities;
+mpi_environment::archive_format mpi_environment::m_archive_format = mpi_environment::binary_format;
+boost::scoped_ptr<mpi_environment::progress_engine> mpi_environment::m_engine;
 
-/// Default constructor.
+/// Constructor from number of threads.
 /**
  * Initialises the MPI environment with MPI_Init_thread. pagmo::mpi_environment objects should be created only in the main
  * thread of execution.
+ *
+ * Each process with nonzero rank will run up to n_threads evolutions concurrently, each one in its own thread. If n_threads is zero,
+ * the number of threads of each process will be set to the value returned by boost::thread::hardware_concurrency() on its node.
+ * The argument is ignored by the root process, which does not run any evolution.
+ * 
+ * @param[in] n_threads number of concurrent evolutions on each process with nonzero rank.
  * 
  * @throws std::runtime_error if another instance of this class has already been created,
  * or if the MPI implementation does not support at least the MPI_THREAD_SERIALIZED thread level and this is the root node,
  * or if the world size is not at least 2.
+ * @throws value_error if n_threads is too large to be represented by MPI tags.
  */
-mpi_environment::mpi_environment()
+mpi_environment::mpi_environment(unsigned int n_threads)
 {
 	if (m_initialised) {
 		pagmo_throw(std::runtime_error,"cannot re-initialise the MPI environment");
 	}
+	// NOTE: each slot needs two tags, and MPI guarantees at least 32767 tags.
+	if (n_threads > 16382u) {
+		pagmo_throw(value_error,"too many threads per process");
+	}
 	m_initialised = true;
 	int thread_level_provided;
 	MPI_Init_thread(NULL,NULL,MPI_THREAD_MULTIPLE,&thread_level_provided);
 	if (thread_level_provided >= MPI_THREAD_MULTIPLE) {
 		m_multithread = true;
 	}
+	MPI_Comm_size(MPI_COMM_WORLD,&m_size);
+	MPI_Comm_rank(MPI_COMM_WORLD,&m_rank);
+	if (!n_threads) {
+		n_threads = std::min<unsigned int>(std::max<unsigned int>(boost::thread::hardware_concurrency(),1u),16382u);
+	}
+	// Advertise the capacity of the workers to the root process.
+	int capacity = get_rank() ? static_cast<int>(n_threads) : 0;
+	m_capacities.resize(boost::numeric_cast<std::vector<int>::size_type>(get_size()));
+	MPI_Gather(static_cast<void *>(&capacity),1,MPI_INT,static_cast<void *>(&m_capacities[0]),1,MPI_INT,0,MPI_COMM_WORLD);
 	if (get_rank()) {
 		// If this is a slave, it will have to stop here, listen for jobs, execute them, and exit()
 		// when signalled to do so.
-		listen();
+		listen(n_threads);
 	}
 	// If this is the root node, it will need to be able to call MPI from multiple threads.
 	if (thread_level_provided < MPI_THREAD_SERIALIZED && get_rank() == 0) {
@@ -72,21 +290,24 @@ mpi_environment::mpi_environment()
 	if (get_size() < 2) {
 		pagmo_throw(std::runtime_error,"the size of the MPI world must be at least 2");
 	}
+	// From now on, the communications of the root node are performed by the progress engine.
+	m_engine.reset(new progress_engine());
 }
 
 /// Destructor.
 /**
- * Will send a shutdown signal to all processes with nonzero rank and call MPI_Finalize().
+ * Will wait for the pending communications to be completed, send a shutdown signal to all processes with nonzero rank and call MPI_Finalize().
  */
 mpi_environment::~mpi_environment()
 {
 	// In theory this should never be called by the slaves.
 	pagmo_assert(!get_rank());
 	pagmo_assert(m_initialised);
-	std::pair<boost::shared_ptr<population>,algorithm::base_ptr> shutdown_payload;
+	m_engine.reset();
+	const request_header shutdown_header;
 	for (int i = 1; i < get_size(); ++i) {
 		// Send the shutdown signal to all slaves.
-		send(shutdown_payload,i);
+		send(shutdown_header,i);
 	}
 	MPI_Finalize();
 	m_initialised = false;
@@ -99,9 +320,128 @@ void mpi_environment::check_init()
 	}
 }
 
-/// Probe for message.
+/// Get the serialization format of the MPI payloads.
+/**
+ * @return the format used to encode the payloads sent by this process.
+ */
+mpi_environment::archive_format mpi_environment::get_archive_format()
+{
+	return m_archive_format;
+}
+
+/// Set the serialization format of the MPI payloads.
 /**
+ * The format is used for the payloads sent by this process. The workers reply in the format of the requests they receive,
+ * hence the format needs to be set only on the root node. This method is not thread-safe, and it should be called
+ * before starting any evolution.
+ *
+ * @param[in] format format of the payloads.
+ *
+ * @throws pagmo::value_error if format is not a valid format.
+ */
+void mpi_environment::set_archive_format(archive_format format)
+{
+	if (format != text_format && format != binary_format) {
+		pagmo_throw(value_error,"invalid archive format");
+	}
+	m_archive_format = format;
+}
+
+/// Get the serialization format of a payload.
+/**
+ * @param[in] buffer payload received from another process.
+ *
+ * @return the format of the payload, as encoded in its first byte.
+ *
+ * @throws pagmo::value_error if the payload does not start with a valid format byte.
+ */
+mpi_environment::archive_format mpi_environment::get_payload_format(const std::string &buffer)
+{
+	if (buffer.empty() || (buffer[0] != static_cast<char>(text_format) && buffer[0] != static_cast<char>(binary_format))) {
+		pagmo_throw(value_error,"invalid payload format");
+	}
+	return static_cast<archive_format>(buffer[0]);
+}
+
+/// Receive raw MPI payload.
+/**
+ * Receive a buffer of bytes sent with send_buffer() from the processor with ID source.
  * This method is thread-safe only if mpi_environment::is_multithread returns true.
+ *
+ * @param[out] retval string that will contain the payload.
+ * @param[in] source rank of the processor from which the message will be received.
+ * @param[in] tag tag of the size of the payload, which is followed by the payload itself on the next tag.
+ *
+ * @throws std::runtime_error if the MPI environment has not been initialised.
+ */
+void mpi_environment::recv_buffer(std::string &retval, int source, int tag)
+{
+	check_init();
+	MPI_Status status;
+	// First receive the size.
+	int size;
+	MPI_Recv(static_cast<void *>(&size),1,MPI_INT,source,tag,MPI_COMM_WORLD,&status);
+	// Prepare the vector of chars.
+	std::vector<char> buffer_char(boost::numeric_cast<std::vector<char>::size_type>(size) + 1u,0);
+	// Receive the payload.
+	MPI_Recv(static_cast<void *>(&buffer_char[0]),size,MPI_CHAR,source,tag + 1,MPI_COMM_WORLD,&status);
+	retval.assign(buffer_char.begin(),buffer_char.end() - 1);
+}
+
+/// Send raw MPI payload.
+/**
+ * Send a buffer of bytes to the processor with ID destination.
+ * This method is thread-safe only if mpi_environment::is_multithread returns true.
+ *
+ * @param[in] buffer payload that will be sent to destination.
+ * @param[in] destination rank of the processor to which the message will be sent.
+ * @param[in] tag tag of the size of the payload, which is followed by the payload itself on the next tag.
+ *
+ * @throws std::runtime_error if the MPI environment has not been initialised.
+ */
+void mpi_environment::send_buffer(const std::string &buffer, int destination, int tag)
+{
+	check_init();
+	std::vector<char> buffer_char(buffer.begin(),buffer.end());
+	buffer_char.push_back(0);
+	// Send the size.
+	int size = boost::numeric_cast<int>(buffer.size());
+	MPI_Send(static_cast<void *>(&size),1,MPI_INT,destination,tag,MPI_COMM_WORLD);
+	// Send the string.
+	MPI_Send(static_cast<void *>(&buffer_char[0]),size,MPI_CHAR,destination,tag + 1,MPI_COMM_WORLD);
+}
+
+/// Exchange MPI payloads with a worker.
+/**
+ * Send a buffer of bytes to the processor with ID processor, as send_buffer() does, and wait for the reply of the processor
+ * to the request occupying the given slot. The communication is performed by the progress thread of the root process,
+ * which overlaps the exchanges requested concurrently by different threads. Concurrent exchanges with the same processor
+ * must occupy different slots.
+ * This method is thread-safe, and it can be called only on the root process.
+ *
+ * @param[in] request payload that will be sent to processor.
+ * @param[out] reply string that will contain the reply of processor.
+ * @param[in] processor rank of the worker.
+ * @param[in] slot slot of the worker occupied by the request.
+ *
+ * @throws std::runtime_error if the MPI environment has not been initialised or if this is not the root process.
+ * @throws boost::numeric::bad_numeric_cast if the size of request does not fit into an int.
+ */
+void mpi_environment::exchange(const std::string &request, std::string &reply, int processor, int slot)
+{
+	check_init();
+	if (!m_engine) {
+		pagmo_throw(std::runtime_error,"MPI exchanges can be requested only by the root process");
+	}
+	progress_engine::exchange_state e(request,processor,reply_tag(slot));
+	m_engine->submit(e);
+	reply.assign(e.m_reply.begin(),e.m_reply.end() - 1);
+}
+
+/// Probe for message.
+/**
+ * This method is thread-safe only if mpi_environment::is_multithread returns true. On the root process,
+ * it must not be called while the progress thread is running.
  * 
  * @param[in] source rank of the processor that will be probed.
  * 
@@ -120,7 +460,7 @@ bool mpi_environment::iprobe(int source)
 
 /// MPI world size.
 /**
- * This method is thread-safe only if mpi_environment::is_multithread returns true.
+ * This method is always thread-safe, the value being cached at initialisation.
  * 
  * @return the MPI world size.
  * 
@@ -129,14 +469,12 @@ bool mpi_environment::iprobe(int source)
 int mpi_environment::get_size()
 {
 	check_init();
-	int retval;
-	MPI_Comm_size(MPI_COMM_WORLD,&retval);
-	return retval;
+	return m_size;
 }
 
 /// MPI rank.
 /**
- * This method is thread-safe only if mpi_environment::is_multithread returns true.
+ * This method is always thread-safe, the value being cached at initialisation.
  * 
  * @return the MPI rank of the process.
  * 
@@ -145,9 +483,35 @@ int mpi_environment::get_size()
 int mpi_environment::get_rank()
 {
 	check_init();
-	int retval;
-	MPI_Comm_rank(MPI_COMM_WORLD,&retval);
-	return retval;
+	return m_rank;
+}
+
+/// Capacity of a process.
+/**
+ * This method is always thread-safe, the value being advertised by the processes at initialisation. It is meaningful
+ * only on the root process.
+ *
+ * @param[in] n rank of the process.
+ *
+ * @return the number of evolutions that the process with rank n can run concurrently.
+ *
+ * @throws std::runtime_error if the MPI environment has not been initialised.
+ * @throws value_error if n is not the rank of a process with nonzero rank.
+ */
+int mpi_environment::get_capacity(int n)
+{
+	check_init();
+	if (n <= 0 || n >= m_size) {
+		pagmo_throw(value_error,"invalid process rank");
+	}
+	return m_capacities[static_cast<std::vector<int>::size_type>(n)];
+}
+
+// Tag of the size of the replies sent to the requests occupying the given slot of a worker. The payload of the reply is sent
+// on the following tag, while requests are always sent on the tags 0 and 1.
+int mpi_environment::reply_tag(int slot)
+{
+	return 2 + 2 * slot;
 }
 
 /// Thread-safety of the MPI implementation.
@@ -165,41 +529,292 @@ bool mpi_environment::is_multithread()
 	return m_multithread;
 }
 
-void mpi_environment::listen()
+// Session opened by the root process on a worker, holding the population and the algorithm of an island.
+struct worker_session
 {
-	std::pair<boost::shared_ptr<population>,algorithm::base_ptr> payload;
-	while (true) {
-		// Receive the payload from the master.
-		recv(payload,0);
-		// If the payload is empty, it is the shutdown payload.
-		if (payload.first.get() == 0) {
-			pagmo_assert(payload.second.get() == 0);
-			break;
+	boost::shared_ptr<population>	m_pop;
+	algorithm::base_ptr		m_algo;
+};
+
+// Open session, with the sequence number of the last request received for it.
+typedef std::map<unsigned long,std::pair<boost::shared_ptr<worker_session>,unsigned long> > session_map;
+
+// Sessions of a worker, shared by its evolution threads.
+// The requests are resolved to their sessions by the main thread of the worker, in the order in which they are received, and
+// the evolution threads work on the resolved sessions. Hence sessions closed while being evolved stay alive until the end of the evolution.
+// NOTE: the root process never sends concurrent requests for the same session, hence the mutex needs to protect only the maps,
+// and not the contents of the sessions.
+struct session_store
+{
+	// Close the session id after its request with sequence number seq has been received.
+	void drop(unsigned long id, unsigned long seq)
+	{
+		const session_map::iterator it = m_sessions.find(id);
+		if (it != m_sessions.end() && it->second.second >= seq) {
+			// If a later request has been received, it re-bound the session after it was dropped: keep it.
+			if (it->second.second == seq) {
+				m_sessions.erase(it);
+			}
+			return;
 		}
+		// The request has not been received yet (or it has been received, but it failed and the session is closed already).
+		unsigned long &pending = m_drops[id];
+		pending = std::max(pending,seq);
+	}
+	// Resolve the session of a bind or evolve request, returning null if the session is unknown.
+	boost::shared_ptr<worker_session> resolve(const mpi_environment::request_header &header)
+	{
+		boost::shared_ptr<worker_session> retval;
+		if (header.m_kind == mpi_environment::bind_request) {
+			// Replace the session, if already open.
+			retval.reset(new worker_session());
+			m_sessions[header.m_session] = std::make_pair(retval,header.m_seq);
+		} else {
+			const session_map::iterator it = m_sessions.find(header.m_session);
+			if (it != m_sessions.end()) {
+				retval = it->second.first;
+				it->second.second = header.m_seq;
+			}
+		}
+		// Apply the pending drop of the session, if it was waiting for this request.
+		const std::map<unsigned long,unsigned long>::iterator it = m_drops.find(header.m_session);
+		if (it != m_drops.end() && it->second <= header.m_seq) {
+			if (it->second == header.m_seq) {
+				m_sessions.erase(header.m_session);
+			}
+			m_drops.erase(it);
+		}
+		return retval;
+	}
+	// Close the session id, if it is still open as s.
+	void close(unsigned long id, const boost::shared_ptr<worker_session> &s)
+	{
+		const session_map::iterator it = m_sessions.find(id);
+		if (it != m_sessions.end() && it->second.first == s) {
+			m_sessions.erase(it);
+		}
+	}
+	session_map				m_sessions;
+	// Drops whose request has not been received yet, as the sequence numbers of the requests indexed by session.
+	std::map<unsigned long,unsigned long>	m_drops;
+	boost::mutex				m_mutex;
+};
+
+// Replies produced by the evolution threads of a worker, waiting to be sent to the root process by the main thread of the worker.
+struct reply_queue
+{
+	std::deque<std::pair<int,std::string> >	m_replies;
+	boost::mutex				m_mutex;
+	boost::condition_variable		m_cond;
+};
+
+// Write into oss the reply to a request, encoded in the given format: a flag signalling success, followed (in case of success)
+// by the number of function evaluations performed and by the state of the evolved population pop.
+template <class OArchive>
+static void write_reply(std::ostringstream &oss, char format, population *pop, unsigned int fevals)
+{
+	oss.str("");
+	oss.put(format);
+	OArchive oa(oss,boost::archive::no_header);
+	const bool ok = (pop != 0);
+	oa << ok;
+	if (ok) {
+		oa << fevals;
+		population::state_proxy proxy(*pop);
+		oa << proxy;
+	}
+}
+
+// Read the header of a request encoded with the archive type IArchive.
+template <class IArchive>
+static void read_header(const std::string &request, mpi_environment::request_header &header)
+{
+	std::istringstream iss(request,std::ios_base::in | std::ios_base::binary);
+	// Skip the format byte.
+	iss.ignore(1);
+	IArchive ia(iss,boost::archive::no_header);
+	ia >> header;
+}
 
-		// Create copy of data received
-		const boost::shared_ptr<population> pop_copy(new population(*payload.first));
+// Serve a bind or evolve request encoded with the archive types IArchive/OArchive on its session s (null if the session is unknown),
+// writing the reply into reply.
+template <class IArchive, class OArchive>
+static void serve_request(const std::string &request, std::string &reply, const boost::shared_ptr<worker_session> &s, session_store &store)
+{
+	std::istringstream iss(request,std::ios_base::in | std::ios_base::binary);
+	// Skip the format byte: the reply will use the same format.
+	iss.ignore(1);
+	IArchive ia(iss,boost::archive::no_header);
+	mpi_environment::request_header header;
+	ia >> header;
+	// Load the payload into the session.
+	boost::shared_ptr<population> pop;
+	algorithm::base_ptr algo;
+	try {
+		if (!s) {
+			pagmo_throw(std::runtime_error,"unknown session");
+		}
+		if (header.m_kind == mpi_environment::bind_request) {
+			population *new_pop = 0;
+			ia >> new_pop;
+			s->m_pop.reset(new_pop);
+			algorithm::base *new_algo = 0;
+			ia >> new_algo;
+			s->m_algo.reset(new_algo);
+		} else if (s->m_pop) {
+			population::state_proxy proxy(*s->m_pop);
+			ia >> proxy;
+		}
+		if (!s->m_pop || !s->m_algo) {
+			pagmo_throw(std::runtime_error,"the session has not been bound");
+		}
+		pop = s->m_pop;
+		algo = s->m_algo;
+	} catch (const std::exception &e) {
+		std::cout << "MPI Recv Error on remote session " << header.m_session << ": " << e.what() << std::endl;
+		pop.reset();
+		if (s) {
+			s->m_pop.reset();
+			s->m_algo.reset();
+			boost::lock_guard<boost::mutex> lock(store.m_mutex);
+			store.close(header.m_session,s);
+		}
+	}
+	unsigned int fevals = 0;
+	if (pop) {
+		const unsigned int start = pop->problem().get_fevals();
 		try {
 			// Perform the evolution.
-			payload.second->evolve(*payload.first);
+			algo->evolve(*pop);
 		} catch (const std::exception &e) {
-			std::cout << "MPI Remote Error during island evolution using " << payload.second->get_name() << ": " << e.what() << std::endl;
+			std::cout << "MPI Remote Error during island evolution using " << algo->get_name() << ": " << e.what() << std::endl;
 		} catch (...) {
-			std::cout << "MPI Remote Error during island evolution using " << payload.second->get_name() << ", unknown exception caught. :(" << std::endl;
+			std::cout << "MPI Remote Error during island evolution using " << algo->get_name() << ", unknown exception caught. :(" << std::endl;
 		}
+		// NOTE: unsigned arithmetic takes care of the wrapping of the counter.
+		fevals = pop->problem().get_fevals() - start;
+	}
+	// Reply with the state of the evolved population. If it cannot be serialized, close the session and signal the failure
+	// to the master, which will keep its own copy of the population.
+	std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
+	try {
+		write_reply<OArchive>(oss,request[0],pop.get(),fevals);
+	} catch (const std::exception &e) {
+		std::cout << "MPI Send Error on remote session " << header.m_session << ": " << e.what() << std::endl;
+		{
+			boost::lock_guard<boost::mutex> lock(store.m_mutex);
+			store.close(header.m_session,s);
+		}
+		write_reply<OArchive>(oss,request[0],0,0);
+	}
+	reply = oss.str();
+}
 
-		try {                
-			// Send back to the master the evolved population.
-			send(payload.first,0);
-		} catch (const boost::archive::archive_exception &e) {
-			std::cout << "MPI Send Error during island evolution using " << payload.second->get_name() << ": " << e.what() << std::endl;
-			// Send back to the master the original population.
-			send(pop_copy,0);
-		} catch (...) {
-			std::cout << "MPI Send Error during island evolution using " << payload.second->get_name() << ", unknown exception caught. :(" << std::endl;
-			// Send back to the master the original population.
-			send(pop_copy,0);
-                }
+// Task run by the evolution threads of a worker: serve a request on its session and queue the reply for the given slot.
+static void serve_task(const boost::shared_ptr<const std::string> &request, int slot, const boost::shared_ptr<worker_session> &s,
+	session_store &store, reply_queue &replies)
+{
+	std::string reply;
+	try {
+		if (mpi_environment::get_payload_format(*request) == mpi_environment::binary_format) {
+			serve_request<boost::archive::binary_iarchive,boost::archive::binary_oarchive>(*request,reply,s,store);
+		} else {
+			serve_request<boost::archive::text_iarchive,boost::archive::text_oarchive>(*request,reply,s,store);
+		}
+	} catch (...) {
+		// A reply must be sent anyway: an empty one will be rejected by the root process as malformed.
+		reply.clear();
+	}
+	{
+		boost::lock_guard<boost::mutex> lock(replies.m_mutex);
+		replies.m_replies.push_back(std::make_pair(slot,std::string()));
+		replies.m_replies.back().second.swap(reply);
+	}
+	replies.m_cond.notify_all();
+}
+
+// Main loop of the workers. Each worker keeps a set of sessions opened by the root process, each one holding the population
+// and the algorithm of an island. This way problems and algorithms are transferred only when an island is bound to the worker,
+// and subsequent evolutions need only the exchange of the state of the population.
+// The main thread performs all the MPI communications of the worker: it receives the requests, hands them to a pool of n_threads
+// evolution threads and sends back the replies as soon as they are ready. While evolutions are running, it alternates tests for
+// incoming requests with waits on the queue of replies, backing off exponentially (up to 1 ms) while nothing happens.
+void mpi_environment::listen(unsigned int n_threads)
+{
+	session_store store;
+	reply_queue replies;
+	{
+		util::thread_pool pool(n_threads);
+		// Number of requests being served.
+		std::size_t n_running = 0;
+		long backoff = 0;
+		int size;
+		MPI_Request size_request;
+		MPI_Irecv(static_cast<void *>(&size),1,MPI_INT,0,0,MPI_COMM_WORLD,&size_request);
+		while (true) {
+			// Send the replies that are ready.
+			std::deque<std::pair<int,std::string> > ready;
+			{
+				boost::lock_guard<boost::mutex> lock(replies.m_mutex);
+				ready.swap(replies.m_replies);
+			}
+			for (std::deque<std::pair<int,std::string> >::iterator it = ready.begin(); it != ready.end(); ++it) {
+				send_buffer(it->second,0,reply_tag(it->first));
+				pagmo_assert(n_running);
+				--n_running;
+			}
+			// Check for a new request. If there are no evolutions running, just wait for it.
+			int flag = 0;
+			if (n_running) {
+				MPI_Test(&size_request,&flag,MPI_STATUS_IGNORE);
+			} else {
+				MPI_Wait(&size_request,MPI_STATUS_IGNORE);
+				flag = 1;
+			}
+			if (!flag) {
+				if (ready.empty()) {
+					backoff = std::min<long>(1000,backoff ? 2 * backoff : 1);
+					boost::unique_lock<boost::mutex> lock(replies.m_mutex);
+					if (replies.m_replies.empty()) {
+						replies.m_cond.timed_wait(lock,boost::posix_time::microseconds(backoff));
+					}
+				} else {
+					backoff = 0;
+				}
+				continue;
+			}
+			backoff = 0;
+			// Receive the payload of the request.
+			std::vector<char> buffer_char(boost::numeric_cast<std::vector<char>::size_type>(size) + 1u,0);
+			MPI_Recv(static_cast<void *>(&buffer_char[0]),size,MPI_CHAR,0,1,MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+			const boost::shared_ptr<const std::string> request(new std::string(buffer_char.begin(),buffer_char.end() - 1));
+			request_header header;
+			if (get_payload_format(*request) == binary_format) {
+				read_header<boost::archive::binary_iarchive>(*request,header);
+			} else {
+				read_header<boost::archive::text_iarchive>(*request,header);
+			}
+			if (header.m_kind == shutdown_request) {
+				break;
+			}
+			// Apply the drops and resolve the session of the request before handing it to the evolution threads, so that
+			// the sessions are opened and closed in the order in which the requests are received.
+			boost::shared_ptr<worker_session> s;
+			{
+				boost::lock_guard<boost::mutex> lock(store.m_mutex);
+				for (std::vector<std::pair<unsigned long,unsigned long> >::const_iterator it = header.m_dropped.begin(); it != header.m_dropped.end(); ++it) {
+					store.drop(it->first,it->second);
+				}
+				s = store.resolve(header);
+			}
+			pool.enqueue(boost::bind(serve_task,request,header.m_slot,s,boost::ref(store),boost::ref(replies)));
+			++n_running;
+			// Wait for the next request.
+			MPI_Irecv(static_cast<void *>(&size),1,MPI_INT,0,0,MPI_COMM_WORLD,&size_request);
+		}
+		// NOTE: the root process shuts the workers down only after all its exchanges have been completed, hence
+		// there are no evolutions running at this point.
+		pagmo_assert(!n_running);
 	}
 	// Destroy the MPI environment before exiting.
 	MPI_Finalize();
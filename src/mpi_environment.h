@@ -25,16 +25,22 @@
 #ifndef PAGMO_MPI_ENVIRONMENT_H
 #define PAGMO_MPI_ENVIRONMENT_H
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/utility.hpp>
+#include <ios>
 #include <mpi.h>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "config.h"
+#include "serialization.h"
 
 /*!
 \page mpi_support MPI support in PaGMO
@@ -48,10 +54,9 @@ In order to enable and use MPI support in PaGMO a standard-compliant MPI impleme
 on all systems participating to the cluster. PaGMO uses basic MPI 1.2 calls such as MPI_Recv, MPI_Send etc., and does not employ any function
 specific to MPI 2.x.
 
-For best performance, the root node of the MPI cluster (i.e., the node where mpiexec/mpirun is launched) should have a thread-safe
-MPI implementation. This means that a call to MPI_Query_thread should ideally return MPI_THREAD_MULTIPLE. It is possible to run PaGMO
-also if MPI_Query_thread returns MPI_THREAD_SERIALIZED, but in this case there will be a performance penalty. With any lesser level of thread
-support in the root node, PaGMO will refuse to operate in MPI mode.
+The root node of the MPI cluster (i.e., the node where mpiexec/mpirun is launched) performs all its communications from a dedicated
+progress thread, hence its MPI implementation must support at least the MPI_THREAD_SERIALIZED thread level (i.e., a call to MPI_Query_thread
+should return MPI_THREAD_SERIALIZED or MPI_THREAD_MULTIPLE). With any lesser level of thread support in the root node, PaGMO will refuse to operate in MPI mode.
 
 @see http://www.fz-juelich.de/jsc/juropa/www3/MPI_Query_thread.html
 
@@ -79,9 +84,22 @@ At the beginning of a PaGMO MPI main() execution, a list of available processors
 of the MPI world (from which it follows that it is not possible to use PaGMO with an MPI world of size less than 2). In the PaGMO model, the process with rank 0
 is tasked with the dispatch and coordination of jobs and does not perform any optimization process.
 
-Whenever an evolution method is called from from a pagmo::mpi_island, the island will check the list of available processors and, if a processor is available, will
-erase the processor ID from the list and dispatch the evolution to that processor. At the end of the evolution, the island retrieves the payload and adds the processor ID back
-to the list of available processors.
+Each processor can run a number of evolutions concurrently on a local pool of threads, as specified by the argument of the pagmo::mpi_environment constructor
+(one by default). This allows to run a single MPI process on each multi-core node of a cluster, rather than one process per core. The capacity of
+each processor is advertised to the root process at initialisation.
+
+Whenever an evolution method is called from from a pagmo::mpi_island, the island will check the list of available processors and, if a processor has a free slot, will
+occupy the slot and dispatch the evolution to that processor. Among the processors with free slots, the one with the largest fraction of free slots is chosen.
+At the end of the evolution, the island retrieves the payload and frees the slot.
+
+The islands do not call MPI directly: they hand their payloads to a progress thread running on the root node, which owns all the MPI communications
+of the root node. The progress thread overlaps the transfers of all the islands using non-blocking MPI calls, and wakes up each island
+as soon as the reply to its payload has been received.
+
+In order to limit the amount of data exchanged, an island evolved on a processor opens a session there: the processor keeps its own copy
+of the population and of the algorithm of the island, so that the next evolutions of the island on the same processor require only the
+transfer of the individuals and of the random number generators of the population, the problem and the algorithm staying resident.
+Sessions are re-bound automatically when the algorithm or the problem of the island change.
 
 Whenever the number of MPI islands is at least equal to the MPI world size, it might happen that one or more islands are not able to acquire any processor at the beginning of
 the evolution, all the processors being busy. In such case a fair priority queue is created, and the islands waiting for a processor to be released are added to the
@@ -96,8 +114,8 @@ using namespace pagmo;
 
 int main()
 {
-	// Initialise the MPI environment.
-	mpi_environment env;
+	// Initialise the MPI environment. Each process will run up to 4 evolutions at a time.
+	mpi_environment env(4);
 	// Create a problem and an algorithm.
 	problem::dejong prob(10);
 	algorithm::monte_carlo algo(100);
@@ -114,6 +132,13 @@ int main()
 }
 \endcode
 The code is exactly the same as it would be for use with pagmo::island instances, the only difference being the creation of a pagmo::mpi_environment at the very beginning.
+\section mpi_format Payload format
+By default, payloads are encoded with Boost binary archives, which are fast and compact but require all the nodes of the cluster
+to share the same architecture. On heterogeneous clusters, the portable (but slower and more verbose) text format can be selected
+on the root node with:
+\code
+pagmo::mpi_environment::set_archive_format(pagmo::mpi_environment::text_format);
+\endcode
 \section mpi_execution Executing MPI programs
 An MPI-enabled PaGMO executable can be executed just like any MPI executable. The following instructions assume that
 the MPI environment is from Open MPI; different MPI implementations might need slightly different setup (e.g., MPICH2
@@ -174,11 +199,27 @@ namespace pagmo
 class __PAGMO_VISIBLE mpi_environment: private boost::noncopyable
 {
 	public:
-		mpi_environment();
+		explicit mpi_environment(unsigned int = 1);
 		~mpi_environment();
 		static bool is_multithread();
 		static int get_size();
 		static int get_rank();
+		static int get_capacity(int);
+		/// Serialization formats of the MPI payloads.
+		/**
+		 * The first byte of each payload identifies its format, so that the receiver can always decode it.
+		 * Replies are encoded in the format of the request.
+		 */
+		enum archive_format
+		{
+			/// Boost text archives. They are portable among nodes with different architectures, but slow and verbose.
+			text_format = 0,
+			/// Boost binary archives. They are fast and compact, but all nodes must share the same architecture.
+			binary_format = 1
+		};
+		static archive_format get_archive_format();
+		static void set_archive_format(archive_format);
+		static archive_format get_payload_format(const std::string &);
 		/// Receive MPI payload.
 		/**
 		 * Receive an instance of class T from the processor with ID source and store it into retval.
@@ -190,25 +231,22 @@ class __PAGMO_VISIBLE mpi_environment: private boost::noncopyable
 		template <class T>
 		static void recv(T &retval, int source)
 		{
-			check_init();
-			MPI_Status status;
-			// First receive the size.
-			int size;
-			MPI_Recv(static_cast<void *>(&size),1,MPI_INT,source,0,MPI_COMM_WORLD,&status);
-			// Prepare the vector of chars.
-			std::vector<char> buffer_char(boost::numeric_cast<std::vector<char>::size_type>(size),0);
-			// Receive the payload.
-			MPI_Recv(static_cast<void *>(&buffer_char[0]),size,MPI_CHAR,source,1,MPI_COMM_WORLD,&status);
-			// Build the string from the vector.
-			const std::string buffer_str(buffer_char.begin(),buffer_char.end());
-			// Unpickle the payload.
-			std::stringstream ss(buffer_str);
-			boost::archive::text_iarchive ia(ss);
-			ia >> retval;
+			std::string buffer;
+			recv_buffer(buffer,source);
+			// Unpickle the payload, skipping the format byte.
+			std::istringstream iss(buffer,std::ios_base::in | std::ios_base::binary);
+			iss.ignore(1);
+			if (get_payload_format(buffer) == binary_format) {
+				boost::archive::binary_iarchive ia(iss,boost::archive::no_header);
+				ia >> retval;
+			} else {
+				boost::archive::text_iarchive ia(iss,boost::archive::no_header);
+				ia >> retval;
+			}
 		}
 		/// Send MPI payload.
 		/**
-		 * Send an instance of class T to the processor with ID destination.
+		 * Send an instance of class T to the processor with ID destination, using the format returned by get_archive_format().
 		 * This method is thread-safe only if mpi_environment::is_multithread returns true.
 		 * 
 		 * @param[in] payload instance of class T that will be sent to destination.
@@ -217,24 +255,85 @@ class __PAGMO_VISIBLE mpi_environment: private boost::noncopyable
 		template <class T>
 		static void send(const T &payload, int destination)
 		{
-			check_init();
-			std::stringstream ss;
-			boost::archive::text_oarchive oa(ss);
-			oa << payload;
-			const std::string buffer_str(ss.str());
-			std::vector<char> buffer_char(buffer_str.begin(),buffer_str.end());
-			// Send the size.
-			int size = boost::numeric_cast<int>(buffer_char.size());
-			MPI_Send(static_cast<void *>(&size),1,MPI_INT,destination,0,MPI_COMM_WORLD);
-			// Send the string.
-			MPI_Send(static_cast<void *>(&buffer_char[0]),size,MPI_CHAR,destination,1,MPI_COMM_WORLD);
+			const archive_format format = get_archive_format();
+			std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
+			oss.put(static_cast<char>(format));
+			if (format == binary_format) {
+				boost::archive::binary_oarchive oa(oss,boost::archive::no_header);
+				oa << payload;
+			} else {
+				boost::archive::text_oarchive oa(oss,boost::archive::no_header);
+				oa << payload;
+			}
+			send_buffer(oss.str(),destination);
 		}
+		static void recv_buffer(std::string &, int, int = 0);
+		static void send_buffer(const std::string &, int, int = 0);
+		static void exchange(const std::string &, std::string &, int, int);
 		static bool iprobe(int);
+		/// Kinds of request sent by the root process to the workers.
+		enum request_kind
+		{
+			/// Terminate the worker.
+			shutdown_request = 0,
+			/// Open a session, sending the whole population (including the problem) and the algorithm of an island.
+			/**
+			 * If a session with the same identifier is already open on the worker, it will be replaced.
+			 */
+			bind_request = 1,
+			/// Evolve the population of an open session, sending only the state of the population (see population::state_proxy).
+			evolve_request = 2
+		};
+		/// Header of the requests sent by the root process to the workers.
+		/**
+		 * In a bind_request, the header is followed by a pointer to the population and by a pointer to the algorithm.
+		 * In an evolve_request, the header is followed by the state of the population.
+		 * In both cases the worker evolves the population of the session and replies with a boolean flag signalling success,
+		 * followed (in case of success) by the state of the evolved population. The reply is sent on the tags of the slot
+		 * of the request, so that the replies to concurrent requests cannot be mixed up.
+		 */
+		struct request_header
+		{
+			/// Default constructor.
+			request_header():m_kind(shutdown_request),m_session(0),m_seq(0),m_slot(0) {}
+			/// Kind of request.
+			int				m_kind;
+			/// Session identifier.
+			unsigned long			m_session;
+			/// Sequence number of the request, increasing across the requests of the session.
+			unsigned long			m_seq;
+			/// Slot of the worker occupied by the request, in the [0,get_capacity()[ range.
+			int				m_slot;
+			/// Sessions that the worker must close, as (identifier,sequence number) pairs.
+			/**
+			 * The sequence number is the one of the last request of the session sent to the worker before the session was dropped.
+			 * As the requests of different sessions are sent concurrently, that request may reach the worker after this one:
+			 * the session is closed only once both have been received, and later requests of the session (which re-bind it) are unaffected.
+			 */
+			std::vector<std::pair<unsigned long,unsigned long> >	m_dropped;
+			/// Serialization.
+			template <class Archive>
+			void serialize(Archive &ar, const unsigned int)
+			{
+				ar & m_kind;
+				ar & m_session;
+				ar & m_seq;
+				ar & m_slot;
+				ar & m_dropped;
+			}
+		};
 	private:
-		static void listen();
+		struct progress_engine;
+		static int reply_tag(int);
+		static void listen(unsigned int);
 		static void check_init();
-		static bool	m_initialised;
-		static bool	m_multithread;
+		static bool					m_initialised;
+		static bool					m_multithread;
+		static int					m_size;
+		static int					m_rank;
+		static std::vector<int>				m_capacities;
+		static archive_format				m_archive_format;
+		static boost::scoped_ptr<progress_engine>	m_engine;
 };
 
 }
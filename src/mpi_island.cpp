@@ -22,6 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <boost/archive/archive_exception.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
@@ -29,10 +30,16 @@
 #include <boost/thread/thread.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
 #include <list>
-#include <set>
+#include <map>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "algorithm/base.h"
 #include "base_island.h"
@@ -49,9 +56,15 @@ namespace pagmo
 
 boost::mutex mpi_island::m_proc_mutex;
 boost::condition_variable mpi_island::m_proc_cond;
-boost::mutex mpi_island::m_mpi_mutex;
-std::list<mpi_island const *> mpi_island::m_queue;
-boost::scoped_ptr<std::set<int> > mpi_island::m_available_processors;
+std::list<std::pair<mpi_island const *,boost::posix_time::ptime> > mpi_island::m_queue;
+std::map<int,double> mpi_island::m_slowdowns;
+boost::scoped_ptr<std::map<int,std::vector<int> > > mpi_island::m_free_slots;
+unsigned long mpi_island::m_next_session_id = 0;
+std::map<int,std::list<mpi_island::session_record> > mpi_island::m_sessions;
+const std::size_t mpi_island::max_sessions;
+
+// Weight of the most recent record in the moving averages of the evolution times.
+static const double time_smoothing = .5;
 
 /// Constructor from problem::base, algorithm::base, number of individuals, migration probability and selection/replacement policies.
 /**
@@ -59,7 +72,7 @@ boost::scoped_ptr<std::set<int> > mpi_island::m_available_processors;
  */
 mpi_island::mpi_island(const algorithm::base &a, const problem::base &p, int n,
 	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
-	base_island(a,p,n,s_policy,r_policy)
+	base_island(a,p,n,s_policy,r_policy),m_session_id(new_session_id()),m_session_gen(0),m_session_seq(0),m_expected_time(-1)
 {}
 
 /// Constructor from population.
@@ -68,20 +81,30 @@ mpi_island::mpi_island(const algorithm::base &a, const problem::base &p, int n,
  */
 mpi_island::mpi_island(const algorithm::base &a, const population &pop,
 	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
-	base_island(a,pop,s_policy,r_policy)
+	base_island(a,pop,s_policy,r_policy),m_session_id(new_session_id()),m_session_gen(0),m_session_seq(0),m_expected_time(-1)
 {}
 
 /// Copy constructor.
 /**
+ * The copy will not share the sessions opened on the processors by isl.
+ *
  * @see pagmo::base_island constructors.
  */
-mpi_island::mpi_island(const mpi_island &isl):base_island(isl)
+mpi_island::mpi_island(const mpi_island &isl):base_island(isl),m_session_id(new_session_id()),m_session_gen(0),m_session_seq(0),m_expected_time(-1)
 {}
 
 /// Assignment operator.
+/**
+ * The sessions opened on the processors for this island will be re-bound at the next evolution.
+ */
 mpi_island &mpi_island::operator=(const mpi_island &isl)
 {
 	base_island::operator=(isl);
+	m_session_algo.reset();
+	m_session_prob.reset();
+	// NOTE: the expected time is read by other islands in pick_island(), hence it is written under the processors mutex.
+	boost::lock_guard<boost::mutex> lock(m_proc_mutex);
+	m_expected_time = -1;
 	return *this;
 }
 
@@ -90,50 +113,118 @@ base_island_ptr mpi_island::clone() const
 	return base_island_ptr(new mpi_island(*this));
 }
 
+// Write an evolution request into an archive: the header followed by the whole population and the algorithm when binding a session,
+// by the state of the population otherwise.
+template <class Archive>
+static void save_request(Archive &oa, const mpi_environment::request_header &header, const algorithm::base &algo, population &pop)
+{
+	oa << header;
+	if (header.m_kind == mpi_environment::bind_request) {
+		const population *pop_ptr = &pop;
+		const algorithm::base *algo_ptr = &algo;
+		oa << pop_ptr;
+		oa << algo_ptr;
+	} else {
+		population::state_proxy proxy(pop);
+		oa << proxy;
+	}
+}
+
+// Read the reply of a worker from an archive, loading the state of the evolved population into pop and reporting the evaluations
+// performed by the worker to the problem of pop. Return false if the worker could not serve the request.
+// NOTE: the state is loaded directly into the population of the island, which is left untouched in case of failure.
+template <class Archive>
+static bool load_reply(Archive &ia, population &pop)
+{
+	bool ok;
+	ia >> ok;
+	if (ok) {
+		unsigned int fevals;
+		ia >> fevals;
+		population::state_proxy proxy(pop);
+		ia >> proxy;
+		pop.problem().add_fevals(fevals);
+	}
+	return ok;
+}
+
 // Method that perform the actual evolution for the island population, and is used to distribute the computation load over multiple processors
 void mpi_island::perform_evolution(const algorithm::base &algo, population &pop) const
 {
-	// Create copy of data to be transmitted - will use a std::pair for packing everything in a single object.
-	const boost::shared_ptr<population> pop_copy(new population(pop));
-	const algorithm::base_ptr algo_copy = algo.clone();
-	const std::pair<boost::shared_ptr<population>,algorithm::base_ptr> out(pop_copy,algo_copy);
-	const int processor = acquire_processor();
-	if (mpi_environment::is_multithread()) {
-		mpi_environment::send(out,processor);
-	} else {
-		// Lock down MPI mutex before sending.
-		boost::lock_guard<boost::mutex> lock(m_mpi_mutex);
-		mpi_environment::send(out,processor);
+	pagmo_assert(&algo == m_algo.get());
+	// If the algorithm or the problem changed since the last evolution, the sessions opened on the processors are outdated.
+	if (m_session_algo.get() != &algo || m_session_prob.get() != &pop.problem()) {
+		m_session_algo = m_algo;
+		m_session_prob = population_access::get_problem_ptr(pop);
+		++m_session_gen;
+		// The recorded evolution times do not apply any more.
+		boost::lock_guard<boost::mutex> lock(m_proc_mutex);
+		m_expected_time = -1;
 	}
+	const std::pair<int,int> slot = acquire_processor();
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	const int processor = slot.first;
+	mpi_environment::request_header header;
+	header.m_session = m_session_id;
+	header.m_slot = slot.second;
+	header.m_kind = open_session(processor,header.m_seq,header.m_dropped) ? mpi_environment::evolve_request : mpi_environment::bind_request;
+	// Build the request, prefixed by the format byte.
+	const mpi_environment::archive_format format = mpi_environment::get_archive_format();
+	std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
+	oss.put(static_cast<char>(format));
 	bool successful = false;
-	boost::shared_ptr<population> in;
 	try {
-		if (mpi_environment::is_multithread()) {
-			mpi_environment::recv(in,processor);
+		if (format == mpi_environment::binary_format) {
+			boost::archive::binary_oarchive oa(oss,boost::archive::no_header);
+			save_request(oa,header,algo,pop);
 		} else {
-			while (true) {
-				{
-					boost::lock_guard<boost::mutex> lock(m_mpi_mutex);
-					if (mpi_environment::iprobe(processor)) {
-						mpi_environment::recv(in,processor);
-						break;
-					}
-				}
-				boost::this_thread::sleep(boost::posix_time::milliseconds(10));
-			}
+			boost::archive::text_oarchive oa(oss,boost::archive::no_header);
+			save_request(oa,header,algo,pop);
 		}
 		successful = true;
-	} catch (const boost::archive::archive_exception &e) {
-		std::cout << "MPI Recv Error during island evolution using " << algo.get_name() << ": " << e.what() << std::endl;
-	} catch (...) {
-		std::cout << "MPI Recv Error during island evolution using " << algo.get_name() << ", unknown exception caught. :(" << std::endl;
+	} catch (const std::exception &e) {
+		std::cout << "MPI Send Error during island evolution using " << algo.get_name() << ": " << e.what() << std::endl;
 	}
-	release_processor(processor);
 	if (successful) {
-		// NOTE: implement via population::swap (to be written) in order to avoid
-		// extra copying?
-		pop = *in;
+		successful = false;
+		try {
+			// Hand the request to the progress thread of the MPI environment and wait for the reply.
+			std::string buffer;
+			mpi_environment::exchange(oss.str(),buffer,processor,slot.second);
+			std::istringstream iss(buffer,std::ios_base::in | std::ios_base::binary);
+			iss.ignore(1);
+			if (mpi_environment::get_payload_format(buffer) == mpi_environment::binary_format) {
+				boost::archive::binary_iarchive ia(iss,boost::archive::no_header);
+				successful = load_reply(ia,pop);
+			} else {
+				boost::archive::text_iarchive ia(iss,boost::archive::no_header);
+				successful = load_reply(ia,pop);
+			}
+			if (!successful) {
+				std::cout << "MPI Remote Error during island evolution using " << algo.get_name() << ": the remote session was lost" << std::endl;
+			}
+		} catch (const std::exception &e) {
+			std::cout << "MPI Recv Error during island evolution using " << algo.get_name() << ": " << e.what() << std::endl;
+		} catch (...) {
+			std::cout << "MPI Recv Error during island evolution using " << algo.get_name() << ", unknown exception caught. :(" << std::endl;
+		}
+	}
+	if (!successful) {
+		// The session will be re-bound at the next evolution.
+		close_session(processor);
 	}
+	release_processor(slot,successful ? (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() / 1E6 : -1.);
+}
+
+/// Blocking evolution.
+/**
+ * The evolution runs on an MPI processor, while the calling thread waits for a free slot and for the result.
+ *
+ * @return true.
+ */
+bool mpi_island::blocking() const
+{
+	return true;
 }
 
 /// Return a string identifying the island's type.
@@ -149,50 +240,183 @@ void mpi_island::init_processors()
 {
 	// Make sure we are not called with the mutex not locked.
 	pagmo_assert(!m_proc_mutex.try_lock());
-	if (!m_available_processors) {
-		m_available_processors.reset(new std::set<int>());
+	if (!m_free_slots) {
+		m_free_slots.reset(new std::map<int,std::vector<int> >());
 		pagmo_assert(mpi_environment::get_size() >= 2);
-		// Fill in the available processors (the root processor is excluded).
+		// Fill in the slots of the available processors (the root processor is excluded).
 		for (int i = 1; i < mpi_environment::get_size(); ++i) {
-			m_available_processors->insert(i);
+			std::vector<int> &slots = (*m_free_slots)[i];
+			for (int j = mpi_environment::get_capacity(i); j > 0; --j) {
+				slots.push_back(j - 1);
+			}
+		}
+	}
+}
+
+// Check whether the session of the island is open and up to date on processor n.
+bool mpi_island::has_session(int n) const
+{
+	pagmo_assert(!m_proc_mutex.try_lock());
+	const std::map<int,std::list<session_record> >::const_iterator it = m_sessions.find(n);
+	if (it == m_sessions.end()) {
+		return false;
+	}
+	for (std::list<session_record>::const_iterator r = it->second.begin(); r != it->second.end(); ++r) {
+		if (r->m_id == m_session_id) {
+			return r->m_gen == m_session_gen;
+		}
+	}
+	return false;
+}
+
+// Pick a processor with a free slot for the island: a processor holding the session of the island, if possible, or else the processor
+// with the largest fraction of free slots, weighted by its speed. Return zero if all the slots are busy.
+int mpi_island::pick_processor() const
+{
+	pagmo_assert(!m_proc_mutex.try_lock() && m_free_slots);
+	int retval = 0;
+	double best_score = 0;
+	for (std::map<int,std::vector<int> >::const_iterator it = m_free_slots->begin(); it != m_free_slots->end(); ++it) {
+		if (it->second.empty()) {
+			continue;
+		}
+		if (has_session(it->first)) {
+			return it->first;
+		}
+		const std::map<int,double>::const_iterator slowdown = m_slowdowns.find(it->first);
+		const double score = static_cast<double>(it->second.size()) / mpi_environment::get_capacity(it->first) /
+			(slowdown == m_slowdowns.end() ? 1. : slowdown->second);
+		if (score > best_score) {
+			retval = it->first;
+			best_score = score;
 		}
 	}
+	return retval;
 }
 
-int mpi_island::acquire_processor() const
+// Pick the waiting island that should be served first: the one with the longest expected evolution time, increased by the time
+// it has been waiting. Islands whose evolution time is unknown come first, in order of arrival.
+mpi_island const *mpi_island::pick_island()
+{
+	pagmo_assert(!m_proc_mutex.try_lock() && !m_queue.empty());
+	const boost::posix_time::ptime now = boost::posix_time::microsec_clock::local_time();
+	mpi_island const *retval = 0;
+	double best_priority = 0;
+	for (std::list<std::pair<mpi_island const *,boost::posix_time::ptime> >::const_iterator it = m_queue.begin(); it != m_queue.end(); ++it) {
+		if (it->first->m_expected_time < 0) {
+			return it->first;
+		}
+		const double priority = it->first->m_expected_time + (now - it->second).total_microseconds() / 1E6;
+		if (!retval || priority > best_priority) {
+			retval = it->first;
+			best_priority = priority;
+		}
+	}
+	return retval;
+}
+
+// Occupy a slot of a processor, waiting if all the slots are busy. Return the (processor,slot) pair.
+std::pair<int,int> mpi_island::acquire_processor() const
 {
 	// Lock down before doing anything else.
 	boost::unique_lock<boost::mutex> lock(m_proc_mutex);
 	init_processors();
-	if (m_available_processors->empty() || !m_queue.empty()) {
-		// Put self at the end of the queue.
-		m_queue.push_back(this);
-		while (*m_queue.begin() != this || m_available_processors->empty()) {
+	if (!pick_processor() || !m_queue.empty()) {
+		// Join the waiting islands.
+		m_queue.push_back(std::make_pair(this,boost::posix_time::microsec_clock::local_time()));
+		while (pick_island() != this || !pick_processor()) {
 			m_proc_cond.wait(lock);
 		}
-		// this reached the head of the queue and there are available processors: pop it
-		// from the head and proceed.
-		m_queue.pop_front();
+		for (std::list<std::pair<mpi_island const *,boost::posix_time::ptime> >::iterator it = m_queue.begin(); it != m_queue.end(); ++it) {
+			if (it->first == this) {
+				m_queue.erase(it);
+				break;
+			}
+		}
+		// Let the other waiting islands check for free slots too.
+		m_proc_cond.notify_all();
+	}
+	const int processor = pick_processor();
+	pagmo_assert(processor);
+	std::vector<int> &slots = (*m_free_slots)[processor];
+	const std::pair<int,int> retval(processor,slots.back());
+	slots.pop_back();
+	return retval;
+}
+
+unsigned long mpi_island::new_session_id()
+{
+	boost::lock_guard<boost::mutex> lock(m_proc_mutex);
+	return m_next_session_id++;
+}
+
+// Record that the session of the island is open on processor n, assigning the sequence number seq to the request and filling dropped
+// with the sessions that the processor must close to make room for it, together with the sequence numbers of their last requests
+// (which might still be on their way to the processor, see mpi_environment::request_header). Return true if the session was already
+// open and up to date, false if it must be bound.
+bool mpi_island::open_session(int n, unsigned long &seq, std::vector<std::pair<unsigned long,unsigned long> > &dropped) const
+{
+	boost::lock_guard<boost::mutex> lock(m_proc_mutex);
+	std::list<session_record> &open = m_sessions[n];
+	bool retval = false;
+	for (std::list<session_record>::iterator it = open.begin(); it != open.end(); ++it) {
+		if (it->m_id == m_session_id) {
+			retval = (it->m_gen == m_session_gen);
+			open.erase(it);
+			break;
+		}
+	}
+	seq = m_session_seq++;
+	open.push_front(session_record(m_session_id,m_session_gen,seq));
+	while (open.size() > max_sessions * static_cast<std::size_t>(mpi_environment::get_capacity(n))) {
+		dropped.push_back(std::make_pair(open.back().m_id,open.back().m_seq));
+		open.pop_back();
 	}
-	pagmo_assert(!m_available_processors->empty());
-	const int retval = *m_available_processors->begin();
-	m_available_processors->erase(m_available_processors->begin());
 	return retval;
 }
 
-void mpi_island::release_processor(int n) const
+// Forget the session of the island on processor n.
+void mpi_island::close_session(int n) const
+{
+	boost::lock_guard<boost::mutex> lock(m_proc_mutex);
+	std::list<session_record> &open = m_sessions[n];
+	for (std::list<session_record>::iterator it = open.begin(); it != open.end(); ++it) {
+		if (it->m_id == m_session_id) {
+			open.erase(it);
+			break;
+		}
+	}
+}
+
+// Free a slot, recording the duration of the evolution performed there (a negative value means that the evolution failed).
+void mpi_island::release_processor(const std::pair<int,int> &slot, double elapsed) const
 {
 	{
 		boost::lock_guard<boost::mutex> lock(m_proc_mutex);
 		init_processors();
+		const int n = slot.first;
 		if (n <= 0 || n >= mpi_environment::get_size()) {
 			pagmo_throw(std::runtime_error,"invalid processor id: the value is either non-positive or exceeding the size of the MPI world");
 		}
-		if (m_available_processors->find(n) != m_available_processors->end()) {
-			pagmo_throw(std::runtime_error,"trying to release a processor which was never acquired");
+		std::vector<int> &slots = (*m_free_slots)[n];
+		if (slot.second < 0 || slot.second >= mpi_environment::get_capacity(n) || std::find(slots.begin(),slots.end(),slot.second) != slots.end()) {
+			pagmo_throw(std::runtime_error,"trying to release a processor slot which was never acquired");
+		}
+		// Re-insert the slot in the pool of available slots.
+		slots.push_back(slot.second);
+		// Update the statistics.
+		if (elapsed >= 0) {
+			if (m_expected_time > 0) {
+				const std::map<int,double>::iterator it = m_slowdowns.find(n);
+				const double ratio = elapsed / m_expected_time;
+				if (it == m_slowdowns.end()) {
+					m_slowdowns[n] = ratio;
+				} else {
+					it->second = time_smoothing * ratio + (1. - time_smoothing) * it->second;
+				}
+			}
+			m_expected_time = (m_expected_time < 0) ? elapsed : time_smoothing * elapsed + (1. - time_smoothing) * m_expected_time;
 		}
-		// Re-insert the processor in the pool of available processors.
-		m_available_processors->insert(n);
 	}
 	m_proc_cond.notify_all();
 }
@@ -25,12 +25,16 @@
 #ifndef PAGMO_MPI_ISLAND_H
 #define PAGMO_MPI_ISLAND_H
 
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
+#include <cstddef>
 #include <list>
-#include <set>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base_island.h"
 #include "config.h"
@@ -68,6 +72,17 @@ namespace pagmo
  * This island class will dispatch evolutions to participants to an MPI cluster. This class can be used like any other island class,
  * the only difference being that before calling any evolution a pagmo::mpi_environment instance must have been created.
  * More information about the MPI support in PaGMO is available in \ref mpi_support "this page".
+ *
+ * The first time an island is evolved on a processor, a session holding a copy of its population and algorithm is opened on the
+ * processor. Subsequent evolutions on the same processor transfer only the state of the population (see population::state_proxy),
+ * until the algorithm or the problem of the island are changed. Each processor keeps at most max_sessions sessions open for each
+ * of its slots (see mpi_environment::get_capacity()), closing the least recently used ones.
+ *
+ * The slots of the processors are scheduled according to the recorded evolution times:
+ * - an island goes back to a processor holding its session, if such processor has a free slot;
+ * - otherwise, the island is sent to the processor with the largest fraction of free slots, weighted by the speed recorded for the processor;
+ * - when all the slots are busy, the waiting island with the longest expected evolution time (plus the time it has been waiting, so that
+ *   no island can starve) is served first. Islands whose evolution time is not known yet are served first.
  * 
  * <b>NOTE</b>: this class is available only if PaGMO was compiled with MPI support.
  *
@@ -90,8 +105,11 @@ class __PAGMO_VISIBLE mpi_island: public base_island
 			const migration::base_r_policy & = migration::fair_r_policy());
 		mpi_island &operator=(const mpi_island &);
 		base_island_ptr clone() const;
+		/// Maximum number of sessions kept open for each slot of a processor.
+		static const std::size_t max_sessions = 16;
 	protected:
 		void perform_evolution(const algorithm::base &, population &) const;
+		bool blocking() const;
 	public:
 		std::string get_name() const;
 	private:
@@ -102,15 +120,48 @@ class __PAGMO_VISIBLE mpi_island: public base_island
 			// Join is already done in base_island.
 			ar & boost::serialization::base_object<base_island>(*this);
 		}
+		// Session open on a processor.
+		struct session_record
+		{
+			session_record(unsigned long id, unsigned long gen, unsigned long seq):m_id(id),m_gen(gen),m_seq(seq) {}
+			unsigned long	m_id;
+			unsigned long	m_gen;
+			// Sequence number of the last request of the session sent to the processor.
+			unsigned long	m_seq;
+		};
 		static void init_processors();
-		int acquire_processor() const;
-		void release_processor(int) const;
+		bool has_session(int) const;
+		int pick_processor() const;
+		static mpi_island const *pick_island();
+		std::pair<int,int> acquire_processor() const;
+		void release_processor(const std::pair<int,int> &, double) const;
+		static unsigned long new_session_id();
+		bool open_session(int, unsigned long &, std::vector<std::pair<unsigned long,unsigned long> > &) const;
+		void close_session(int) const;
 	private:
+		// Identifier of the sessions opened on the processors for this island.
+		unsigned long					m_session_id;
+		// Generation of the sessions, increased each time the algorithm or the problem of the island change.
+		mutable unsigned long				m_session_gen;
+		// Sequence number of the next request of the island. Protected by m_proc_mutex.
+		mutable unsigned long				m_session_seq;
+		// Algorithm and problem of the current generation. They are kept alive, so that their addresses identify them.
+		mutable algorithm::base_ptr			m_session_algo;
+		mutable problem::base_ptr			m_session_prob;
+		// Expected duration of the evolutions of the island (in seconds), as an exponential moving average of the recorded ones.
+		// A negative value means that no evolution has been recorded yet. Protected by m_proc_mutex.
+		mutable double					m_expected_time;
 		static boost::mutex				m_proc_mutex;
 		static boost::condition_variable		m_proc_cond;
-		static boost::mutex				m_mpi_mutex;
-		static boost::scoped_ptr<std::set<int> >	m_available_processors;
-		static std::list<mpi_island const *>		m_queue;
+		// Free slots of each processor.
+		static boost::scoped_ptr<std::map<int,std::vector<int> > >	m_free_slots;
+		// Islands waiting for a free slot, with the time they started waiting.
+		static std::list<std::pair<mpi_island const *,boost::posix_time::ptime> >	m_queue;
+		// Speed of each processor, as an exponential moving average of the ratio between the recorded and the expected evolution times.
+		static std::map<int,double>			m_slowdowns;
+		static unsigned long				m_next_session_id;
+		// Sessions open on each processor, from the most to the least recently used.
+		static std::map<int,std::list<session_record> >	m_sessions;
 };
 
 }
@@ -39,6 +39,10 @@
 #include "topologies.h"
 #include "types.h"
 
+#ifndef _WIN32
+	#include "process_island.h"
+#endif
+
 #ifdef PAGMO_ENABLE_MPI
 	#include "mpi_environment.h"
 	#include "mpi_island.h"
@@ -40,6 +40,7 @@
 #include "population.h"
 #include "rng.h"
 #include "types.h"
+#include "util/non_dominated_sorting.h"
 #include "util/racing.h"
 #include "util/race_pop.h"
 
@@ -66,7 +67,8 @@ problem::base_ptr &population_access::get_problem_ptr(population &pop)
  *
  * @throw value_error if n is negative.
  */
-population::population(const problem::base &p, int n, const boost::uint32_t &seed):m_prob(p.clone()), m_pareto_rank(n), m_crowding_d(n), m_drng(seed),m_urng(seed)
+population::population(const problem::base &p, int n, const boost::uint32_t &seed):m_prob(p.clone()), m_pareto_rank(n), m_crowding_d(n), m_dom_all_dirty(false),
+	m_best_idx(0), m_worst_idx(0), m_extrema_size(0), m_extrema_dirty(true), m_drng(seed),m_urng(seed)
 {
 	if (n < 0) {
 		pagmo_throw(value_error,"number of individuals cannot be negative");
@@ -101,7 +103,9 @@ population::population(const problem::base &p, int n, const boost::uint32_t &see
  * @param[in] p population used to initialise this.
  */
 population::population(const population &p):m_prob(p.m_prob->clone()),m_container(p.m_container),m_dom_list(p.m_dom_list),m_dom_count(p.m_dom_count),
-	m_champion(p.m_champion), m_pareto_rank(p.m_pareto_rank), m_crowding_d(p.m_crowding_d),m_drng(p.m_drng),m_urng(p.m_urng)
+	m_champion(p.m_champion), m_pareto_rank(p.m_pareto_rank), m_crowding_d(p.m_crowding_d),m_dom_dirty(p.m_dom_dirty),m_dom_all_dirty(p.m_dom_all_dirty),
+	m_best_idx(p.m_best_idx),m_worst_idx(p.m_worst_idx),
+	m_extrema_size(p.m_extrema_size),m_extrema_dirty(p.m_extrema_dirty),m_drng(p.m_drng),m_urng(p.m_urng)
 {}
 
 /// Assignment operator.
@@ -124,14 +128,96 @@ population &population::operator=(const population &p)
 		m_champion = p.m_champion;
 		m_pareto_rank = p.m_pareto_rank;
 		m_crowding_d = p.m_crowding_d;
+		m_dom_dirty = p.m_dom_dirty;
+		m_dom_all_dirty = p.m_dom_all_dirty;
+		m_best_idx = p.m_best_idx;
+		m_worst_idx = p.m_worst_idx;
+		m_extrema_size = p.m_extrema_size;
+		m_extrema_dirty = p.m_extrema_dirty;
 		m_drng = p.m_drng;
 		m_urng = p.m_urng;
 	}
 	return *this;
 }
 
-// Update the domination list and the domination count when the individual at position n has changed
+// Mark the domination information of the individual at position n as outdated, after the individual has changed.
+// The actual update is deferred to update_domination_information().
 void population::update_dom(const size_type &n)
+{
+	pagmo_assert(n < m_container.size());
+	if (m_dom_all_dirty) {
+		return;
+	}
+	m_dom_dirty.push_back(n);
+	// Keep the list of outdated individuals bounded. When half of the population is outdated, a full recomputation
+	// costs as much as the incremental updates, hence we switch to it.
+	if (m_dom_dirty.size() >= m_container.size()) {
+		std::sort(m_dom_dirty.begin(),m_dom_dirty.end());
+		m_dom_dirty.erase(std::unique(m_dom_dirty.begin(),m_dom_dirty.end()),m_dom_dirty.end());
+		if (2u * m_dom_dirty.size() >= m_container.size()) {
+			m_dom_dirty.clear();
+			m_dom_all_dirty = true;
+		}
+	}
+}
+
+/// Update domination information.
+/**
+ * Bring up to date the domination lists and counts of the individuals which have changed since the last update.
+ * The update is performed automatically when the domination information is accessed, hence it is not normally
+ * necessary to call this method explicitly.
+ *
+ * If few individuals have changed, their domination lists and counts are updated incrementally (at a cost linear in the size of the
+ * population for each individual), otherwise the domination information of the whole population is recomputed.
+ */
+void population::update_domination_information() const
+{
+	pagmo_assert(m_dom_list.size() == m_container.size() && m_dom_count.size() == m_container.size());
+	if (m_dom_all_dirty) {
+		recompute_dom();
+		return;
+	}
+	if (m_dom_dirty.empty()) {
+		return;
+	}
+	std::sort(m_dom_dirty.begin(),m_dom_dirty.end());
+	m_dom_dirty.erase(std::unique(m_dom_dirty.begin(),m_dom_dirty.end()),m_dom_dirty.end());
+	if (2u * m_dom_dirty.size() >= m_container.size()) {
+		recompute_dom();
+		return;
+	}
+	for (std::vector<size_type>::size_type i = 0; i < m_dom_dirty.size(); ++i) {
+		update_dom_impl(m_dom_dirty[i]);
+	}
+	m_dom_dirty.clear();
+}
+
+// Recompute from scratch the domination lists and counts of the whole population.
+void population::recompute_dom() const
+{
+	const size_type size = m_container.size();
+	for (size_type i = 0; i < size; ++i) {
+		m_dom_list[i].clear();
+		m_dom_count[i] = 0;
+	}
+	for (size_type i = 0; i < size; ++i) {
+		for (size_type j = i + 1; j < size; ++j) {
+			if (m_prob->compare_fc(m_container[i].best_f,m_container[i].best_c,m_container[j].best_f,m_container[j].best_c)) {
+				m_dom_list[i].push_back(j);
+				m_dom_count[j]++;
+			}
+			if (m_prob->compare_fc(m_container[j].best_f,m_container[j].best_c,m_container[i].best_f,m_container[i].best_c)) {
+				m_dom_list[j].push_back(i);
+				m_dom_count[i]++;
+			}
+		}
+	}
+	m_dom_dirty.clear();
+	m_dom_all_dirty = false;
+}
+
+// Update the domination list and the domination count when the individual at position n has changed.
+void population::update_dom_impl(const size_type &n) const
 {
 	// The algorithm works as follow:
 	// 1) For each element in m_dom_list[n] decrease the domination count by one. (m_dom_count[m_dom_list[n][j]] -= 1)
@@ -179,6 +265,82 @@ void population::update_dom(const size_type &n)
 	}
 }
 
+/// Get structure-of-arrays representation.
+/**
+ * Return a copy of the data of the individuals laid out in contiguous matrices, one per data member of individual_type: row i of each matrix
+ * contains the corresponding vector of the individual at position i. This layout is suitable for kernels sweeping over the whole population
+ * (e.g., over all the fitness vectors). Vectors whose size does not match the problem dimensions (e.g., the best vectors of individuals
+ * which have not been evaluated yet) are represented by rows of NaNs.
+ *
+ * The representation is built when this method is called, and it is not updated by subsequent modifications of the population.
+ *
+ * @return the structure-of-arrays representation of the individuals.
+ */
+population::soa_type population::get_soa() const
+{
+	const size_type size = m_container.size();
+	const decision_vector::size_type p_size = m_prob->get_dimension();
+	const constraint_vector::size_type c_size = m_prob->get_c_dimension();
+	const fitness_vector::size_type f_size = m_prob->get_f_dimension();
+	soa_type retval;
+	retval.cur_x.reset(size,p_size);
+	retval.cur_v.reset(size,p_size);
+	retval.cur_c.reset(size,c_size);
+	retval.cur_f.reset(size,f_size);
+	retval.best_x.reset(size,p_size);
+	retval.best_c.reset(size,c_size);
+	retval.best_f.reset(size,f_size);
+	for (size_type i = 0; i < size; ++i) {
+		const individual_type &ind = m_container[i];
+		retval.cur_x.set_row(i,ind.cur_x);
+		retval.cur_v.set_row(i,ind.cur_v);
+		retval.cur_c.set_row(i,ind.cur_c);
+		retval.cur_f.set_row(i,ind.cur_f);
+		retval.best_x.set_row(i,ind.best_x);
+		retval.best_c.set_row(i,ind.best_c);
+		retval.best_f.set_row(i,ind.best_f);
+	}
+	return retval;
+}
+
+// Update the positions of the best and worst individuals after the fitness and constraint vectors of the individual at position n have changed.
+// The positions are updated in constant time, unless the individual was the best or the worst one: in such case they are recomputed
+// from scratch when they are next needed.
+// NOTE: ties are resolved in favour of the individual with the lowest position, as in the linear scans of update_extrema().
+void population::update_extrema(const size_type &n)
+{
+	pagmo_assert(n < m_container.size());
+	if (m_extrema_dirty || m_extrema_size != m_container.size() || n == m_best_idx || n == m_worst_idx || m_prob->get_f_dimension() != 1) {
+		m_extrema_dirty = true;
+		return;
+	}
+	const individual_type &ind = m_container[n], &best = m_container[m_best_idx], &worst = m_container[m_worst_idx];
+	if (m_prob->compare_fc(ind.cur_f,ind.cur_c,best.cur_f,best.cur_c) ||
+		(n < m_best_idx && !m_prob->compare_fc(best.cur_f,best.cur_c,ind.cur_f,ind.cur_c)))
+	{
+		m_best_idx = n;
+	}
+	if (m_prob->compare_fc(worst.cur_f,worst.cur_c,ind.cur_f,ind.cur_c) ||
+		(n < m_worst_idx && !m_prob->compare_fc(ind.cur_f,ind.cur_c,worst.cur_f,worst.cur_c)))
+	{
+		m_worst_idx = n;
+	}
+}
+
+// Bring up to date the positions of the best and worst individuals of a non-empty population of a single-objective problem.
+void population::update_extrema() const
+{
+	pagmo_assert(m_container.size() && m_prob->get_f_dimension() == 1);
+	if (!m_extrema_dirty && m_extrema_size == m_container.size()) {
+		return;
+	}
+	const trivial_comparison_operator comp(*this);
+	m_best_idx = boost::numeric_cast<size_type>(std::distance(m_container.begin(),std::min_element(m_container.begin(),m_container.end(),comp)));
+	m_worst_idx = boost::numeric_cast<size_type>(std::distance(m_container.begin(),std::max_element(m_container.begin(),m_container.end(),comp)));
+	m_extrema_size = m_container.size();
+	m_extrema_dirty = false;
+}
+
 // Init randomly the velocity of the individual in position idx.
 void population::init_velocity(const size_type &idx)
 {
@@ -261,6 +423,7 @@ void population::reinit(const size_type &idx)
 	update_champion(idx);
 	// Update the domination lists.
 	update_dom(idx);
+	update_extrema(idx);
 }
 
 
@@ -298,6 +461,7 @@ const std::vector<population::size_type> &population::get_domination_list(const
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid index");
 	}
+	update_domination_information();
 	return m_dom_list[idx];
 }
 
@@ -316,6 +480,7 @@ population::size_type population::get_domination_count(const size_type &idx) con
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid index");
 	}
+	update_domination_information();
 	return m_dom_count[idx];
 }
 
@@ -390,6 +555,22 @@ void population::update_pareto_information() const {
 	std::fill(m_pareto_rank.begin(), m_pareto_rank.end(), 0);
 	std::fill(m_crowding_d.begin(), m_crowding_d.end(), 0);
 
+	// If the problem uses the standard dominance, the fronts can be computed without the domination lists.
+	if (m_prob->standard_dominance()) {
+		std::vector<std::vector<size_type> > fronts;
+		sort_fronts(fronts);
+		for (std::vector<std::vector<size_type> >::size_type i = 0; i < fronts.size(); ++i) {
+			for (std::vector<size_type>::size_type j = 0; j < fronts[i].size(); ++j) {
+				m_pareto_rank[fronts[i][j]] = boost::numeric_cast<size_type>(i);
+			}
+			update_crowding_d(fronts[i]);
+		}
+		return;
+	}
+
+	// Make sure the domination information is up to date.
+	update_domination_information();
+
 	// We define some utility vectors .....
 	std::vector<population::size_type> F,S;
 
@@ -464,6 +645,53 @@ void population::update_crowding_d(std::vector<population::size_type> I) const {
 		}
 }
 
+// Comparison of individuals by constraint vectors, used to sort the infeasible individuals.
+struct constraints_comp {
+	constraints_comp(const population &pop):m_pop(pop) {}
+	bool operator()(const population::size_type &idx1, const population::size_type &idx2) const
+	{
+		return m_pop.problem().compare_constraints(m_pop.get_individual(idx1).best_c,m_pop.get_individual(idx2).best_c);
+	}
+	const population &m_pop;
+};
+
+// Compute the Pareto fronts of the population assuming the standard dominance of problem::base (see problem::base::standard_dominance()).
+// The feasible individuals are sorted with util::non_dominated_sorting. They dominate all the infeasible individuals, which are
+// ordered by compare_constraints(): each group of equivalent constraint vectors forms a front.
+void population::sort_fronts(std::vector<std::vector<size_type> > &fronts) const
+{
+	fronts.clear();
+	std::vector<size_type> feasible, infeasible;
+	std::vector<fitness_vector> f;
+	for (size_type i = 0; i < m_container.size(); ++i) {
+		if (m_prob->feasibility_c(m_container[i].best_c)) {
+			feasible.push_back(i);
+			f.push_back(m_container[i].best_f);
+		} else {
+			infeasible.push_back(i);
+		}
+	}
+	const util::non_dominated_sorting::fronts_type feasible_fronts = util::non_dominated_sorting::compute_fronts(f);
+	for (util::non_dominated_sorting::fronts_type::size_type i = 0; i < feasible_fronts.size(); ++i) {
+		fronts.push_back(std::vector<size_type>());
+		for (std::vector<std::size_t>::size_type j = 0; j < feasible_fronts[i].size(); ++j) {
+			fronts.back().push_back(feasible[feasible_fronts[i][j]]);
+		}
+	}
+	if (infeasible.empty()) {
+		return;
+	}
+	const constraints_comp comp(*this);
+	std::stable_sort(infeasible.begin(),infeasible.end(),comp);
+	fronts.push_back(std::vector<size_type>(1,infeasible[0]));
+	for (std::vector<size_type>::size_type i = 1; i < infeasible.size(); ++i) {
+		if (comp(infeasible[i - 1],infeasible[i])) {
+			fronts.push_back(std::vector<size_type>());
+		}
+		fronts.back().push_back(infeasible[i]);
+	}
+}
+
 /// Computes and returns the population Pareto fronts
 /**
  * This method computes all Pareto Fronts of the population, returning the positional indices
@@ -677,6 +905,8 @@ bool population::trivial_comparison_operator::operator()(const size_type &idx1,
  * optimization from multiple objectives optimization.
  *
  * Single objective optimization: the comparison operator is the virtual method problem::compare_fc.
+ * The position is tracked as the individuals change, hence this method takes constant time unless the best or the worst
+ * individual has changed since the last call (in which case the population is scanned).
  *
  * Multi objective optimization: the crowded comparison operator is used. Note that with respect to
  * what originally defined by Deb in "A Fast and Elitist Multiobjective Genetic Algorithm: NSGA II",
@@ -694,14 +924,12 @@ population::size_type population::get_worst_idx() const
 	if (!size()) {
 		pagmo_throw(value_error,"empty population, cannot compute position of worst individual");
 	}
-	container_type::const_iterator it;
 	if (m_prob->get_f_dimension() == 1) {
-		it = std::max_element(m_container.begin(),m_container.end(),trivial_comparison_operator(*this));
-	}
-	else {
-		update_pareto_information();
-		it = std::max_element(m_container.begin(),m_container.end(),crowded_comparison_operator(*this));
+		update_extrema();
+		return m_worst_idx;
 	}
+	update_pareto_information();
+	const container_type::const_iterator it = std::max_element(m_container.begin(),m_container.end(),crowded_comparison_operator(*this));
 	return boost::numeric_cast<size_type>(std::distance(m_container.begin(),it));
 }
 
@@ -711,6 +939,8 @@ population::size_type population::get_worst_idx() const
  * optimization from multiple objectives optimization.
  *
  * Single objective optimization: the comparison operator is the virtual method problem::compare_fc.
+ * The position is tracked as the individuals change, hence this method takes constant time unless the best or the worst
+ * individual has changed since the last call (in which case the population is scanned).
  *
  * Multi objective optimization: the crowded comparison operator is used. Note that with respect to
  * what originally defined by Deb in "A Fast and Elitist Multiobjective Genetic Algorithm: NSGA II",
@@ -727,14 +957,13 @@ population::size_type population::get_best_idx() const
 	if (!size()) {
 		pagmo_throw(value_error,"empty population, cannot compute position of best individual");
 	}
-	container_type::const_iterator it;
 	if (m_prob->get_f_dimension() == 1) {
-		it = std::min_element(m_container.begin(),m_container.end(),trivial_comparison_operator(*this));
+		update_extrema();
+		return m_best_idx;
 	}
-	else {
-		update_pareto_information();
-		it = std::min_element(m_container.begin(),m_container.end(),crowded_comparison_operator(*this));
-	}	return boost::numeric_cast<size_type>(std::distance(m_container.begin(),it));
+	update_pareto_information();
+	const container_type::const_iterator it = std::min_element(m_container.begin(),m_container.end(),crowded_comparison_operator(*this));
+	return boost::numeric_cast<size_type>(std::distance(m_container.begin(),it));
 }
 
 /// Get positions of N best individuals.
@@ -850,6 +1079,7 @@ std::string population::human_readable() const
 	std::ostringstream oss;
 	oss << human_readable_terse();
 	if (size()) {
+		update_domination_information();
 		oss << "\nList of individuals:\n";
 		for (size_type i = 0; i < size(); ++i) {
 			oss << '#' << i << ":\n";
@@ -900,6 +1130,90 @@ void population::set_x(const size_type &idx, const decision_vector &x)
 	m_prob->objfun(m_container[idx].cur_f,x);
 	// Update current constraints vector.
 	m_prob->compute_constraints(m_container[idx].cur_c,x);
+	update_bests(idx);
+}
+
+/// Set the decision vector of individual at position idx to x, with known fitness and constraint vectors.
+/**
+ * Equivalent to set_x(idx,x), but f and c are used as fitness and constraint vectors of x instead of being computed via the problem.
+ * This is useful in algorithms which have already evaluated x (e.g., to compare a trial vector with the current individual),
+ * as it avoids a second evaluation (or a cache lookup) when the individual is committed to the population.
+ *
+ * It is responsibility of the caller to ensure that f and c are the fitness and constraint vectors of x as computed by the problem of the population
+ * (or by an equivalent one): only their dimensions are checked.
+ *
+ * @param[in] idx positional index of the individual to be set.
+ * @param[in] x decision vector to be set for the individual at position idx.
+ * @param[in] f fitness vector of x.
+ * @param[in] c constraint vector of x.
+ *
+ * @throws index_error if idx is out of range.
+ * @throws value_error if problem::base::verify_x() on x returns false, or if f or c have dimensions incompatible with the problem.
+ */
+void population::set_x(const size_type &idx, const decision_vector &x, const fitness_vector &f, const constraint_vector &c)
+{
+	if (idx >= size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	if (f.size() != m_prob->get_f_dimension()) {
+		pagmo_throw(value_error,"fitness vector is not compatible with problem");
+	}
+	if (c.size() != m_prob->get_c_dimension()) {
+		pagmo_throw(value_error,"constraint vector is not compatible with problem");
+	}
+	m_container[idx].cur_x = x;
+	m_container[idx].cur_f = f;
+	m_container[idx].cur_c = c;
+	update_bests(idx);
+}
+
+/// Set the individual at position idx.
+/**
+ * All the vectors of ind (current and best decision, velocity, fitness and constraint vectors) are committed to the individual
+ * at position idx at once and as they are, without any evaluation, after which the champion and the other information derived
+ * from the individuals are updated as in set_x(). This is useful in algorithms which keep track of both the current and the best
+ * positions of the individuals (e.g., algorithm::pso), as they can write back each individual with a single call.
+ *
+ * It is responsibility of the caller to ensure that the fitness and constraint vectors of ind are those of the corresponding
+ * decision vectors, as computed by the problem of the population (or by an equivalent one): only their dimensions are checked.
+ * If the current vectors of ind are better than its best vectors, the latter are replaced by the former.
+ *
+ * @param[in] idx positional index of the individual to be set.
+ * @param[in] ind individual to be set at position idx.
+ *
+ * @throws index_error if idx is out of range.
+ * @throws value_error if problem::base::verify_x() on the decision vectors of ind returns false, or if the other vectors of ind
+ * have dimensions incompatible with the problem.
+ */
+void population::set_individual(const size_type &idx, const individual_type &ind)
+{
+	if (idx >= size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	if (!m_prob->verify_x(ind.cur_x) || !m_prob->verify_x(ind.best_x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	if (ind.cur_v.size() != m_prob->get_dimension()) {
+		pagmo_throw(value_error,"velocity vector is not compatible with problem");
+	}
+	if (ind.cur_f.size() != m_prob->get_f_dimension() || ind.best_f.size() != m_prob->get_f_dimension()) {
+		pagmo_throw(value_error,"fitness vector is not compatible with problem");
+	}
+	if (ind.cur_c.size() != m_prob->get_c_dimension() || ind.best_c.size() != m_prob->get_c_dimension()) {
+		pagmo_throw(value_error,"constraint vector is not compatible with problem");
+	}
+	m_container[idx] = ind;
+	update_bests(idx);
+}
+
+// Update the best vectors of the individual at position idx, the champion and the domination lists after a change
+// in the current vectors of the individual.
+void population::update_bests(const size_type &idx)
+{
+	pagmo_assert(idx < m_container.size());
 	// If needed, update the best decision, fitness and constraint vectors for the individual.
 	// NOTE: we update the bests in two cases:
 	// - the bests are empty, meaning they are not defined and we are being called by push_back()
@@ -917,6 +1231,7 @@ void population::set_x(const size_type &idx, const decision_vector &x)
 	update_champion(idx);
 	// Updated domination lists.
 	update_dom(idx);
+	update_extrema(idx);
 }
 
 /// Erase individual idx
@@ -936,12 +1251,35 @@ void population::erase(const population::size_type & idx) {
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid individual position");
 	}
+	// The positions of the best and worst individuals are shifted along with the individuals.
+	if (m_extrema_dirty || m_extrema_size != m_container.size() || idx == m_best_idx || idx == m_worst_idx) {
+		m_extrema_dirty = true;
+	} else {
+		m_best_idx -= (m_best_idx > idx) ? 1u : 0u;
+		m_worst_idx -= (m_worst_idx > idx) ? 1u : 0u;
+		--m_extrema_size;
+	}
+	if (m_dom_all_dirty) {
+		// The domination information will be recomputed from scratch anyway.
+		m_container.erase(m_container.begin() + idx);
+		m_dom_count.erase(m_dom_count.begin() + idx);
+		m_dom_list.erase(m_dom_list.begin() + idx);
+		return;
+	}
 	for (population::size_type i = 0; i < m_dom_list[idx].size(); ++i) {
 		m_dom_count[m_dom_list[idx][i]]--;
 	}
 	m_container.erase(m_container.begin() + idx);
 	m_dom_count.erase(m_dom_count.begin() + idx);
 	m_dom_list.erase(m_dom_list.begin() + idx);
+	// Outdated individuals keep on being tracked by position.
+	std::vector<size_type>::iterator new_end = std::remove(m_dom_dirty.begin(),m_dom_dirty.end(),idx);
+	m_dom_dirty.erase(new_end,m_dom_dirty.end());
+	for (std::vector<size_type>::size_type i = 0; i < m_dom_dirty.size(); ++i) {
+		if (m_dom_dirty[i] > idx) {
+			m_dom_dirty[i]--;
+		}
+	}
 	// Since an element is erased indexes in dom_list need an update
 	for (population::size_type i=0; i<m_dom_list.size(); ++i){
 		for(population::size_type j=0; j<m_dom_list[i].size();++j) {
@@ -971,6 +1309,44 @@ void population::push_back(const decision_vector &x)
 		pagmo_throw(value_error,"decision vector is not compatible with problem");
 
 	}
+	append_individual();
+	// Set the individual.
+	set_x(m_container.size() - 1,x);
+	// Initialise randomly the velocity vector.
+	init_velocity(m_container.size() - 1);
+}
+
+/// Append individual with given decision vector, with known fitness and constraint vectors.
+/**
+ * Equivalent to push_back(x), but f and c are used as fitness and constraint vectors of x instead of being computed via the problem
+ * (see the corresponding overload of set_x()). This allows to append individuals evaluated in batch (e.g., via problem::base::batch_objfun()).
+ *
+ * @param[in] x decision vector of the individual to be appended.
+ * @param[in] f fitness vector of x.
+ * @param[in] c constraint vector of x.
+ *
+ * @throws value_error if problem::base::verify_x() on x returns false, or if f or c have dimensions incompatible with the problem.
+ */
+void population::push_back(const decision_vector &x, const fitness_vector &f, const constraint_vector &c)
+{
+	// NOTE: check everything before appending, so that the population is left untouched on failure.
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	if (f.size() != m_prob->get_f_dimension()) {
+		pagmo_throw(value_error,"fitness vector is not compatible with problem");
+	}
+	if (c.size() != m_prob->get_c_dimension()) {
+		pagmo_throw(value_error,"constraint vector is not compatible with problem");
+	}
+	append_individual();
+	set_x(m_container.size() - 1,x,f,c);
+	init_velocity(m_container.size() - 1);
+}
+
+// Append an empty individual, to be set via set_x().
+void population::append_individual()
+{
 	// Store sizes temporarily.
 	const fitness_vector::size_type f_size = m_prob->get_f_dimension();
 	const constraint_vector::size_type c_size = m_prob->get_c_dimension();
@@ -986,10 +1362,6 @@ void population::push_back(const decision_vector &x)
 	m_container.back().cur_f.resize(f_size);
 	// NOTE: do not allocate space for bests, as they are not defined yet. set_x will take
 	// care of it.
-	// Set the individual.
-	set_x(m_container.size() - 1,x);
-	// Initialise randomly the velocity vector.
-	init_velocity(m_container.size() - 1);
 }
 
 /// Set the velocity vector of individual at position idx.
@@ -1052,6 +1424,9 @@ void population::clear()
 	m_container.clear();
 	m_dom_list.clear();
 	m_dom_count.clear();
+	m_dom_dirty.clear();
+	m_dom_all_dirty = false;
+	m_extrema_dirty = true;
 	m_crowding_d.clear();
 	m_pareto_rank.clear();
 	m_champion = champion_type();
@@ -29,6 +29,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "config.h"
@@ -36,6 +37,7 @@
 #include "rng.h"
 #include "serialization.h"
 #include "types.h"
+#include "util/aligned_matrix.h"
 
 namespace pagmo
 {
@@ -62,6 +64,13 @@ typedef boost::shared_ptr<base> base_ptr;
  * (identified by their positional index in the population) which I dominates, and a 'domination count' containing the number
  * of individuals that dominate I. Individual I1 is dominated by individual I2 if problem::base::compare_fc
  * on the fitness and constraints vectors of I1 and I2 respectively returns true.
+ * Domination lists and counts are maintained lazily: modifying an individual only marks its domination information as outdated,
+ * and the information is brought up to date the first time it is needed (e.g., by get_domination_count() or update_pareto_information())
+ * or when update_domination_information() is called explicitly. Hence algorithms which never query the domination information (e.g.,
+ * single-objective algorithms) do not pay for its maintenance.
+ *
+ * The individuals are stored as separate vectors. For kernels sweeping over the whole population, get_soa() builds a read-only snapshot
+ * of their data in a structure-of-arrays layout, with one contiguous matrix per data member of individual_type.
  * The best/worst individuals in the population are computed according to the crowding distance operator (in case of multi-objective problems)
  *
  * @author Francesco Biscani (bluescarni@gmail.com)
@@ -185,6 +194,29 @@ class __PAGMO_VISIBLE population
 					boost::serialization::split_member(ar,*this,version);
 				}
 		};
+		/// Structure-of-arrays representation of the individuals.
+		/**
+		* Each data member is a matrix whose i-th row contains the homonymous data member of the i-th individual of the population,
+		* hence the matrices of decision and velocity vectors have as many columns as the problem dimension, the matrices of constraint vectors
+		* as many columns as the constraint dimension and the matrices of fitness vectors as many columns as the fitness dimension.
+		*/
+		struct soa_type
+		{
+				/// Current decision vectors.
+				util::aligned_matrix	cur_x;
+				/// Current velocity vectors.
+				util::aligned_matrix	cur_v;
+				/// Current constraint vectors.
+				util::aligned_matrix	cur_c;
+				/// Current fitness vectors.
+				util::aligned_matrix	cur_f;
+				/// Best decision vectors so far.
+				util::aligned_matrix	best_x;
+				/// Best constraint vectors so far.
+				util::aligned_matrix	best_c;
+				/// Best fitness vectors so far.
+				util::aligned_matrix	best_f;
+		};
 		/// Underlying container type.
 		typedef std::vector<individual_type> container_type;
 
@@ -200,6 +232,7 @@ class __PAGMO_VISIBLE population
 		population(const population &);
 		population &operator=(const population &);
 		const individual_type &get_individual(const size_type &) const;
+		soa_type get_soa() const;
 
 		// Multi-Objective stuff
 		const std::vector<size_type> &get_domination_list(const size_type &) const;
@@ -207,6 +240,7 @@ class __PAGMO_VISIBLE population
 		size_type get_pareto_rank(const size_type &) const;
 		double get_crowding_d(const size_type &) const;
 		void update_pareto_information() const;
+		void update_domination_information() const;
 		size_type n_dominated(const individual_type &) const;
 		std::vector<std::vector<size_type> > compute_pareto_fronts() const;
 		fitness_vector compute_ideal() const;
@@ -220,8 +254,11 @@ class __PAGMO_VISIBLE population
 		std::vector<size_type> get_best_idx(const size_type & N) const;
 		size_type get_worst_idx() const;
 		void set_x(const size_type &, const decision_vector &);
+		void set_x(const size_type &, const decision_vector &, const fitness_vector &, const constraint_vector &);
 		void set_v(const size_type &, const decision_vector &);
+		void set_individual(const size_type &, const individual_type &);
 		void push_back(const decision_vector &);
+		void push_back(const decision_vector &, const fitness_vector &, const constraint_vector &);
 		void erase(const size_type &);
 		size_type size() const;
 		const_iterator begin() const;
@@ -258,15 +295,69 @@ class __PAGMO_VISIBLE population
 			const population &m_pop;
 		};
 
+		/// Serialization proxy for the state of a population.
+		/**
+		 * The state of a population is everything but its problem: individuals, champion, domination information and random number generators.
+		 * Serializing a proxy instead of the population allows to exchange populations among processes which already hold a copy
+		 * of the problem (see pagmo::mpi_island). Upon loading, the individuals are not checked against the problem.
+		 *
+		 * The individuals can be kept out of the archive, so that they can be transferred by other means (e.g., through shared memory,
+		 * see pagmo::process_island): in such case, only their number is serialized and, upon loading, the individuals of the population
+		 * are replaced by the individuals transferred separately.
+		 */
+		class state_proxy
+		{
+			public:
+				/// Constructor from population.
+				/**
+				 * @param[in] pop population whose state will be serialized.
+				 */
+				explicit state_proxy(population &pop):m_pop(pop),m_individuals(0) {}
+				/// Constructor from population and individuals.
+				/**
+				 * The individuals are kept out of the archive. Upon saving, individuals is not used. Upon loading, the individuals of pop are
+				 * swapped with individuals, whose size must match the number of individuals in the archive.
+				 *
+				 * @param[in] pop population whose state will be serialized.
+				 * @param[in] individuals individuals of the population, transferred separately.
+				 */
+				state_proxy(population &pop, container_type &individuals):m_pop(pop),m_individuals(&individuals) {}
+			private:
+				friend class boost::serialization::access;
+				template <class Archive>
+				void save(Archive &ar, const unsigned int) const
+				{
+					m_pop.save_state(ar,m_individuals == 0);
+				}
+				template <class Archive>
+				void load(Archive &ar, const unsigned int)
+				{
+					m_pop.load_state(ar,m_individuals);
+				}
+				BOOST_SERIALIZATION_SPLIT_MEMBER()
+				population &m_pop;
+				container_type *m_individuals;
+		};
+
 	private:
+		void append_individual();
 		void init_velocity(const size_type &);
 		void update_champion(const size_type &);
+		void update_bests(const size_type &);
 
 		// Multi-objective stuff
 		void update_crowding_d(std::vector<size_type>) const;
+		void sort_fronts(std::vector<std::vector<size_type> > &) const;
+
+		void update_dom_impl(const size_type &) const;
+		void recompute_dom() const;
+
+		void update_extrema() const;
+
 
 	protected:
 		void update_dom(const size_type &);
+		void update_extrema(const size_type &);
 
 	private:
 		// Data members + their serialization
@@ -278,11 +369,80 @@ class __PAGMO_VISIBLE population
 			ar & m_container;
 			ar & m_dom_list;
 			ar & m_dom_count;
+			ar & m_dom_dirty;
+			ar & m_dom_all_dirty;
 			ar & m_pareto_rank;
 			ar & m_crowding_d;
 			ar & m_champion;
 			ar & m_drng;
 			ar & m_urng;
+			// The positions of the best and worst individuals are not serialized, they will be recomputed on demand.
+			if (Archive::is_loading::value) {
+				m_extrema_dirty = true;
+			}
+		}
+		// Serialization of the state of the population (see state_proxy).
+		template <class Archive>
+		void save_state(Archive &ar, bool with_individuals) const
+		{
+			if (with_individuals) {
+				ar << m_container;
+			} else {
+				const size_type size = m_container.size();
+				ar << size;
+			}
+			ar << m_dom_list;
+			ar << m_dom_count;
+			ar << m_dom_dirty;
+			ar << m_dom_all_dirty;
+			ar << m_pareto_rank;
+			ar << m_crowding_d;
+			ar << m_champion;
+			ar << m_drng;
+			ar << m_urng;
+		}
+		// The state is loaded into temporaries first, so that the population is left untouched if loading fails.
+		// If individuals is not null, the individuals are taken from it instead of the archive.
+		template <class Archive>
+		void load_state(Archive &ar, container_type *individuals)
+		{
+			container_type container;
+			std::vector<std::vector<size_type> > dom_list;
+			std::vector<size_type> dom_count, dom_dirty, pareto_rank;
+			bool dom_all_dirty;
+			std::vector<double> crowding_d;
+			champion_type champion;
+			rng_double drng;
+			rng_uint32 urng;
+			if (individuals) {
+				size_type size;
+				ar >> size;
+				if (size != individuals->size()) {
+					pagmo_throw(value_error,"the number of individuals does not match the state of the population");
+				}
+			} else {
+				ar >> container;
+			}
+			ar >> dom_list;
+			ar >> dom_count;
+			ar >> dom_dirty;
+			ar >> dom_all_dirty;
+			ar >> pareto_rank;
+			ar >> crowding_d;
+			ar >> champion;
+			ar >> drng;
+			ar >> urng;
+			m_container.swap(individuals ? *individuals : container);
+			m_dom_list.swap(dom_list);
+			m_dom_count.swap(dom_count);
+			m_dom_dirty.swap(dom_dirty);
+			m_dom_all_dirty = dom_all_dirty;
+			m_pareto_rank.swap(pareto_rank);
+			m_crowding_d.swap(crowding_d);
+			std::swap(m_champion,champion);
+			m_drng = drng;
+			m_urng = urng;
+			m_extrema_dirty = true;
 		}
 		// Problem.
 		problem::base_ptr				m_prob;
@@ -291,9 +451,9 @@ class __PAGMO_VISIBLE population
 		// the set_x mechanism avoiding function re-evaluations. (use this option at your own risk)
 		container_type					m_container;
 		// List of dominated individuals.
-		std::vector<std::vector<size_type> >		m_dom_list;
+		mutable std::vector<std::vector<size_type> >	m_dom_list;
 		// Domination Count (number of dominant individuals)
-		std::vector<size_type>				m_dom_count;
+		mutable std::vector<size_type>			m_dom_count;
 	private:
 		// Population champion.
 		champion_type					m_champion;
@@ -301,6 +461,18 @@ class __PAGMO_VISIBLE population
 		mutable std::vector<size_type>			m_pareto_rank;
 		// Crowding distance
 		mutable std::vector<double>			m_crowding_d;
+		// Positions of the individuals whose domination information is outdated (possibly with repetitions).
+		mutable std::vector<size_type>			m_dom_dirty;
+		// Flag signalling that the domination information of all individuals is outdated.
+		mutable bool					m_dom_all_dirty;
+		// Positions of the best and worst individuals in single-objective problems (see get_best_idx() and get_worst_idx()).
+		mutable size_type				m_best_idx;
+		mutable size_type				m_worst_idx;
+		// Size of the population when the positions of the best and worst individuals were last brought up to date: individuals
+		// appended afterwards, e.g., by derived classes, are not tracked.
+		mutable size_type				m_extrema_size;
+		// Flag signalling that the positions of the best and worst individuals must be recomputed from scratch.
+		mutable bool					m_extrema_dirty;
 		// Double precision random number generator.
 		mutable	rng_double				m_drng;
 		// uint32 random number generator.
@@ -321,6 +493,10 @@ struct __PAGMO_VISIBLE population_access
 
 }
 
+// The state proxy is a transient object: do not track it and do not store class information for it.
+BOOST_CLASS_IMPLEMENTATION(pagmo::population::state_proxy,boost::serialization::object_serializable)
+BOOST_CLASS_TRACKING(pagmo::population::state_proxy,boost::serialization::track_never)
+
 namespace boost { namespace serialization {
 
 template <class Archive>
@@ -88,6 +88,21 @@ std::string ackley::get_name() const
 	return "Ackley";
 }
 
+/// Thread safety of the problem.
+bool ackley::thread_safe() const
+{
+	return true;
+}
+
+/// Exact equality.
+/**
+ * The dimension is the only parameter of the problem.
+ */
+bool ackley::exact_equality() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::ackley)
@@ -54,6 +54,8 @@ class __PAGMO_VISIBLE ackley : public base
 		ackley(int = 1);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool thread_safe() const;
+		bool exact_equality() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 	private:
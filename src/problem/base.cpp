@@ -25,6 +25,7 @@
 // 30/01/10 Created by Francesco Biscani.
 
 #include <algorithm>
+#include <boost/bind.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/numeric/conversion/bounds.hpp>
 #include <boost/numeric/conversion/cast.hpp>
@@ -44,6 +45,7 @@
 #include "../exceptions.h"
 #include "../population.h"
 #include "../types.h"
+#include "../util/thread_pool.h"
 #include "base.h"
 
 namespace pagmo
@@ -66,10 +68,7 @@ base::base(int n, int ni, int nf, int nc, int nic, const double &c_tol): //TODO
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(nc,c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
@@ -87,11 +86,6 @@ base::base(int n, int ni, int nf, int nc, int nic, const double &c_tol): //TODO
 	m_ub.resize(size);
 	std::fill(m_lb.begin(),m_lb.end(),0);
 	std::fill(m_ub.begin(),m_ub.end(),1);
-	// Resize properly temporary fitness and constraint storage.
-	m_tmp_f1.resize(m_f_dimension);
-	m_tmp_f2.resize(m_f_dimension);
-	m_tmp_c1.resize(m_c_dimension);
-	m_tmp_c2.resize(m_c_dimension);
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -112,10 +106,7 @@ base::base(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
@@ -138,11 +129,6 @@ base::base(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_
 	m_ub.resize(size);
 	std::fill(m_lb.begin(),m_lb.end(),0);
 	std::fill(m_ub.begin(),m_ub.end(),1);
-	// Resize properly temporary fitness and constraint storage.
-	m_tmp_f1.resize(m_f_dimension);
-	m_tmp_f2.resize(m_f_dimension);
-	m_tmp_c1.resize(m_c_dimension);
-	m_tmp_c2.resize(m_c_dimension);
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -165,10 +151,7 @@ base::base(const double &l_value, const double &u_value, int n, int ni, int nf,
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(nc,c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
@@ -189,11 +172,6 @@ base::base(const double &l_value, const double &u_value, int n, int ni, int nf,
 	m_ub.resize(size);
 	std::fill(m_lb.begin(),m_lb.end(),l_value);
 	std::fill(m_ub.begin(),m_ub.end(),u_value);
-	// Resize properly temporary fitness and constraint storage.
-	m_tmp_f1.resize(m_f_dimension);
-	m_tmp_f2.resize(m_f_dimension);
-	m_tmp_c1.resize(m_c_dimension);
-	m_tmp_c2.resize(m_c_dimension);
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -216,10 +194,7 @@ base::base(const decision_vector &lb, const decision_vector &ub, int ni, int nf,
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(nc,c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
@@ -233,11 +208,6 @@ base::base(const decision_vector &lb, const decision_vector &ub, int ni, int nf,
 		pagmo_throw(value_error,"invalid dimension(s)");
 	}
 	construct_from_iterators(lb.begin(),lb.end(),ub.begin(),ub.end());
-	// Resize properly temporary fitness and constraint storage.
-	m_tmp_f1.resize(m_f_dimension);
-	m_tmp_f2.resize(m_f_dimension);
-	m_tmp_c1.resize(m_c_dimension);
-	m_tmp_c2.resize(m_c_dimension);
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -259,6 +229,72 @@ std::string base::get_name() const
 	return typeid(*this).name();
 }
 
+/// Thread safety of the problem.
+/**
+ * Return true if objfun_impl() and compute_constraints_impl() can be invoked concurrently on the same object from multiple threads,
+ * that is, if their implementations do not modify any data member. The bookkeeping performed by the base class (caching,
+ * evaluation counters) is always safe to use concurrently, hence the evaluation methods (objfun(), compute_constraints(),
+ * batch_objfun(), compare_x(), etc.) of a thread-safe problem can be called concurrently. Parallel evaluators can use this
+ * information to share a single problem object among threads rather than working on clones.
+ *
+ * The default implementation returns false. Derived problems whose evaluation is reentrant should override this method.
+ *
+ * @return true if the problem can be evaluated concurrently, false otherwise.
+ */
+bool base::thread_safe() const
+{
+	return false;
+}
+
+/// Parallel batch evaluation.
+/**
+ * Return true if the default implementations of batch_objfun_impl() and batch_compute_constraints_impl() can evaluate the batches
+ * in parallel on the threads of the process-wide util::thread_pool, false if objfun_impl() and compute_constraints_impl() must
+ * be invoked only from the thread evaluating the batch (e.g., because they call into an interpreter).
+ *
+ * The default implementation returns true.
+ *
+ * @return true if batches can be evaluated in parallel, false otherwise.
+ */
+bool base::parallel_batch() const
+{
+	return true;
+}
+
+/// Standard dominance.
+/**
+ * Return true if compare_fc() implements the standard constrained Pareto dominance, that is, if compare_fitness_impl(),
+ * compare_constraints_impl() and compare_fc_impl() have their default implementations. In this case, the domination relation among
+ * many individuals can be computed with algorithms much faster than the pairwise comparison of all the individuals (see population::update_pareto_information()
+ * and util::non_dominated_sorting).
+ *
+ * The default implementation returns false, as the comparison methods might be reimplemented in derived classes. Derived problems
+ * which do not reimplement them can override this method to return true.
+ *
+ * @return true if the standard Pareto dominance is used to compare individuals, false otherwise.
+ */
+bool base::standard_dominance() const
+{
+	return false;
+}
+
+/// Exact equality.
+/**
+ * Return true if operator==() takes into account all the parameters affecting the objective function and the constraints, so that
+ * two equal problems are guaranteed to return the same fitness and constraint vectors for any decision vector. The archipelago relies on
+ * this property to avoid re-evaluating individuals migrating among islands holding equal problems.
+ *
+ * The default implementation returns false, as the default equality operator checks only the type and the dimensions of the problems.
+ * Deterministic problems whose parameters are all compared by equality_operator_extra() (or which have no parameters besides
+ * the dimensions) can override this method to return true.
+ *
+ * @return true if equal problems have the same objective function and constraints, false otherwise.
+ */
+bool base::exact_equality() const
+{
+	return false;
+}
+
 /// Lower bounds getter.
 /**
  * @return const reference to the lower bounds vector.
@@ -445,6 +481,7 @@ void base::set_ub(const double &value)
  */
 unsigned int base::get_fevals() const
 {
+	lock_type lock(m_eval_mutex.m_mutex);
 	return m_fevals;
 }
 
@@ -454,9 +491,37 @@ unsigned int base::get_fevals() const
  */
 unsigned int base::get_cevals() const
 {
+	lock_type lock(m_eval_mutex.m_mutex);
 	return m_cevals;
 }
 
+/// Account for function evaluations performed elsewhere.
+/**
+ * Increase the number of function evaluations by n. Islands and algorithms evaluating the objective function on copies of the problem
+ * (e.g., in other processes) use this method to report those evaluations to the original problem.
+ *
+ * @param[in] n number of function evaluations performed on copies of the problem.
+ */
+void base::add_fevals(unsigned int n) const
+{
+	lock_type lock(m_eval_mutex.m_mutex);
+	m_fevals += n;
+}
+
+/// Account for constraints function evaluations performed elsewhere.
+/**
+ * Increase the number of constraints function evaluations by n.
+ *
+ * @param[in] n number of constraints function evaluations performed on copies of the problem.
+ *
+ * @see add_fevals().
+ */
+void base::add_cevals(unsigned int n) const
+{
+	lock_type lock(m_eval_mutex.m_mutex);
+	m_cevals += n;
+}
+
 
 /// Return global dimension.
 /**
@@ -571,40 +636,130 @@ void base::objfun(fitness_vector &f, const decision_vector &x) const
 		pagmo_throw(value_error,"wrong decision vector size when calling objective function");
 	}
 	// Look into the cache.
-	typedef decision_vector_cache_type::iterator x_iterator;
-	typedef fitness_vector_cache_type::iterator f_iterator;
-	const x_iterator x_it = std::find(m_decision_vector_cache_f.begin(),m_decision_vector_cache_f.end(),x);
-	if (x_it == m_decision_vector_cache_f.end()) {
-		// Fitness is not into memory. Calculate it.
+	boost::unique_lock<boost::mutex> lock(m_eval_mutex.m_mutex);
+	if (!m_fitness_cache.find(x,f)) {
+		// Fitness is not into memory. Calculate it, without holding the lock.
+		lock.unlock();
 		objfun_impl(f,x);
-		// Increase function evaluation counter.
-		m_fevals++;
 		// Make sure that the implementation of objfun_impl() in the derived class did not fuck up the dimension of the fitness vector.
 		if (f.size() != m_f_dimension) {
 			pagmo_throw(value_error,"fitness dimension was changed inside objfun_impl()");
 		}
-		// Store the decision vector and the newly-calculated fitness in the front of the buffers.
-		m_decision_vector_cache_f.push_front(x);
-		m_fitness_vector_cache.push_front(f);
-	} else {
-		// Compute the corresponding iterator in the fitness vector cache.
-		f_iterator f_it = m_fitness_vector_cache.begin();
-		std::advance(f_it,std::distance(m_decision_vector_cache_f.begin(),x_it));
-		pagmo_assert(f_it != m_fitness_vector_cache.end());
-		// Assign to the fitness vector the value in the cache.
-		f = *f_it;
-		// Move the content of the current positions to the front of the buffers, and shift everything else down
-		// by one position.
-		x_iterator tmp_x_it = m_decision_vector_cache_f.begin();
-		f_iterator tmp_f_it = m_fitness_vector_cache.begin();
-		while (x_it != tmp_x_it) {
-			x_it->swap(*tmp_x_it);
-			f_it->swap(*tmp_f_it);
-			++tmp_x_it;
-			++tmp_f_it;
+		lock.lock();
+		// Increase function evaluation counter.
+		m_fevals++;
+		// Store the decision vector and the newly-calculated fitness in the cache.
+		m_fitness_cache.insert(x,f);
+	}
+}
+
+/// Write fitnesses of a batch of pagmo::decision_vector into a vector of pagmo::fitness_vector.
+/**
+ * f will be resized to the size of x, and f[i] will contain the fitness of x[i]. Decision vectors whose fitness is found in the
+ * internal cache are not re-evaluated, the remaining ones are passed all together to batch_objfun_impl(). The function evaluation
+ * counter is increased by the number of decision vectors actually evaluated.
+ *
+ * @param[out] f vector of fitness vectors to which the fitnesses of x will be written.
+ * @param[in] x decision vectors whose fitnesses will be calculated.
+ *
+ * @throws value_error if the dimension of any element of x is different from the problem dimension, or if batch_objfun_impl()
+ * alters the sizes of the fitness vectors.
+ */
+void base::batch_objfun(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	typedef std::vector<decision_vector>::size_type batch_size_type;
+	for (batch_size_type i = 0; i < x.size(); ++i) {
+		if (x[i].size() != get_dimension()) {
+			pagmo_throw(value_error,"wrong decision vector size when calling batch objective function");
+		}
+	}
+	f.resize(x.size());
+	// Fill in what we find in the cache, and collect the rest for evaluation.
+	std::vector<decision_vector> x_eval;
+	std::vector<batch_size_type> idx_eval;
+	boost::unique_lock<boost::mutex> lock(m_eval_mutex.m_mutex);
+	for (batch_size_type i = 0; i < x.size(); ++i) {
+		if (!m_fitness_cache.find(x[i],f[i])) {
+			f[i].resize(m_f_dimension);
+			x_eval.push_back(x[i]);
+			idx_eval.push_back(i);
 		}
-		pagmo_assert(tmp_f_it == f_it);
 	}
+	lock.unlock();
+	if (x_eval.empty()) {
+		return;
+	}
+	std::vector<fitness_vector> f_eval(x_eval.size(),fitness_vector(m_f_dimension));
+	batch_objfun_impl(f_eval,x_eval);
+	if (f_eval.size() != x_eval.size()) {
+		pagmo_throw(value_error,"batch size was changed inside batch_objfun_impl()");
+	}
+	for (batch_size_type i = 0; i < x_eval.size(); ++i) {
+		if (f_eval[i].size() != m_f_dimension) {
+			pagmo_throw(value_error,"fitness dimension was changed inside batch_objfun_impl()");
+		}
+	}
+	lock.lock();
+	m_fevals += boost::numeric_cast<unsigned int>(x_eval.size());
+	for (batch_size_type i = 0; i < x_eval.size(); ++i) {
+		f[idx_eval[i]].swap(f_eval[i]);
+		m_fitness_cache.insert(x_eval[i],f[idx_eval[i]]);
+	}
+}
+
+/// Batch objective function implementation.
+/**
+ * Takes a vector of pagmo::decision_vector x as input and writes the corresponding fitnesses into f, which is guaranteed
+ * to have the same size as x and to contain fitness vectors of the correct dimension. This function is not to be called directly,
+ * it is invoked by batch_objfun() after the decision vectors have been checked and looked up in the cache.
+ *
+ * The default implementation splits x in as many contiguous blocks as there are threads in util::thread_pool::get_default(),
+ * and evaluates the blocks in parallel via objfun_impl(). If parallel_batch() returns false, or if the pool has no running threads
+ * (as in a forked child process), x is evaluated serially in the calling thread and no clone is created. Otherwise, if thread_safe()
+ * returns true, all the blocks are evaluated by this, else the first block is evaluated by this and the others by clones of this, so that objective functions using mutable
+ * data members can be safely evaluated concurrently.
+ *
+ * @param[out] f fitness vectors into which the fitnesses of x will be written.
+ * @param[in] x decision vectors whose fitnesses will be calculated.
+ */
+void base::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	pagmo_assert(f.size() == x.size());
+	util::thread_pool &pool = util::thread_pool::get_default();
+	const std::size_t n_blocks = parallel_batch() ? std::min<std::size_t>(x.size(),pool.size()) : 1u;
+	if (n_blocks < 2u) {
+		for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+			objfun_impl(f[i],x[i]);
+		}
+		return;
+	}
+	const std::vector<base_ptr> clones = batch_clones(n_blocks);
+	pool.parallel_for(n_blocks,boost::bind(&base::batch_objfun_block,this,boost::ref(f),boost::cref(x),boost::cref(clones),_1));
+}
+
+// Evaluate the b-th block of a batch, as partitioned by batch_objfun_impl().
+void base::batch_objfun_block(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x, const std::vector<base_ptr> &clones, std::size_t b) const
+{
+	const std::size_t n_blocks = clones.size() + 1u, begin = (x.size() * b) / n_blocks, end = (x.size() * (b + 1u)) / n_blocks;
+	const base *prob = (b && clones[b - 1u]) ? clones[b - 1u].get() : this;
+	for (std::size_t i = begin; i < end; ++i) {
+		prob->objfun_impl(f[i],x[i]);
+	}
+}
+
+// Problems used by the default batch evaluation for all the blocks but the first one, which is always evaluated by this.
+// Thread-safe problems are shared (the vector is filled with null pointers). Otherwise clones are created serially,
+// before the parallel section starts, as copying this concurrently to its evaluation would not be safe.
+std::vector<base_ptr> base::batch_clones(std::size_t n_blocks) const
+{
+	pagmo_assert(n_blocks > 0u);
+	std::vector<base_ptr> retval(n_blocks - 1u);
+	if (!thread_safe()) {
+		for (std::size_t i = 0; i < retval.size(); ++i) {
+			retval[i] = clone();
+		}
+	}
+	return retval;
 }
 
 /// Compare fitness vectors.
@@ -758,18 +913,15 @@ bool base::is_compatible(const base &p) const
  */
 bool base::compare_x(const decision_vector &x1, const decision_vector &x2) const
 {
-	// Make sure the size of the tmp fitness vectors are suitable.
-	pagmo_assert(m_tmp_f1.size() == m_f_dimension && m_tmp_f2.size() == m_f_dimension);
-	// Store fitnesses into temporary space.
-	objfun(m_tmp_f1,x1);
-	objfun(m_tmp_f2,x2);
-	// Make sure the size of the tmp constraint vectors are suitable.
-	pagmo_assert(m_tmp_c1.size() == m_c_dimension && m_tmp_c2.size() == m_c_dimension);
-	// Store constraint vector into temporary space.
-	compute_constraints(m_tmp_c1,x1);
-	compute_constraints(m_tmp_c2,x2);
+	// NOTE: temporary storage is local, so that this method can be called concurrently.
+	fitness_vector f1(m_f_dimension), f2(m_f_dimension);
+	constraint_vector c1(m_c_dimension), c2(m_c_dimension);
+	objfun(f1,x1);
+	objfun(f2,x2);
+	compute_constraints(c1,x1);
+	compute_constraints(c2,x2);
 	// Call the comparison implementation.
-	return compare_fc(m_tmp_f1,m_tmp_c1,m_tmp_f2,m_tmp_c2);
+	return compare_fc(f1,c1,f2,c2);
 }
 
 /// Simultaneous fitness-constraint comparison.
@@ -881,38 +1033,19 @@ void base::compute_constraints(constraint_vector &c, const decision_vector &x) c
 		return;
 	}
 	// Look into the cache.
-	typedef decision_vector_cache_type::iterator x_iterator;
-	typedef constraint_vector_cache_type::iterator c_iterator;
-	const x_iterator x_it = std::find(m_decision_vector_cache_c.begin(),m_decision_vector_cache_c.end(),x);
-	if (x_it == m_decision_vector_cache_c.end()) {
-		// Constraint vector is not into memory. Calculate it.
+	boost::unique_lock<boost::mutex> lock(m_eval_mutex.m_mutex);
+	if (!m_constraint_cache.find(x,c)) {
+		// Constraint vector is not into memory. Calculate it, without holding the lock.
+		lock.unlock();
 		compute_constraints_impl(c,x);
-		m_cevals++;
 		// Make sure c was not fucked up in the implementation of constraints calculation.
 		if (c.size() != get_c_dimension()) {
 			pagmo_throw(value_error,"constraints dimension was changed inside compute_constraints_impl()");
 		}
-		// Store the decision vector and the newly-calculated constraint vector in the front of the buffers.
-		m_decision_vector_cache_c.push_front(x);
-		m_constraint_vector_cache.push_front(c);
-	} else {
-		// Compute the corresponding iterator in the constraint vector cache.
-		c_iterator c_it = m_constraint_vector_cache.begin();
-		std::advance(c_it,std::distance(m_decision_vector_cache_c.begin(),x_it));
-		pagmo_assert(c_it != m_constraint_vector_cache.end());
-		// Assign to the fitness vector the value in the cache.
-		c = *c_it;
-		// Move the content of the current positions to the front of the buffers, and shift everything else down
-		// by one position.
-		x_iterator tmp_x_it = m_decision_vector_cache_c.begin();
-		c_iterator tmp_c_it = m_constraint_vector_cache.begin();
-		while (x_it != tmp_x_it) {
-			x_it->swap(*tmp_x_it);
-			c_it->swap(*tmp_c_it);
-			++tmp_x_it;
-			++tmp_c_it;
-		}
-		pagmo_assert(tmp_c_it == c_it);
+		lock.lock();
+		m_cevals++;
+		// Store the decision vector and the newly-calculated constraint vector in the cache.
+		m_constraint_cache.insert(x,c);
 	}
 }
 
@@ -936,6 +1069,104 @@ constraint_vector base::compute_constraints(const decision_vector &x) const
 	return c;
 }
 
+/// Compute constraints of a batch of decision vectors.
+/**
+ * c will be resized to the size of x, and c[i] will contain the constraint vector of x[i]. Decision vectors whose constraints are
+ * found in the internal cache are not re-evaluated, the remaining ones are passed all together to batch_compute_constraints_impl().
+ * The constraints evaluation counter is increased by the number of decision vectors actually evaluated.
+ *
+ * @param[out] c vector of pagmo::constraint_vector into which the constraints will be written.
+ * @param[in] x decision vectors whose constraints will be computed.
+ *
+ * @throws value_error if the dimension of any element of x is different from the problem dimension, or if
+ * batch_compute_constraints_impl() alters the sizes of the constraint vectors.
+ */
+void base::batch_compute_constraints(std::vector<constraint_vector> &c, const std::vector<decision_vector> &x) const
+{
+	typedef std::vector<decision_vector>::size_type batch_size_type;
+	for (batch_size_type i = 0; i < x.size(); ++i) {
+		if (x[i].size() != get_dimension()) {
+			pagmo_throw(value_error,"invalid decision vector size during batch constraint computation");
+		}
+	}
+	c.resize(x.size());
+	// Do not do anything else if constraints size is 0.
+	if (!m_c_dimension) {
+		for (batch_size_type i = 0; i < x.size(); ++i) {
+			c[i].clear();
+		}
+		return;
+	}
+	// Fill in what we find in the cache, and collect the rest for evaluation.
+	std::vector<decision_vector> x_eval;
+	std::vector<batch_size_type> idx_eval;
+	boost::unique_lock<boost::mutex> lock(m_eval_mutex.m_mutex);
+	for (batch_size_type i = 0; i < x.size(); ++i) {
+		if (!m_constraint_cache.find(x[i],c[i])) {
+			c[i].resize(m_c_dimension);
+			x_eval.push_back(x[i]);
+			idx_eval.push_back(i);
+		}
+	}
+	lock.unlock();
+	if (x_eval.empty()) {
+		return;
+	}
+	std::vector<constraint_vector> c_eval(x_eval.size(),constraint_vector(m_c_dimension));
+	batch_compute_constraints_impl(c_eval,x_eval);
+	if (c_eval.size() != x_eval.size()) {
+		pagmo_throw(value_error,"batch size was changed inside batch_compute_constraints_impl()");
+	}
+	for (batch_size_type i = 0; i < x_eval.size(); ++i) {
+		if (c_eval[i].size() != m_c_dimension) {
+			pagmo_throw(value_error,"constraints dimension was changed inside batch_compute_constraints_impl()");
+		}
+	}
+	lock.lock();
+	m_cevals += boost::numeric_cast<unsigned int>(x_eval.size());
+	for (batch_size_type i = 0; i < x_eval.size(); ++i) {
+		c[idx_eval[i]].swap(c_eval[i]);
+		m_constraint_cache.insert(x_eval[i],c[idx_eval[i]]);
+	}
+}
+
+/// Implementation of batch constraint computation.
+/**
+ * Takes a vector of pagmo::decision_vector x as input and writes the corresponding constraint vectors into c, which is guaranteed
+ * to have the same size as x and to contain constraint vectors of the correct dimension. This function is not to be called directly,
+ * it is invoked by batch_compute_constraints() after the decision vectors have been checked and looked up in the cache.
+ *
+ * The default implementation evaluates the batch in parallel via compute_constraints_impl(), following the same scheme
+ * as batch_objfun_impl().
+ *
+ * @param[out] c constraint vectors into which the constraints of x will be written.
+ * @param[in] x decision vectors whose constraints will be computed.
+ */
+void base::batch_compute_constraints_impl(std::vector<constraint_vector> &c, const std::vector<decision_vector> &x) const
+{
+	pagmo_assert(c.size() == x.size());
+	util::thread_pool &pool = util::thread_pool::get_default();
+	const std::size_t n_blocks = parallel_batch() ? std::min<std::size_t>(x.size(),pool.size()) : 1u;
+	if (n_blocks < 2u) {
+		for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+			compute_constraints_impl(c[i],x[i]);
+		}
+		return;
+	}
+	const std::vector<base_ptr> clones = batch_clones(n_blocks);
+	pool.parallel_for(n_blocks,boost::bind(&base::batch_compute_constraints_block,this,boost::ref(c),boost::cref(x),boost::cref(clones),_1));
+}
+
+// Evaluate the constraints of the b-th block of a batch, as partitioned by batch_compute_constraints_impl().
+void base::batch_compute_constraints_block(std::vector<constraint_vector> &c, const std::vector<decision_vector> &x, const std::vector<base_ptr> &clones, std::size_t b) const
+{
+	const std::size_t n_blocks = clones.size() + 1u, begin = (x.size() * b) / n_blocks, end = (x.size() * (b + 1u)) / n_blocks;
+	const base *prob = (b && clones[b - 1u]) ? clones[b - 1u].get() : this;
+	for (std::size_t i = begin; i < end; ++i) {
+		prob->compute_constraints_impl(c[i],x[i]);
+	}
+}
+
 /// Test feasibility of decision vector.
 /**
  * This method will compute the constraint vector associated to x and test it with feasibility_c().
@@ -946,9 +1177,9 @@ constraint_vector base::compute_constraints(const decision_vector &x) const
  */
 bool base::feasibility_x(const decision_vector &x) const
 {
-	// Compute the constraints and store internally.
-	compute_constraints(m_tmp_c1,x);
-	return feasibility_c(m_tmp_c1);
+	constraint_vector c(m_c_dimension);
+	compute_constraints(c,x);
+	return feasibility_c(c);
 }
 
 /// Test i-th constraint of c (using tolerance information).
@@ -1408,14 +1639,60 @@ void base::post_evolution(population &pop) const
  * This method will reset the internal caches used when (re)evaluating decision vectors for fitnesses and/or constraints.
  * It should be called whenever a modification to the internal state of the problem makes the cached values invalid (e.g.,
  * changing the seed in a stochastic optimization problem might change the way decision vectors are evaluated, thus
- * rendering invalid previously-calculated values).
+ * rendering invalid previously-calculated values). The capacity of the caches and their hit/miss statistics are preserved.
  */
 void base::reset_caches() const
 {
-	m_decision_vector_cache_f = decision_vector_cache_type(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity));
-	m_fitness_vector_cache = fitness_vector_cache_type(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity));
-	m_decision_vector_cache_c = decision_vector_cache_type(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity));
-	m_constraint_vector_cache = constraint_vector_cache_type(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity));
+	lock_type lock(m_eval_mutex.m_mutex);
+	m_fitness_cache.clear();
+	m_constraint_cache.clear();
+}
+
+/// Get cache capacity.
+/**
+ * @return the maximum number of decision vectors whose fitness (and, separately, whose constraints) are remembered.
+ */
+std::size_t base::get_cache_capacity() const
+{
+	lock_type lock(m_eval_mutex.m_mutex);
+	return m_fitness_cache.get_capacity();
+}
+
+/// Set cache capacity.
+/**
+ * Set the maximum number of decision vectors whose fitness (and, separately, whose constraints) are remembered.
+ * Larger caches are useful when algorithms tend to re-submit previously evaluated decision vectors after many other evaluations
+ * (e.g., rejected moves in simulated annealing, or re-inserted migrants). The cost of a cache lookup does not depend on the capacity.
+ * If the new capacity is smaller than the number of stored entries, the least recently used ones are discarded.
+ * A null capacity disables caching.
+ *
+ * @param[in] n new capacity of the caches.
+ */
+void base::set_cache_capacity(std::size_t n)
+{
+	lock_type lock(m_eval_mutex.m_mutex);
+	m_fitness_cache.set_capacity(n);
+	m_constraint_cache.set_capacity(n);
+}
+
+/// Get number of cache hits.
+/**
+ * @return the number of fitness and constraint computations that were served by the caches.
+ */
+std::size_t base::get_cache_hits() const
+{
+	lock_type lock(m_eval_mutex.m_mutex);
+	return m_fitness_cache.get_hits() + m_constraint_cache.get_hits();
+}
+
+/// Get number of cache misses.
+/**
+ * @return the number of fitness and constraint computations that were not found in the caches.
+ */
+std::size_t base::get_cache_misses() const
+{
+	lock_type lock(m_eval_mutex.m_mutex);
+	return m_fitness_cache.get_misses() + m_constraint_cache.get_misses();
 }
 
 }} //namespaces
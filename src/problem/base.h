@@ -32,18 +32,21 @@
 // #define BOOST_CB_DISABLE_DEBUG 
 
 #include <algorithm>
-#include <boost/circular_buffer.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <cstddef>
 #include <iostream>
 #include <iterator>
 #include <string>
+#include <vector>
 
 #include "../config.h"
 #include "../exceptions.h"
 #include "../serialization.h"
 #include "../types.h"
+#include "../util/lru_cache.h"
 //#include "base_meta.h"
 
 namespace pagmo
@@ -108,14 +111,33 @@ typedef boost::shared_ptr<base> base_ptr;
  *   than the second one, false otherwise),
  * - compute_constraints_impl(), to calculate the constraint vector associated to a decision vector,
  * - compare_constraints_impl(), to compare two constraint vectors,
- * - compare_fc_impl(), to perform a simultaneous fitness/constraint vector pairs comparison.
+ * - compare_fc_impl(), to perform a simultaneous fitness/constraint vector pairs comparison,
+ * - batch_objfun_impl() and batch_compute_constraints_impl(), to evaluate many decision vectors at once.
  *
  * Please note that while a problem is intended to provide methods for ranking decision and constraint vectors, such methods are not to be used
  * mandatorily by an algorithm: each algorithm can decide to use its own ranking schemes during an optimisation. The ranking methods provided
  * by the problem are always used instead during the migration of decision vectors from one island to the other.
  *
  * \section Caching
- * A caching mechanism is implemented to make sure the objective function is never evaluated twice on the very same chromosome
+ * A caching mechanism is implemented to make sure the objective function is never evaluated twice on the very same chromosome.
+ * The most recently evaluated decision vectors are stored, together with their fitness and constraint vectors, in two least-recently-used
+ * caches indexed by a hash of the decision vector (see util::lru_cache), so that a lookup costs the same regardless of the cache size.
+ * The capacity of the caches defaults to cache_capacity and can be changed with set_cache_capacity(). The number of
+ * lookups that avoided (or required) an evaluation is reported by get_cache_hits() (or get_cache_misses()).
+ *
+ * \section thread_safety Thread safety
+ * The caches and the evaluation counters are protected by a mutex, and no other data member is modified during evaluation. Hence the
+ * evaluation methods of a problem can be called concurrently from multiple threads, provided that the implementations of objfun_impl() and
+ * compute_constraints_impl() are reentrant. Derived problems declare this property by reimplementing thread_safe() to return true.
+ *
+ * \section batch_evaluation Batch evaluation
+ * The batch_objfun() and batch_compute_constraints() methods evaluate a whole set of decision vectors at once. Their default implementations,
+ * batch_objfun_impl() and batch_compute_constraints_impl(), split the batch in contiguous blocks which are evaluated in parallel
+ * on the process-wide util::thread_pool, each block working on its own clone() of the problem (or on the problem itself, if it is thread-safe). Problems that can evaluate
+ * many decision vectors more efficiently than one at a time (e.g., by vectorising the computation or by offloading it to an external
+ * resource) can reimplement these two virtual methods. Problems whose objective function cannot be invoked from a thread other than
+ * the calling one (e.g., problems implemented in Python) should reimplement parallel_batch() to return false: the default
+ * implementations will then evaluate the batches serially in the calling thread.
  *
  * \section Serialization
  * The problem classes are serialized for the purpose of transmitting their corresponding objects over a distributed environment, as being part of the population class.
@@ -149,12 +171,22 @@ class __PAGMO_VISIBLE base
 {
 		// Meta problems need to be able to access protected virtual functions
 		friend class base_meta;
-		// Underlying containers used for caching decision and fitness vectors.
-		typedef boost::circular_buffer<decision_vector> decision_vector_cache_type;
-		typedef boost::circular_buffer<fitness_vector> fitness_vector_cache_type;
-		typedef boost::circular_buffer<constraint_vector> constraint_vector_cache_type;
+		// Underlying container used for caching fitness and constraint vectors.
+		typedef util::lru_cache cache_type;
+		// Mutex guarding the evaluation bookkeeping. It is not copied along with the problem: each copy gets its own.
+		struct eval_mutex_type
+		{
+			eval_mutex_type() {}
+			eval_mutex_type(const eval_mutex_type &) {}
+			eval_mutex_type &operator=(const eval_mutex_type &)
+			{
+				return *this;
+			}
+			boost::mutex m_mutex;
+		};
+		typedef boost::lock_guard<boost::mutex> lock_type;
 	public:
-		/// Capacity of the internal caches.
+		/// Default capacity of the internal caches.
 		static const std::size_t cache_capacity = 5;
 		/// Problem's size type: the same as pagmo::decision_vector's size type.
 		typedef decision_vector::size_type size_type;
@@ -187,10 +219,7 @@ class __PAGMO_VISIBLE base
 			m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 			m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 			m_c_tol(nc,c_tol),
-			m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-			m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity))
+			m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity)
 		{
 			if (c_tol < 0) {
 				pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -205,11 +234,6 @@ class __PAGMO_VISIBLE base
 			if (m_i_dimension > m_lb.size()) {
 				pagmo_throw(value_error,"integer dimension must not be greater than global dimension");
 			}
-			// Resize properly temporary fitness and constraint storage.
-			m_tmp_f1.resize(m_f_dimension);
-			m_tmp_f2.resize(m_f_dimension);
-			m_tmp_c1.resize(m_c_dimension);
-			m_tmp_c2.resize(m_c_dimension);
 			// Normalise bounds.
 			normalise_bounds();
 		}
@@ -236,10 +260,7 @@ class __PAGMO_VISIBLE base
 			m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 			m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 			m_c_tol(nc,c_tol),
-			m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-			m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity))
+			m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity)
 		{
 			if (c_tol < 0) {
 				pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -254,11 +275,6 @@ class __PAGMO_VISIBLE base
 			if (m_i_dimension > m_lb.size()) {
 				pagmo_throw(value_error,"integer dimension must not be greater than global dimension");
 			}
-			// Properly resize temporary fitness and constraint storage.
-			m_tmp_f1.resize(m_f_dimension);
-			m_tmp_f2.resize(m_f_dimension);
-			m_tmp_c1.resize(m_c_dimension);
-			m_tmp_c2.resize(m_c_dimension);
 			// Normalise bounds.
 			normalise_bounds();
 		}
@@ -403,6 +419,8 @@ class __PAGMO_VISIBLE base
 		//@{
 		unsigned int get_fevals() const;
 		unsigned int get_cevals() const;
+		void add_fevals(unsigned int) const;
+		void add_cevals(unsigned int) const;
 		size_type get_dimension() const;
 		size_type get_i_dimension() const;
 		f_size_type get_f_dimension() const;
@@ -411,9 +429,23 @@ class __PAGMO_VISIBLE base
 		const std::vector<double>& get_c_tol() const;
 		double get_diameter() const;
 		virtual std::string get_name() const;
+		virtual bool thread_safe() const;
+		virtual bool parallel_batch() const;
+		virtual bool standard_dominance() const;
+		virtual bool exact_equality() const;
+		//@}
+		/** @name Cache handling.
+		 * Methods used to configure and inspect the evaluation caches.
+		 */
+		//@{
+		std::size_t get_cache_capacity() const;
+		void set_cache_capacity(std::size_t);
+		std::size_t get_cache_hits() const;
+		std::size_t get_cache_misses() const;
 		//@}
 		constraint_vector compute_constraints(const decision_vector &) const;
 		void compute_constraints(constraint_vector &, const decision_vector &) const;
+		void batch_compute_constraints(std::vector<constraint_vector> &, const std::vector<decision_vector> &) const;
 		bool compare_constraints(const constraint_vector &, const constraint_vector &) const;
 		bool test_constraint(const constraint_vector &, const c_size_type &) const;
 		bool feasibility_x(const decision_vector &) const;
@@ -442,6 +474,7 @@ return base_ptr(new derived_problem(*this));
 	protected:
 		virtual bool equality_operator_extra(const base &) const;
 		virtual void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		virtual void batch_compute_constraints_impl(std::vector<constraint_vector> &, const std::vector<decision_vector> &) const;
 		virtual bool compare_constraints_impl(const constraint_vector &, const constraint_vector &) const;
 		virtual bool compare_fc_impl(const fitness_vector &, const constraint_vector &, const fitness_vector &, const constraint_vector &) const;
 		void estimate_sparsity(const decision_vector &, int& lenG, std::vector<int>& iGfun, std::vector<int>& jGvar) const;
@@ -454,6 +487,7 @@ return base_ptr(new derived_problem(*this));
 		//@{
 		fitness_vector objfun(const decision_vector &) const;
 		void objfun(fitness_vector &, const decision_vector &) const;
+		void batch_objfun(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
 		bool compare_fitness(const fitness_vector &, const fitness_vector &) const;
 		void reset_caches() const;
 	public:
@@ -472,9 +506,13 @@ return base_ptr(new derived_problem(*this));
 		 * @param[in] x decision vector whose fitness will be calculated.
 		 */
 		virtual void objfun_impl(fitness_vector &f, const decision_vector &x) const = 0;
+		virtual void batch_objfun_impl(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
 		//@}
 	private:
 		void normalise_bounds();
+		void batch_objfun_block(std::vector<fitness_vector> &, const std::vector<decision_vector> &, const std::vector<base_ptr> &, std::size_t) const;
+		void batch_compute_constraints_block(std::vector<constraint_vector> &, const std::vector<decision_vector> &, const std::vector<base_ptr> &, std::size_t) const;
+		std::vector<base_ptr> batch_clones(std::size_t) const;
 		// Construct from iterators.
 		template <class Iterator1, class Iterator2>
 		void construct_from_iterators(Iterator1 start1, Iterator1 end1, Iterator2 start2, Iterator2 end2)
@@ -509,14 +547,8 @@ return base_ptr(new derived_problem(*this));
 			ar & m_lb;
 			ar & m_ub;
 			ar & const_cast<std::vector<double> &>(m_c_tol);
-			ar & m_decision_vector_cache_f;
-			ar & m_fitness_vector_cache;
-			ar & m_decision_vector_cache_c;
-			ar & m_constraint_vector_cache;
-			ar & m_tmp_f1;
-			ar & m_tmp_f2;
-			ar & m_tmp_c1;
-			ar & m_tmp_c2;
+			ar & m_fitness_cache;
+			ar & m_constraint_cache;
 			ar & m_best_x;
 			ar & m_best_f;
 			ar & m_best_c;
@@ -539,27 +571,19 @@ return base_ptr(new derived_problem(*this));
 		decision_vector				m_ub;
 		// Tolerance for constraints analysis.
 		const std::vector<double>   m_c_tol;
-		// Decision vector cache for fitness.
-		mutable decision_vector_cache_type	m_decision_vector_cache_f;
 		// Fitness vector cache.
-		mutable fitness_vector_cache_type	m_fitness_vector_cache;
-		// Decision vector cache for constraints.
-		mutable decision_vector_cache_type	m_decision_vector_cache_c;
+		mutable cache_type			m_fitness_cache;
 		// Constraint vector cache.
-		mutable constraint_vector_cache_type	m_constraint_vector_cache;
-		// Temporary storage used during decision_vector comparisons.
-		mutable fitness_vector			m_tmp_f1;
-		mutable fitness_vector			m_tmp_f2;
-		// Temporary storage used during constraints satisfaction testing and constraints comparison.
-		mutable constraint_vector		m_tmp_c1;
-		mutable constraint_vector		m_tmp_c2;
+		mutable cache_type			m_constraint_cache;
+		// Mutex protecting the caches and the evaluation counters.
+		mutable eval_mutex_type			m_eval_mutex;
 
 		// Best known vectors
 		std::vector<decision_vector> m_best_x;
 		std::vector<fitness_vector> m_best_f;
 		std::vector<constraint_vector> m_best_c;
 
-		// Number of function and constraints evaluations
+		// Number of function and constraints evaluations (protected by m_eval_mutex).
 		mutable unsigned int                    m_fevals;
 		mutable unsigned int                    m_cevals;
 };
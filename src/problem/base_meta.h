@@ -58,6 +58,15 @@ class __PAGMO_VISIBLE base_meta : public base
 			 }
 		/// Copy constructor
 		base_meta(const base_meta &p):base(p), m_original_problem(p.m_original_problem->clone()) {}
+		/// Parallel batch evaluation of the original problem.
+		/**
+		 * The objective function and the constraints of a meta-problem call those of the original problem, hence batches
+		 * can be evaluated in parallel only if the original problem allows it.
+		 *
+		 * @return m_original_problem->parallel_batch().
+		 */
+		bool parallel_batch() const
+			{return m_original_problem->parallel_batch();}
 	protected:
 		bool compare_fitness_impl(const fitness_vector &f1, const fitness_vector &f2) const 
 			{return m_original_problem->compare_fitness_impl(f1,f2);}
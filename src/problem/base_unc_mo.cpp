@@ -86,4 +86,16 @@ double base_unc_mo::convergence_metric(const decision_vector &x) const
 	pagmo_throw(not_implemented_error, "Error: a convergence metric is not implemented for this problem.");
 }
 
+/// Standard dominance.
+/**
+ * Unconstrained multi-objective problems deriving from this class rely on the comparison methods of problem::base,
+ * unless they reimplement them (in which case this method must be reimplemented too, returning false).
+ *
+ * @return true.
+ */
+bool base_unc_mo::standard_dominance() const
+{
+	return true;
+}
+
 }} // namespaces
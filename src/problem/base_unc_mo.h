@@ -52,6 +52,7 @@ class __PAGMO_VISIBLE base_unc_mo : public base
 		// p_distance methods
 		double p_distance(const decision_vector &) const;
 		double p_distance(const pagmo::population &) const;
+		bool standard_dominance() const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -82,6 +82,15 @@ std::string cec2009::get_name() const
 	return retval;
 }
 
+/// Standard dominance.
+/**
+ * Both the UF and the CF instances are compared with the constrained Pareto dominance of problem::base.
+ */
+bool cec2009::standard_dominance() const
+{
+	return true;
+}
+
 /// Returns the dimension of the fitness vector
 fitness_vector::size_type cec2009::cec2009_fitness_dimension(int problem_id)
 {
@@ -39,6 +39,9 @@
 #define INF 1.0e99
 #define EPS 1.0e-14
 #define E  2.7182818284590452353602874713526625
+// Largest dimension of the CEC2013 problems, used to size the work buffers of the basic functions. The buffers are
+// value-initialised, so that the compiler can tell that they are never read before being written.
+#define MAX_DIM 100
 
 namespace pagmo { namespace problem {
 
@@ -55,7 +58,7 @@ namespace pagmo { namespace problem {
  * the files
  * @throws io_error if the files are not found
  */
-cec2013::cec2013(unsigned int fun_id, problem::base::size_type d, const std::string& dir):base(d),m_problem_number(fun_id), m_y(d), m_z(d)
+cec2013::cec2013(unsigned int fun_id, problem::base::size_type d, const std::string& dir):base(d),m_problem_number(fun_id)
 {
 	if (!(d==2||d==5||d==10||d==20||d==30||d==40||d==50||d==60||d==70||d==80||d==90||d==100))
 	{
@@ -324,182 +327,199 @@ std::string cec2013::get_name() const
 
 }
 
+/// Thread safety of the problem.
+/**
+ * The basic functions keep their work buffers on the stack, hence they can run concurrently.
+ */
+bool cec2013::thread_safe() const
+{
+	return true;
+}
+
 void cec2013::sphere_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Sphere */
 {
-	shiftfunc(x, &m_y[0], nx, Os);
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
+	shiftfunc(x, &y[0], nx, Os);
 	if (r_flag==1)
-		rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+		rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (int i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 	f[0] = 0.0;
 	for (int i=0; i<nx; i++)
 	{
-		f[0] += m_z[i]*m_z[i];
+		f[0] += z[i]*z[i];
 	}
 }
 
 void cec2013::ellips_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Ellipsoidal */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
-	oszfunc (&m_z[0], &m_y[0], nx);
+		z[i]=y[i];
+	oszfunc (&z[0], &y[0], nx);
 	f[0] = 0.0;
 	for (i=0; i<nx; i++)
 	{
-		f[0] += pow(10.0,6.0*i/(nx-1))*m_y[i]*m_y[i];
+		f[0] += pow(10.0,6.0*i/(nx-1))*y[i]*y[i];
 	}
 }
 
 void cec2013::bent_cigar_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Bent_Cigar */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double beta=0.5;
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
-	asyfunc (&m_z[0], &m_y[0], nx,beta);
+		z[i]=y[i];
+	asyfunc (&z[0], &y[0], nx,beta);
 	if (r_flag==1)
-		rotatefunc(&m_y[0], &m_z[0], nx, &Mr[nx*nx]);
+		rotatefunc(&y[0], &z[0], nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
-	f[0] = m_z[0]*m_z[0];
+	f[0] = z[0]*z[0];
 	for (i=1; i<nx; i++)
 	{
-		f[0] += pow(10.0,6.0)*m_z[i]*m_z[i];
+		f[0] += pow(10.0,6.0)*z[i]*z[i];
 	}
 }
 
 void cec2013::discus_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Discus */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
-	oszfunc (&m_z[0], &m_y[0], nx);
+		z[i]=y[i];
+	oszfunc (&z[0], &y[0], nx);
 
-	f[0] = pow(10.0,6.0)*m_y[0]*m_y[0];
+	f[0] = pow(10.0,6.0)*y[0]*y[0];
 	for (i=1; i<nx; i++)
 	{
-		f[0] += m_y[i]*m_y[i];
+		f[0] += y[i]*y[i];
 	}
 }
 
 void cec2013::dif_powers_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Different Powers */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 	f[0] = 0.0;
 	for (i=0; i<nx; i++)
 	{
-		f[0] += pow(fabs(m_z[i]),2+4*i/(nx-1));
+		f[0] += pow(fabs(z[i]),2+4*i/(nx-1));
 	}
 	f[0]=pow(f[0],0.5);
 }
 
 void cec2013::rosenbrock_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Rosenbrock's */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double tmp1,tmp2;
-	shiftfunc(x, &m_y[0], nx, Os);//shift
+	shiftfunc(x, &y[0], nx, Os);//shift
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*2.048/100;
+		y[i]=y[i]*2.048/100;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);//rotate
+	rotatefunc(&y[0], &z[0], nx, Mr);//rotate
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 	for (i=0; i<nx; i++)//shift to orgin
 	{
-		m_z[i]=m_z[i]+1;
+		z[i]=z[i]+1;
 	}
 
 	f[0] = 0.0;
 	for (i=0; i<nx-1; i++)
 	{
-		tmp1=m_z[i]*m_z[i]-m_z[i+1];
-		tmp2=m_z[i]-1.0;
+		tmp1=z[i]*z[i]-z[i+1];
+		tmp2=z[i]-1.0;
 		f[0] += 100.0*tmp1*tmp1 +tmp2*tmp2;
 	}
 }
 
 void cec2013::schaffer_F7_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Schwefel's 1.2  */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double tmp;
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
-	asyfunc (&m_z[0], &m_y[0], nx, 0.5);
+		z[i]=y[i];
+	asyfunc (&z[0], &y[0], nx, 0.5);
 	for (i=0; i<nx; i++)
-		m_z[i] = m_y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
+		z[i] = y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(&z[0], &y[0], nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	for (i=0; i<nx-1; i++)
-		m_z[i]=pow(m_y[i]*m_y[i]+m_y[i+1]*m_y[i+1],0.5);
+		z[i]=pow(y[i]*y[i]+y[i+1]*y[i+1],0.5);
 	f[0] = 0.0;
 	for (i=0; i<nx-1; i++)
 	{
-	  tmp=sin(50.0*pow(m_z[i],0.2));
-	  f[0] += pow(m_z[i],0.5)+pow(m_z[i],0.5)*tmp*tmp ;
+	  tmp=sin(50.0*pow(z[i],0.2));
+	  f[0] += pow(z[i],0.5)+pow(z[i],0.5)*tmp*tmp ;
 	}
 	f[0] = f[0]*f[0]/(nx-1)/(nx-1);
 }
 
 void cec2013::ackley_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Ackley's  */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double sum1, sum2;
 
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
-	asyfunc (&m_z[0], &m_y[0], nx, 0.5);
+	asyfunc (&z[0], &y[0], nx, 0.5);
 	for (i=0; i<nx; i++)
-		m_z[i] = m_y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
+		z[i] = y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(&z[0], &y[0], nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	sum1 = 0.0;
 	sum2 = 0.0;
 	for (i=0; i<nx; i++)
 	{
-		sum1 += m_y[i]*m_y[i];
-		sum2 += cos(2.0*boost::math::constants::pi<double>()*m_y[i]);
+		sum1 += y[i]*y[i];
+		sum2 += cos(2.0*boost::math::constants::pi<double>()*y[i]);
 	}
 	sum1 = -0.2*sqrt(sum1/nx);
 	sum2 /= nx;
@@ -508,28 +528,29 @@ void cec2013::ackley_func (const double *x, double *f, int nx, const double *Os,
 
 void cec2013::weierstrass_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Weierstrass's  */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i,j,k_max;
 	double sum=0,sum2=0, a, b;
 
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*0.5/100;
+		y[i]=y[i]*0.5/100;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
-	asyfunc (&m_z[0], &m_y[0], nx, 0.5);
+	asyfunc (&z[0], &y[0], nx, 0.5);
 	for (i=0; i<nx; i++)
-		m_z[i] = m_y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
+		z[i] = y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(&z[0], &y[0], nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	a = 0.5;
 	b = 3.0;
@@ -541,7 +562,7 @@ void cec2013::weierstrass_func (const double *x, double *f, int nx, const double
 		sum2 = 0.0;
 		for (j=0; j<=k_max; j++)
 		{
-			sum += pow(a,j)*cos(2.0*boost::math::constants::pi<double>()*pow(b,j)*(m_y[i]+0.5));
+			sum += pow(a,j)*cos(2.0*boost::math::constants::pi<double>()*pow(b,j)*(y[i]+0.5));
 			sum2 += pow(a,j)*cos(2.0*boost::math::constants::pi<double>()*pow(b,j)*0.5);
 		}
 		f[0] += sum;
@@ -551,192 +572,197 @@ void cec2013::weierstrass_func (const double *x, double *f, int nx, const double
 
 void cec2013::griewank_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Griewank's  */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double s, p;
 
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*600.0/100.0;
+		y[i]=y[i]*600.0/100.0;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	for (i=0; i<nx; i++)
-		m_z[i] = m_z[i]*pow(100.0,1.0*i/(nx-1)/2.0);
+		z[i] = z[i]*pow(100.0,1.0*i/(nx-1)/2.0);
 
 
 	s = 0.0;
 	p = 1.0;
 	for (i=0; i<nx; i++)
 	{
-		s += m_z[i]*m_z[i];
-		p *= cos(m_z[i]/sqrt(1.0+i));
+		s += z[i]*z[i];
+		p *= cos(z[i]/sqrt(1.0+i));
 	}
 	f[0] = 1.0 + s/4000.0 - p;
 }
 
 void cec2013::rastrigin_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Rastrigin's  */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double alpha=10.0,beta=0.2;
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*5.12/100;
+		y[i]=y[i]*5.12/100;
 	}
 
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
-	oszfunc (&m_z[0], &m_y[0], nx);
-	asyfunc (&m_y[0], &m_z[0], nx, beta);
+	oszfunc (&z[0], &y[0], nx);
+	asyfunc (&y[0], &z[0], nx, beta);
 
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(&z[0], &y[0], nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	for (i=0; i<nx; i++)
 	{
-		m_y[i]*=pow(alpha,1.0*i/(nx-1)/2);
+		y[i]*=pow(alpha,1.0*i/(nx-1)/2);
 	}
 
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	f[0] = 0.0;
 	for (i=0; i<nx; i++)
 	{
-		f[0] += (m_z[i]*m_z[i] - 10.0*cos(2.0*boost::math::constants::pi<double>()*m_z[i]) + 10.0);
+		f[0] += (z[i]*z[i] - 10.0*cos(2.0*boost::math::constants::pi<double>()*z[i]) + 10.0);
 	}
 }
 
 void cec2013::step_rastrigin_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Noncontinuous Rastrigin's  */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double alpha=10.0,beta=0.2;
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*5.12/100;
+		y[i]=y[i]*5.12/100;
 	}
 
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	for (i=0; i<nx; i++)
 	{
-		if (fabs(m_z[i])>0.5)
-		m_z[i]=floor(2*m_z[i]+0.5)/2;
+		if (fabs(z[i])>0.5)
+		z[i]=floor(2*z[i]+0.5)/2;
 	}
 
-	oszfunc (&m_z[0], &m_y[0], nx);
-	asyfunc (&m_y[0], &m_z[0], nx, beta);
+	oszfunc (&z[0], &y[0], nx);
+	asyfunc (&y[0], &z[0], nx, beta);
 
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(&z[0], &y[0], nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	for (i=0; i<nx; i++)
 	{
-		m_y[i]*=pow(alpha,1.0*i/(nx-1)/2);
+		y[i]*=pow(alpha,1.0*i/(nx-1)/2);
 	}
 
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	f[0] = 0.0;
 	for (i=0; i<nx; i++)
 	{
-		f[0] += (m_z[i]*m_z[i] - 10.0*cos(2.0*boost::math::constants::pi<double>()*m_z[i]) + 10.0);
+		f[0] += (z[i]*z[i] - 10.0*cos(2.0*boost::math::constants::pi<double>()*z[i]) + 10.0);
 	}
 }
 
 void cec2013::schwefel_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Schwefel's  */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double tmp;
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]*=1000/100;
+		y[i]*=1000/100;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	for (i=0; i<nx; i++)
-		m_y[i] = m_z[i]*pow(10.0,1.0*i/(nx-1)/2.0);
+		y[i] = z[i]*pow(10.0,1.0*i/(nx-1)/2.0);
 
 	for (i=0; i<nx; i++)
-		m_z[i] = m_y[i]+4.209687462275036e+002;
+		z[i] = y[i]+4.209687462275036e+002;
 
 	f[0]=0;
 	for (i=0; i<nx; i++)
 	{
-		if (m_z[i]>500)
+		if (z[i]>500)
 		{
-			f[0]-=(500.0-fmod(m_z[i],500))*sin(pow(500.0-fmod(m_z[i],500),0.5));
-			tmp=(m_z[i]-500.0)/100;
+			f[0]-=(500.0-fmod(z[i],500))*sin(pow(500.0-fmod(z[i],500),0.5));
+			tmp=(z[i]-500.0)/100;
 			f[0]+= tmp*tmp/nx;
 		}
-		else if (m_z[i]<-500)
+		else if (z[i]<-500)
 		{
-			f[0]-=(-500.0+fmod(fabs(m_z[i]),500))*sin(pow(500.0-fmod(fabs(m_z[i]),500),0.5));
-			tmp=(m_z[i]+500.0)/100;
+			f[0]-=(-500.0+fmod(fabs(z[i]),500))*sin(pow(500.0-fmod(fabs(z[i]),500),0.5));
+			tmp=(z[i]+500.0)/100;
 			f[0]+= tmp*tmp/nx;
 		}
 		else
-			f[0]-=m_z[i]*sin(pow(fabs(m_z[i]),0.5));
+			f[0]-=z[i]*sin(pow(fabs(z[i]),0.5));
 	}
 	f[0]=4.189828872724338e+002*nx+f[0];
 }
 
 void cec2013::katsuura_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Katsuura  */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i,j;
 	double temp,tmp1,tmp2,tmp3;
 	tmp3=pow(1.0*nx,1.2);
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]*=5.0/100.0;
+		y[i]*=5.0/100.0;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	for (i=0; i<nx; i++)
-		m_z[i] *=pow(100.0,1.0*i/(nx-1)/2.0);
+		z[i] *=pow(100.0,1.0*i/(nx-1)/2.0);
 
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(&z[0], &y[0], nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	f[0]=1.0;
 	for (i=0; i<nx; i++)
@@ -745,7 +771,7 @@ void cec2013::katsuura_func (const double *x, double *f, int nx, const double *O
 		for (j=1; j<=32; j++)
 		{
 			tmp1=pow(2.0,j);
-			tmp2=tmp1*m_y[i];
+			tmp2=tmp1*y[i];
 			temp += fabs(tmp2-floor(tmp2+0.5))/tmp1;
 		}
 		f[0] *= pow(1.0+(i+1)*temp,10.0/tmp3);
@@ -757,6 +783,7 @@ void cec2013::katsuura_func (const double *x, double *f, int nx, const double *O
 
 void cec2013::bi_rastrigin_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Lunacek Bi_rastrigin Function */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double mu0=2.5,d=1.0,s,mu1,tmp,tmp1,tmp2;
 	double *tmpx;
@@ -764,37 +791,37 @@ void cec2013::bi_rastrigin_func (const double *x, double *f, int nx, const doubl
 	s=1.0-1.0/(2.0*pow(nx+20.0,0.5)-8.2);
 	mu1=-pow((mu0*mu0-d)/s,0.5);
 
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]*=10.0/100.0;
+		y[i]*=10.0/100.0;
 	}
 
 	for (i = 0; i < nx; i++)
 	{
-		tmpx[i]=2*m_y[i];
+		tmpx[i]=2*y[i];
 		if (Os[i] < 0.)
 			tmpx[i] *= -1.;
 	}
 
 	for (i=0; i<nx; i++)
 	{
-		m_z[i]=tmpx[i];
+		z[i]=tmpx[i];
 		tmpx[i] += mu0;
 	}
 	if (r_flag==1)
-		rotatefunc(&m_z[0], &m_y[0], nx, Mr);
+		rotatefunc(&z[0], &y[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	for (i=0; i<nx; i++)
-		m_y[i] *=pow(100.0,1.0*i/(nx-1)/2.0);
+		y[i] *=pow(100.0,1.0*i/(nx-1)/2.0);
 	if (r_flag==1)
-		rotatefunc(&m_y[0], &m_z[0], nx, &Mr[nx*nx]);
+		rotatefunc(&y[0], &z[0], nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	tmp1=0.0;tmp2=0.0;
 	for (i=0; i<nx; i++)
@@ -809,7 +836,7 @@ void cec2013::bi_rastrigin_func (const double *x, double *f, int nx, const doubl
 	tmp=0;
 	for (i=0; i<nx; i++)
 	{
-		tmp+=cos(2.0*boost::math::constants::pi<double>()*m_z[i]);
+		tmp+=cos(2.0*boost::math::constants::pi<double>()*z[i]);
 	}
 
 	if(tmp1<tmp2)
@@ -822,68 +849,70 @@ void cec2013::bi_rastrigin_func (const double *x, double *f, int nx, const doubl
 
 void cec2013::grie_rosen_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Griewank-Rosenbrock  */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double temp,tmp1,tmp2;
 
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*5/100;
+		y[i]=y[i]*5/100;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	for (i=0; i<nx; i++)//shift to orgin
 	{
-		m_z[i]=m_y[i]+1;
+		z[i]=y[i]+1;
 	}
 
 	f[0]=0.0;
 	for (i=0; i<nx-1; i++)
 	{
-		tmp1 = m_z[i]*m_z[i]-m_z[i+1];
-		tmp2 = m_z[i]-1.0;
+		tmp1 = z[i]*z[i]-z[i+1];
+		tmp2 = z[i]-1.0;
 		temp = 100.0*tmp1*tmp1 + tmp2*tmp2;
 		 f[0] += (temp*temp)/4000.0 - cos(temp) + 1.0;
 	}
-	tmp1 = m_z[nx-1]*m_z[nx-1]-m_z[0];
-	tmp2 = m_z[nx-1]-1.0;
+	tmp1 = z[nx-1]*z[nx-1]-z[0];
+	tmp2 = z[nx-1]-1.0;
 	temp = 100.0*tmp1*tmp1 + tmp2*tmp2;;
 	 f[0] += (temp*temp)/4000.0 - cos(temp) + 1.0 ;
 }
 
 void cec2013::escaffer6_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Expanded Scaffer¡¯s F6  */
 {
+	double y[MAX_DIM] = {}, z[MAX_DIM] = {};
 	int i;
 	double temp1, temp2;
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, &y[0], nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(&y[0], &z[0], nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
-	asyfunc (&m_z[0], &m_y[0], nx, 0.5);
+	asyfunc (&z[0], &y[0], nx, 0.5);
 	if (r_flag==1)
-		rotatefunc(&m_y[0], &m_z[0], nx, &Mr[nx*nx]);
+		rotatefunc(&y[0], &z[0], nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	f[0] = 0.0;
 	for (i=0; i<nx-1; i++)
 	{
-		temp1 = sin(sqrt(m_z[i]*m_z[i]+m_z[i+1]*m_z[i+1]));
+		temp1 = sin(sqrt(z[i]*z[i]+z[i+1]*z[i+1]));
 		temp1 =temp1*temp1;
-		temp2 = 1.0 + 0.001*(m_z[i]*m_z[i]+m_z[i+1]*m_z[i+1]);
+		temp2 = 1.0 + 0.001*(z[i]*z[i]+z[i+1]*z[i+1]);
 		f[0] += 0.5 + (temp1-0.5)/(temp2*temp2);
 	}
-	temp1 = sin(sqrt(m_z[nx-1]*m_z[nx-1]+m_z[0]*m_z[0]));
+	temp1 = sin(sqrt(z[nx-1]*z[nx-1]+z[0]*z[0]));
 	temp1 =temp1*temp1;
-	temp2 = 1.0 + 0.001*(m_z[nx-1]*m_z[nx-1]+m_z[0]*m_z[0]);
+	temp2 = 1.0 + 0.001*(z[nx-1]*z[nx-1]+z[0]*z[0]);
 	f[0] += 0.5 + (temp1-0.5)/(temp2*temp2);
 }
 
@@ -1156,5 +1185,6 @@ void cec2013::cf_cal(const double *x, double *f, int nx, const double *Os,double
 #undef EPS
 #undef E
 #undef INF
+#undef MAX_DIM
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::cec2013)
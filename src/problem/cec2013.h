@@ -57,6 +57,7 @@ class __PAGMO_VISIBLE cec2013 : public base
 	cec2013(unsigned int = 1, problem::base::size_type = 30, const std::string & = "input_data/");
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool thread_safe() const;
 
 		/** @name Getters.*/
 		//@{
@@ -113,10 +114,6 @@ class __PAGMO_VISIBLE cec2013 : public base
 	const unsigned int m_problem_number;
 	std::vector<double> m_rotation_matrix;
 	std::vector<double> m_origin_shift;
-
-	// These are pre-allocated for speed, need not to be serialized
-	mutable std::vector<double> m_y;
-	mutable std::vector<double> m_z;
 };
 
 }} //namespaces
@@ -24,6 +24,7 @@
 
 #include <cmath>
 #include <boost/math/constants/constants.hpp>
+#include <typeinfo>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -338,6 +339,32 @@ std::string dtlz::get_name() const
 	return retval;
 }
 
+/// Thread safety of the problem.
+bool dtlz::thread_safe() const
+{
+	return true;
+}
+
+/// Exact equality.
+/**
+ * The problem number, the number of objectives and alpha are compared by equality_operator_extra().
+ */
+bool dtlz::exact_equality() const
+{
+	return true;
+}
+
+/// Additional requirements for equality.
+/**
+ * @return true if the problem numbers, the numbers of objectives and the values of alpha are equal, false otherwise.
+ */
+bool dtlz::equality_operator_extra(const base &other) const
+{
+	pagmo_assert(typeid(*this) == typeid(other));
+	const dtlz &d = dynamic_cast<dtlz const &>(other);
+	return (m_problem_number == d.m_problem_number && get_f_dimension() == d.get_f_dimension() && m_alpha == d.m_alpha);
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::dtlz)
@@ -83,7 +83,10 @@ class __PAGMO_VISIBLE dtlz : public base_dtlz
 		dtlz(size_type id = 1, size_type k = 5, fitness_vector::size_type fdim = 3, const size_t alpha = 100);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool thread_safe() const;
+		bool exact_equality() const;
 	protected:
+		bool equality_operator_extra(const base &) const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 	private:
                 void f1_objfun_impl(fitness_vector &, const decision_vector &) const;
@@ -63,6 +63,12 @@ std::string fon::get_name() const
 	return "Fonseca and Fleming's study";
 }
 
+/// Standard dominance.
+bool fon::standard_dominance() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::fon)
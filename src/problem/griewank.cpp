@@ -72,6 +72,21 @@ std::string griewank::get_name() const
 	return "Griewank";
 }
 
+/// Thread safety of the problem.
+bool griewank::thread_safe() const
+{
+	return true;
+}
+
+/// Exact equality.
+/**
+ * The dimension is the only parameter of the problem.
+ */
+bool griewank::exact_equality() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::griewank)
@@ -72,6 +72,12 @@ std::string kur::get_name() const
 {
 	return "Kursawe's study";
 }
+
+/// Standard dominance.
+bool kur::standard_dominance() const
+{
+	return true;
+}
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::kur)
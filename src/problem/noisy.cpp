@@ -196,6 +196,15 @@ std::string noisy::get_name() const
 	return m_original_problem->get_name() + " [Noisy]"; 
 }
 
+/// Parallel batch evaluation of the original problem.
+/**
+ * @return m_original_problem->parallel_batch(), as the evaluation of the noisy problem calls the one of the original problem.
+ */
+bool noisy::parallel_batch() const
+{
+	return m_original_problem->parallel_batch();
+}
+
 /// Extra human readable info for the problem.
 /**
  * Will return a formatted string containing the translation vector
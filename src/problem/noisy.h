@@ -73,6 +73,7 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 		noisy(const noisy &);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool parallel_batch() const;
 
 		void set_noise_param(double, double);
 		double get_param_first() const;
@@ -76,6 +76,12 @@ std::string pol::get_name() const
 	return "Poloni's study";
 }
 
+/// Standard dominance.
+bool pol::standard_dominance() const
+{
+	return true;
+}
+
 
 }} //namespaces
 
@@ -72,6 +72,21 @@ std::string rastrigin::get_name() const
 	return "Rastrigin";
 }
 
+/// Thread safety of the problem.
+bool rastrigin::thread_safe() const
+{
+	return true;
+}
+
+/// Exact equality.
+/**
+ * The dimension is the only parameter of the problem.
+ */
+bool rastrigin::exact_equality() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::rastrigin)
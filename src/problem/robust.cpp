@@ -177,6 +177,15 @@ std::string robust::get_name() const
 	return m_original_problem->get_name() + " [Robust]";
 }
 
+/// Parallel batch evaluation of the original problem.
+/**
+ * @return m_original_problem->parallel_batch(), as the evaluation of the robust problem calls the one of the original problem.
+ */
+bool robust::parallel_batch() const
+{
+	return m_original_problem->parallel_batch();
+}
+
 /// Extra human readable info for the problem.
 /**
  * Will return a formatted string containing the translation vector
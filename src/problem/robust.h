@@ -62,6 +62,7 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 		robust(const robust &);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool parallel_batch() const;
 
 		void set_rho(double);
 		double get_rho() const;
@@ -67,6 +67,21 @@ std::string rosenbrock::get_name() const
 	return "Rosenbrock";
 }
 
+/// Thread safety of the problem.
+bool rosenbrock::thread_safe() const
+{
+	return true;
+}
+
+/// Exact equality.
+/**
+ * The dimension is the only parameter of the problem.
+ */
+bool rosenbrock::exact_equality() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::rosenbrock)
@@ -55,6 +55,8 @@ class __PAGMO_VISIBLE rosenbrock : public base
 		rosenbrock(int = 1);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool thread_safe() const;
+		bool exact_equality() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 	private:
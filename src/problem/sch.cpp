@@ -60,6 +60,12 @@ std::string sch::get_name() const
 	return "Shaffer's Study";
 }
 
+/// Standard dominance.
+bool sch::standard_dominance() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::sch)
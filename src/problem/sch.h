@@ -55,6 +55,7 @@ class __PAGMO_VISIBLE sch : public base
 		sch();
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool standard_dominance() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 	private:
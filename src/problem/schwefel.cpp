@@ -72,6 +72,21 @@ std::string schwefel::get_name() const
 	return "Schwefel";
 }
 
+/// Thread safety of the problem.
+bool schwefel::thread_safe() const
+{
+	return true;
+}
+
+/// Exact equality.
+/**
+ * The dimension is the only parameter of the problem.
+ */
+bool schwefel::exact_equality() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::schwefel)
@@ -22,6 +22,8 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <typeinfo>
+
 #include "tsp.h"
 #include "../population.h"
 
@@ -246,6 +248,35 @@ namespace pagmo { namespace problem {
         return "Travelling Salesman Problem (TSP-ATSP)";
     }
 
+    /// Thread safety of the problem.
+    /**
+     * The weights matrix is only read by the objective function and by the constraints computation.
+     */
+    bool tsp::thread_safe() const
+    {
+        return true;
+    }
+
+    /// Exact equality.
+    /**
+     * The weights matrix and the encoding are compared by equality_operator_extra().
+     */
+    bool tsp::exact_equality() const
+    {
+        return true;
+    }
+
+    /// Additional requirements for equality.
+    /**
+     * @return true if the weights matrices and the encodings are equal, false otherwise.
+     */
+    bool tsp::equality_operator_extra(const base &other) const
+    {
+        pagmo_assert(typeid(*this) == typeid(other));
+        const tsp &t = dynamic_cast<tsp const &>(other);
+        return (get_encoding() == t.get_encoding() && m_weights == t.m_weights);
+    }
+
     /// Extra human readable info for the problem.
     /**
      * @return a std::string containing a list of vertices and edges
@@ -61,10 +61,15 @@ class __PAGMO_VISIBLE tsp: public base_tsp
         /** @name Implementation of virtual methods*/
         //@{
         std::string get_name() const;
+        bool thread_safe() const;
+        bool exact_equality() const;
         std::string human_readable_extra() const;
         double distance(decision_vector::size_type, decision_vector::size_type) const;
         //@}
 
+    protected:
+        bool equality_operator_extra(const base &) const;
+
     private:
         static boost::array<int, 2> compute_dimensions(decision_vector::size_type n_cities, base_tsp::encoding_type);
         void check_weights(const std::vector<std::vector<double> >&) const;
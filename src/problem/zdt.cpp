@@ -24,6 +24,7 @@
 
 #include <cmath>
 #include <boost/math/constants/constants.hpp>
+#include <typeinfo>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -380,6 +381,31 @@ std::string zdt::get_name() const
 	return retval;
 }
 
+/// Thread safety of the problem.
+bool zdt::thread_safe() const
+{
+	return true;
+}
+
+/// Exact equality.
+/**
+ * The problem number is compared by equality_operator_extra().
+ */
+bool zdt::exact_equality() const
+{
+	return true;
+}
+
+/// Additional requirements for equality.
+/**
+ * @return true if the problem numbers are equal, false otherwise.
+ */
+bool zdt::equality_operator_extra(const base &other) const
+{
+	pagmo_assert(typeid(*this) == typeid(other));
+	return (m_problem_number == dynamic_cast<zdt const &>(other).m_problem_number);
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::zdt)
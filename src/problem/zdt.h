@@ -137,7 +137,10 @@ class __PAGMO_VISIBLE zdt : public base_unc_mo
 		zdt(size_type = 1, size_type = 30);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool thread_safe() const;
+		bool exact_equality() const;
 	protected:
+		bool equality_operator_extra(const base &) const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		double convergence_metric(const decision_vector &) const;
 	private:
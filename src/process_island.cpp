@@ -0,0 +1,512 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "algorithm/base.h"
+#include "base_island.h"
+#include "exceptions.h"
+#include "migration/base_r_policy.h"
+#include "migration/base_s_policy.h"
+#include "population.h"
+#include "problem/base.h"
+#include "process_island.h"
+
+namespace pagmo
+{
+
+// Kinds of the requests sent to the worker processes.
+enum request_kind
+{
+	// Open the session, sending population and algorithm, and evolve.
+	bind_request = 0,
+	// Send the state of the population, and evolve.
+	evolve_request = 1,
+	// Terminate the worker process.
+	exit_request = 2
+};
+
+// Minimum capacity (in doubles) of the region shared with the worker processes.
+static const std::size_t min_shared_capacity = 4096u;
+
+// The individuals are exchanged with the worker processes through a shared memory region, as fixed-layout records of doubles:
+// cur_x, cur_v, cur_c, cur_f, best_x, best_c and best_f, sized according to the dimensions of the problem. Only the rest of
+// the state of the population goes through the socket.
+
+// Number of doubles in the record of an individual.
+static std::size_t record_size(const problem::base &prob)
+{
+	return 3u * prob.get_dimension() + 2u * prob.get_f_dimension() + 2u * prob.get_c_dimension();
+}
+
+static bool write_vector(double *&dst, const std::vector<double> &v, std::size_t size)
+{
+	if (v.size() != size) {
+		return false;
+	}
+	dst = std::copy(v.begin(),v.end(),dst);
+	return true;
+}
+
+static void read_vector(const double *&src, std::vector<double> &v, std::size_t size)
+{
+	v.assign(src,src + size);
+	src += size;
+}
+
+// Write the individuals of pop into the records. Return false if they do not fit in the shared region, or if their
+// sizes do not match the dimensions of the problem.
+static bool write_records(const population &pop, double *records, std::size_t capacity)
+{
+	const problem::base &prob = pop.problem();
+	if (pop.size() * record_size(prob) > capacity) {
+		return false;
+	}
+	const std::size_t n = prob.get_dimension(), nf = prob.get_f_dimension(), nc = prob.get_c_dimension();
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const population::individual_type &ind = pop.get_individual(i);
+		if (!write_vector(records,ind.cur_x,n) || !write_vector(records,ind.cur_v,n) || !write_vector(records,ind.cur_c,nc) ||
+			!write_vector(records,ind.cur_f,nf) || !write_vector(records,ind.best_x,n) || !write_vector(records,ind.best_c,nc) ||
+			!write_vector(records,ind.best_f,nf))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Read count individuals of a population of prob from the records.
+static void read_records(const problem::base &prob, const double *records, std::size_t capacity, population::size_type count,
+	population::container_type &individuals)
+{
+	if (count * record_size(prob) > capacity) {
+		pagmo_throw(value_error,"the individuals do not fit in the shared memory region");
+	}
+	const std::size_t n = prob.get_dimension(), nf = prob.get_f_dimension(), nc = prob.get_c_dimension();
+	individuals.resize(count);
+	for (population::size_type i = 0; i < count; ++i) {
+		population::individual_type &ind = individuals[i];
+		read_vector(records,ind.cur_x,n);
+		read_vector(records,ind.cur_v,n);
+		read_vector(records,ind.cur_c,nc);
+		read_vector(records,ind.cur_f,nf);
+		read_vector(records,ind.best_x,n);
+		read_vector(records,ind.best_c,nc);
+		read_vector(records,ind.best_f,nf);
+	}
+}
+
+// Save the state of pop, writing the individuals into the records if possible.
+static void save_state(boost::archive::binary_oarchive &oa, population &pop, double *records, std::size_t capacity)
+{
+	const bool shared = write_records(pop,records,capacity);
+	oa << shared;
+	if (shared) {
+		const population::size_type count = pop.size();
+		oa << count;
+		// NOTE: the individuals are not used when saving.
+		population::container_type unused;
+		population::state_proxy proxy(pop,unused);
+		oa << proxy;
+	} else {
+		population::state_proxy proxy(pop);
+		oa << proxy;
+	}
+}
+
+// Load the state of pop saved by save_state().
+static void load_state(boost::archive::binary_iarchive &ia, population &pop, const double *records, std::size_t capacity)
+{
+	bool shared;
+	ia >> shared;
+	if (shared) {
+		population::size_type count;
+		ia >> count;
+		population::container_type individuals;
+		read_records(pop.problem(),records,capacity,count,individuals);
+		population::state_proxy proxy(pop,individuals);
+		ia >> proxy;
+	} else {
+		population::state_proxy proxy(pop);
+		ia >> proxy;
+	}
+}
+
+// Write the whole buffer to fd. Return false if the other end of the socket has been closed.
+static bool write_all(int fd, const char *buffer, std::size_t size)
+{
+	while (size) {
+		// NOTE: MSG_NOSIGNAL avoids SIGPIPE if the worker process is dead.
+		const ssize_t n = ::send(fd,buffer,size,MSG_NOSIGNAL);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		buffer += n;
+		size -= static_cast<std::size_t>(n);
+	}
+	return true;
+}
+
+// Read exactly size bytes from fd into buffer. Return false if the other end of the socket has been closed.
+static bool read_all(int fd, char *buffer, std::size_t size)
+{
+	while (size) {
+		const ssize_t n = ::recv(fd,buffer,size,0);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		buffer += n;
+		size -= static_cast<std::size_t>(n);
+	}
+	return true;
+}
+
+// Messages are prefixed by their size.
+static bool write_message(int fd, const std::string &message)
+{
+	const boost::uint64_t size = message.size();
+	return write_all(fd,reinterpret_cast<const char *>(&size),sizeof(size)) && write_all(fd,message.data(),message.size());
+}
+
+static bool read_message(int fd, std::string &message)
+{
+	boost::uint64_t size;
+	if (!read_all(fd,reinterpret_cast<char *>(&size),sizeof(size))) {
+		return false;
+	}
+	message.resize(static_cast<std::string::size_type>(size));
+	return !size || read_all(fd,&message[0],message.size());
+}
+
+// Serve a request in the worker process, writing the reply into reply: a flag signalling success, followed by the number of function
+// evaluations performed and by the state of the evolved population in case of success, or by the error message otherwise. Return false if the worker process must terminate.
+static bool serve_request(const std::string &request, std::string &reply, boost::shared_ptr<population> &pop, algorithm::base_ptr &algo,
+	double *records, std::size_t capacity)
+{
+	std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
+	try {
+		std::istringstream iss(request,std::ios_base::in | std::ios_base::binary);
+		boost::archive::binary_iarchive ia(iss,boost::archive::no_header);
+		int kind;
+		ia >> kind;
+		if (kind == exit_request) {
+			return false;
+		}
+		if (kind == bind_request) {
+			population *new_pop = 0;
+			ia >> new_pop;
+			pop.reset(new_pop);
+			algorithm::base *new_algo = 0;
+			ia >> new_algo;
+			algo.reset(new_algo);
+		} else {
+			if (!pop) {
+				pagmo_throw(std::runtime_error,"no session is open in the worker process");
+			}
+			load_state(ia,*pop,records,capacity);
+		}
+		const unsigned int start = pop->problem().get_fevals();
+		algo->evolve(*pop);
+		// NOTE: unsigned arithmetic takes care of the wrapping of the counter.
+		const unsigned int fevals = pop->problem().get_fevals() - start;
+		boost::archive::binary_oarchive oa(oss,boost::archive::no_header);
+		const bool ok = true;
+		oa << ok;
+		oa << fevals;
+		save_state(oa,*pop,records,capacity);
+	} catch (const std::exception &e) {
+		// Close the session: it will be re-opened at the next evolution.
+		pop.reset();
+		algo.reset();
+		oss.str("");
+		boost::archive::binary_oarchive oa(oss,boost::archive::no_header);
+		const bool ok = false;
+		const std::string what(e.what());
+		oa << ok;
+		oa << what;
+	}
+	reply = oss.str();
+	return true;
+}
+
+// Main loop of the worker processes: serve the requests until the exit request arrives or the socket is closed.
+static void worker_loop(int fd, double *records, std::size_t capacity)
+{
+	boost::shared_ptr<population> pop;
+	algorithm::base_ptr algo;
+	std::string request, reply;
+	while (read_message(fd,request) && serve_request(request,reply,pop,algo,records,capacity) && write_message(fd,reply)) {}
+}
+
+// Mutex serialising the creation of the worker processes, so that the child end of the socket of a worker is never inherited
+// by workers forked concurrently. It also protects worker_fds.
+static boost::mutex fork_mutex;
+
+// Parent ends of the sockets of the live worker processes. They are closed in every newly-forked worker, so that a worker
+// sees the end of its socket as soon as the parent process terminates, even if other workers are still alive.
+static std::vector<int> worker_fds;
+
+struct process_island::worker_process
+{
+	// Fork a new worker process, connected to this via a socket and via a shared region able to hold capacity doubles.
+	explicit worker_process(std::size_t capacity):m_pid(-1),m_fd(-1),m_records(0),m_capacity(capacity)
+	{
+		boost::lock_guard<boost::mutex> lock(fork_mutex);
+		// NOTE: reserve here, so that registering the socket cannot throw once the worker process has been forked.
+		worker_fds.reserve(worker_fds.size() + 1u);
+		void *region = ::mmap(0,m_capacity * sizeof(double),PROT_READ | PROT_WRITE,MAP_SHARED | MAP_ANONYMOUS,-1,0);
+		if (region == MAP_FAILED) {
+			pagmo_throw(std::runtime_error,"cannot map the memory region shared with the worker process");
+		}
+		m_records = static_cast<double *>(region);
+		int fds[2];
+		if (::socketpair(AF_UNIX,SOCK_STREAM,0,fds)) {
+			::munmap(m_records,m_capacity * sizeof(double));
+			pagmo_throw(std::runtime_error,"cannot create the socket of the worker process");
+		}
+		m_pid = ::fork();
+		if (m_pid < 0) {
+			::close(fds[0]);
+			::close(fds[1]);
+			::munmap(m_records,m_capacity * sizeof(double));
+			pagmo_throw(std::runtime_error,"cannot fork the worker process");
+		}
+		if (!m_pid) {
+			// In the worker process.
+			::close(fds[0]);
+			for (std::vector<int>::size_type i = 0; i < worker_fds.size(); ++i) {
+				::close(worker_fds[i]);
+			}
+			// NOTE: no exception must escape, otherwise the stack of the parent process would be unwound in the worker
+			// and the evolution of the parent would go on here. Skip also the destruction of the static objects,
+			// which belong to the parent process.
+			try {
+				worker_loop(fds[1],m_records,m_capacity);
+			} catch (...) {
+				::_exit(1);
+			}
+			::_exit(0);
+		}
+		::close(fds[1]);
+		m_fd = fds[0];
+		worker_fds.push_back(m_fd);
+	}
+	// Ask the worker process to terminate and wait for it.
+	~worker_process()
+	{
+		std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
+		try {
+			boost::archive::binary_oarchive oa(oss,boost::archive::no_header);
+			const int kind = exit_request;
+			oa << kind;
+		} catch (...) {}
+		write_message(m_fd,oss.str());
+		{
+			boost::lock_guard<boost::mutex> lock(fork_mutex);
+			worker_fds.erase(std::remove(worker_fds.begin(),worker_fds.end(),m_fd),worker_fds.end());
+			::close(m_fd);
+		}
+		while (::waitpid(m_pid,0,0) < 0 && errno == EINTR) {}
+		::munmap(m_records,m_capacity * sizeof(double));
+	}
+	// Send a request and wait for the reply. Fail if the worker process has terminated.
+	void exchange(const std::string &request, std::string &reply)
+	{
+		if (!write_message(m_fd,request) || !read_message(m_fd,reply)) {
+			pagmo_throw(std::runtime_error,"the worker process terminated unexpectedly");
+		}
+	}
+	pid_t		m_pid;
+	int		m_fd;
+	double		*m_records;
+	std::size_t	m_capacity;
+};
+
+/// Constructor from problem::base, algorithm::base, number of individuals, migration probability and selection/replacement policies.
+/**
+ * @see pagmo::base_island constructors.
+ */
+process_island::process_island(const algorithm::base &a, const problem::base &p, int n,
+	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
+	base_island(a,p,n,s_policy,r_policy)
+{}
+
+/// Constructor from population.
+/**
+ * @see pagmo::base_island constructors.
+ */
+process_island::process_island(const algorithm::base &a, const population &pop,
+	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
+	base_island(a,pop,s_policy,r_policy)
+{}
+
+/// Copy constructor.
+/**
+ * The copy will fork its own worker process.
+ *
+ * @see pagmo::base_island constructors.
+ */
+process_island::process_island(const process_island &isl):base_island(isl)
+{}
+
+/// Assignment operator.
+/**
+ * The session opened in the worker process will be re-bound at the next evolution.
+ */
+process_island &process_island::operator=(const process_island &isl)
+{
+	base_island::operator=(isl);
+	close_session();
+	return *this;
+}
+
+/// Destructor.
+/**
+ * Will wait for the evolution to terminate and then terminate the worker process.
+ */
+process_island::~process_island()
+{
+	// NOTE: the worker process must not be terminated while evolving.
+	join();
+}
+
+base_island_ptr process_island::clone() const
+{
+	return base_island_ptr(new process_island(*this));
+}
+
+// Forget the session open in the worker process, so that it is re-bound at the next evolution.
+void process_island::close_session() const
+{
+	m_session_algo.reset();
+	m_session_prob.reset();
+}
+
+// Send the population to the worker process, forking it if needed, and load the state of the evolved population from the reply.
+void process_island::perform_evolution(const algorithm::base &algo, population &pop) const
+{
+	pagmo_assert(&algo == m_algo.get());
+	// If the population has outgrown the shared region, fork a new worker process with a larger one.
+	const std::size_t required = pop.size() * record_size(pop.problem());
+	if (m_worker && required > m_worker->m_capacity) {
+		m_worker.reset();
+	}
+	if (!m_worker) {
+		m_worker.reset(new worker_process(std::max(2u * required,min_shared_capacity)));
+		close_session();
+	}
+	// If the algorithm or the problem changed since the last evolution, the session is outdated.
+	const bool bind = m_session_algo.get() != &algo || m_session_prob.get() != &pop.problem();
+	std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
+	{
+		boost::archive::binary_oarchive oa(oss,boost::archive::no_header);
+		const int kind = bind ? bind_request : evolve_request;
+		oa << kind;
+		if (bind) {
+			const population *pop_ptr = &pop;
+			const algorithm::base *algo_ptr = &algo;
+			oa << pop_ptr;
+			oa << algo_ptr;
+		} else {
+			save_state(oa,pop,m_worker->m_records,m_worker->m_capacity);
+		}
+	}
+	if (bind) {
+		m_session_algo = m_algo;
+		m_session_prob = population_access::get_problem_ptr(pop);
+	}
+	std::string reply;
+	try {
+		m_worker->exchange(oss.str(),reply);
+	} catch (...) {
+		// A new worker process will be forked at the next evolution.
+		m_worker.reset();
+		throw;
+	}
+	std::istringstream iss(reply,std::ios_base::in | std::ios_base::binary);
+	boost::archive::binary_iarchive ia(iss,boost::archive::no_header);
+	bool ok;
+	ia >> ok;
+	if (!ok) {
+		close_session();
+		std::string what;
+		ia >> what;
+		pagmo_throw(std::runtime_error,what);
+	}
+	unsigned int fevals;
+	ia >> fevals;
+	load_state(ia,pop,m_worker->m_records,m_worker->m_capacity);
+	// Report the evaluations performed by the worker process to the problem of the island.
+	pop.problem().add_fevals(fevals);
+}
+
+/// Blocking evolution.
+/**
+ * The evolution runs in a worker process, while the calling thread waits for the result on a socket.
+ *
+ * @return true.
+ */
+bool process_island::blocking() const
+{
+	return true;
+}
+
+/// Return a string identifying the island's type.
+/**
+ * @return the string "Local process island".
+ */
+std::string process_island::get_name() const
+{
+	return "Local process island";
+}
+
+}
+
+BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::process_island)
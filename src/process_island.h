@@ -0,0 +1,154 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_PROCESS_ISLAND_H
+#define PAGMO_PROCESS_ISLAND_H
+
+#include <boost/shared_ptr.hpp>
+#include <string>
+
+#include "base_island.h"
+#include "config.h"
+#include "algorithm/base.h"
+#include "migration/base_r_policy.h"
+#include "migration/base_s_policy.h"
+#include "migration/best_s_policy.h"
+#include "migration/fair_r_policy.h"
+#include "population.h"
+#include "problem/base.h"
+#include "serialization.h"
+
+// Forward declarations.
+namespace pagmo {
+
+class process_island;
+
+}
+
+namespace boost { namespace serialization {
+
+template <class Archive>
+void save_construct_data(Archive &, const pagmo::process_island *, const unsigned int);
+
+template <class Archive>
+inline void load_construct_data(Archive &, pagmo::process_island *, const unsigned int);
+
+}}
+
+namespace pagmo
+{
+
+/// Process island class.
+/**
+ * This island class evolves its population in a worker process forked on the local machine. This class can be used like any other island class.
+ *
+ * The worker process is forked at the first evolution of the island, and it is kept alive until the island is destroyed. The first time the island
+ * is evolved, a session holding a copy of its population and algorithm is opened in the worker process. Subsequent evolutions transfer only the state
+ * of the population (see population::state_proxy) through a local socket, until the algorithm or the problem of the island are changed.
+ * The individuals are not serialized: they are copied as fixed-layout records of doubles into a memory region shared with the worker process,
+ * which is sized according to the population when the worker process is forked (if the population outgrows it, a new worker process is forked).
+ * The classes of the problem and of the algorithm must hence be serializable, as for pagmo::mpi_island.
+ *
+ * Since each island evolves in its own process, problems and algorithms which are not thread-safe (e.g., wrappers of third-party solvers using
+ * global state) can be evolved in parallel. Moreover, a crash of the worker process does not bring down the program: the evolution fails
+ * (and the failure is reported like any other failed evolution), the population of the island is left untouched, and a new worker process is forked at the
+ * next evolution.
+ *
+ * As the worker process is forked from a multi-threaded program, in the worker process algorithms and problems should not start threads
+ * or wait for other threads. The process-wide thread pool can be used (see util::thread_pool::get_default()), but all its loops are executed serially.
+ *
+ * <b>NOTE</b>: this class is available only on POSIX systems.
+ */
+class __PAGMO_VISIBLE process_island: public base_island
+{
+		template <class Archive>
+		friend void boost::serialization::save_construct_data(Archive &, const pagmo::process_island *, const unsigned int);
+		template <class Archive>
+		friend void boost::serialization::load_construct_data(Archive &, pagmo::process_island *, const unsigned int);
+	public:
+		process_island(const process_island &);
+		explicit process_island(const algorithm::base &, const problem::base &, int = 0,
+			const migration::base_s_policy & = migration::best_s_policy(),
+			const migration::base_r_policy & = migration::fair_r_policy());
+		explicit process_island(const algorithm::base &, const population &,
+			const migration::base_s_policy & = migration::best_s_policy(),
+			const migration::base_r_policy & = migration::fair_r_policy());
+		process_island &operator=(const process_island &);
+		~process_island();
+		base_island_ptr clone() const;
+	protected:
+		void perform_evolution(const algorithm::base &, population &) const;
+		bool blocking() const;
+	public:
+		std::string get_name() const;
+	private:
+		friend class boost::serialization::access;
+		template <class Archive>
+		void serialize(Archive &ar, const unsigned int)
+		{
+			// Join is already done in base_island.
+			ar & boost::serialization::base_object<base_island>(*this);
+		}
+		void close_session() const;
+		// Handle to the worker process.
+		struct worker_process;
+		// Worker process, null if it has not been forked yet.
+		mutable boost::shared_ptr<worker_process>	m_worker;
+		// Algorithm and problem of the session open in the worker process. They are kept alive, so that their addresses identify them.
+		mutable algorithm::base_ptr			m_session_algo;
+		mutable problem::base_ptr			m_session_prob;
+};
+
+}
+
+namespace boost { namespace serialization {
+
+template <class Archive>
+inline void save_construct_data(Archive &ar, const pagmo::process_island *isl, const unsigned int)
+{
+	// Save data required to construct instance.
+	pagmo::algorithm::base_ptr algo = isl->m_algo->clone();
+	pagmo::problem::base_ptr prob = isl->m_pop.problem().clone();
+	ar << algo;
+	ar << prob;
+}
+
+template <class Archive>
+inline void load_construct_data(Archive &ar, pagmo::process_island *isl, const unsigned int)
+{
+	// Retrieve data from archive required to construct new instance.
+	pagmo::algorithm::base_ptr algo;
+	pagmo::problem::base_ptr prob;
+	ar >> algo;
+	ar >> prob;
+	// Invoke inplace constructor to initialize instance of the algorithm.
+	::new(isl)pagmo::process_island(*algo,*prob);
+}
+
+}} //namespaces
+
+BOOST_CLASS_EXPORT_KEY(pagmo::process_island)
+
+#endif
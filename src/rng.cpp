@@ -26,6 +26,10 @@
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 
+#ifndef _WIN32
+	#include <pthread.h>
+#endif
+
 #include "rng.h"
 
 namespace pagmo
@@ -61,4 +65,22 @@ Rng rng_generator::get()
 template __PAGMO_VISIBLE rng_double rng_generator::get<rng_double>();
 template __PAGMO_VISIBLE rng_uint32 rng_generator::get<rng_uint32>();
 
+#ifndef _WIN32
+
+// The mutex is held across fork(), so that a child process (e.g., the worker of a pagmo::process_island) never inherits it
+// locked by another thread.
+const int rng_generator::m_fork_handlers = ::pthread_atfork(&rng_generator::lock_mutex,&rng_generator::unlock_mutex,&rng_generator::unlock_mutex);
+
+void rng_generator::lock_mutex()
+{
+	m_mutex.lock();
+}
+
+void rng_generator::unlock_mutex()
+{
+	m_mutex.unlock();
+}
+
+#endif
+
 }
@@ -153,6 +153,11 @@ class __PAGMO_VISIBLE rng_generator {
 	private:
 		static  boost::mutex  m_mutex;
 		static  rng_uint32  m_seeder;
+#ifndef _WIN32
+		static void lock_mutex();
+		static void unlock_mutex();
+		static const int m_fork_handlers;
+#endif
 };
 
 }
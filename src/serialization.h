@@ -46,6 +46,8 @@
 #include <boost/serialization/utility.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/version.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <limits>
 
 // Serialization of circular buffer, unordered map.
@@ -62,16 +64,27 @@
 
 namespace pagmo {
 
-/// Custom save function for the serialization of vector of doubles that handle also inf and NaN.
+namespace detail {
+
+// Binary archives store doubles bit by bit, hence they handle inf and NaN natively.
 template <class Archive>
-void custom_vector_double_save(Archive &ar, const std::vector<double> &v, const unsigned int)
+struct is_binary_archive: boost::integral_constant<bool,
+	boost::is_same<Archive,boost::archive::binary_oarchive>::value || boost::is_same<Archive,boost::archive::binary_iarchive>::value>
+{};
+
+template <class Archive>
+inline void vector_double_save_elements(Archive &ar, const std::vector<double> &v, const boost::true_type &)
+{
+	if (!v.empty()) {
+		ar.save_binary(&v[0],v.size() * sizeof(double));
+	}
+}
+
+template <class Archive>
+inline void vector_double_save_elements(Archive &ar, const std::vector<double> &v, const boost::false_type &)
 {
-	const std::vector<double>::size_type size = v.size();
-	// Save size.
-	ar << size;
-	// Save elements.
 	std::string tmp;
-	for (std::vector<double>::size_type i = 0; i < size; ++i) {
+	for (std::vector<double>::size_type i = 0; i < v.size(); ++i) {
 		if (boost::math::isnan(v[i])) {
 			tmp = "nan";
 		} else if (boost::math::isinf(v[i])) {
@@ -87,16 +100,19 @@ void custom_vector_double_save(Archive &ar, const std::vector<double> &v, const
 	}
 }
 
-/// Custom load function for the serialization of vector of doubles that handle also inf and NaN.
 template <class Archive>
-void custom_vector_double_load(Archive &ar, std::vector<double> &v, const unsigned int)
+inline void vector_double_load_elements(Archive &ar, std::vector<double> &v, const boost::true_type &)
+{
+	if (!v.empty()) {
+		ar.load_binary(&v[0],v.size() * sizeof(double));
+	}
+}
+
+template <class Archive>
+inline void vector_double_load_elements(Archive &ar, std::vector<double> &v, const boost::false_type &)
 {
-	std::vector<double>::size_type size = 0;
-	// Load size.
-	ar >> size;
-	v.resize(size);
 	std::string tmp;
-	for (std::vector<double>::size_type i = 0; i < size; ++i) {
+	for (std::vector<double>::size_type i = 0; i < v.size(); ++i) {
 		ar >> tmp;
 		if (tmp == "nan") {
 			v[i] = std::numeric_limits<double>::quiet_NaN();
@@ -112,6 +128,34 @@ void custom_vector_double_load(Archive &ar, std::vector<double> &v, const unsign
 
 }
 
+/// Custom save function for the serialization of vector of doubles that handle also inf and NaN.
+/**
+ * Text archives store each element as a string, binary archives store the raw bits of the elements.
+ */
+template <class Archive>
+void custom_vector_double_save(Archive &ar, const std::vector<double> &v, const unsigned int)
+{
+	const std::vector<double>::size_type size = v.size();
+	// Save size.
+	ar << size;
+	// Save elements.
+	detail::vector_double_save_elements(ar,v,detail::is_binary_archive<Archive>());
+}
+
+/// Custom load function for the serialization of vector of doubles that handle also inf and NaN.
+template <class Archive>
+void custom_vector_double_load(Archive &ar, std::vector<double> &v, const unsigned int)
+{
+	std::vector<double>::size_type size = 0;
+	// Load size.
+	ar >> size;
+	v.resize(size);
+	// Load elements.
+	detail::vector_double_load_elements(ar,v,detail::is_binary_archive<Archive>());
+}
+
+}
+
 namespace boost { namespace serialization {
 
 template <class Archive>
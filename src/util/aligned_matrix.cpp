@@ -0,0 +1,217 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "../exceptions.h"
+#include "aligned_matrix.h"
+
+namespace pagmo { namespace util {
+
+const aligned_matrix::size_type aligned_matrix::alignment;
+
+/// Default constructor.
+/**
+ * Will build an empty matrix.
+ */
+aligned_matrix::aligned_matrix():m_offset(0),m_rows(0),m_cols(0),m_stride(0) {}
+
+/// Constructor from dimensions.
+/**
+ * The elements are initialised to zero.
+ *
+ * @param[in] rows number of rows.
+ * @param[in] cols number of columns.
+ */
+aligned_matrix::aligned_matrix(size_type rows, size_type cols):m_offset(0),m_rows(0),m_cols(0),m_stride(0)
+{
+	allocate(rows,cols);
+}
+
+/// Copy constructor.
+/**
+ * The alignment offset depends on the address of the buffer, hence it is recomputed for the new buffer.
+ *
+ * @param[in] other matrix to be copied.
+ */
+aligned_matrix::aligned_matrix(const aligned_matrix &other):m_offset(0),m_rows(0),m_cols(0),m_stride(0)
+{
+	allocate(other.m_rows,other.m_cols);
+	std::copy(other.data(),other.data() + m_rows * m_stride,data());
+}
+
+/// Assignment operator.
+/**
+ * @param[in] other matrix to be assigned.
+ *
+ * @return reference to this.
+ */
+aligned_matrix &aligned_matrix::operator=(const aligned_matrix &other)
+{
+	if (this != &other) {
+		if (m_rows != other.m_rows || m_cols != other.m_cols) {
+			allocate(other.m_rows,other.m_cols);
+		}
+		std::copy(other.data(),other.data() + m_rows * m_stride,data());
+	}
+	return *this;
+}
+
+/// Number of rows.
+/**
+ * @return the number of rows.
+ */
+aligned_matrix::size_type aligned_matrix::rows() const
+{
+	return m_rows;
+}
+
+/// Number of columns.
+/**
+ * @return the number of columns.
+ */
+aligned_matrix::size_type aligned_matrix::cols() const
+{
+	return m_cols;
+}
+
+/// Row stride.
+/**
+ * @return the distance, in number of elements, between the beginnings of two consecutive rows. It is a multiple of the number
+ * of doubles fitting in aligned_matrix::alignment bytes.
+ */
+aligned_matrix::size_type aligned_matrix::stride() const
+{
+	return m_stride;
+}
+
+/// Const pointer to the data.
+/**
+ * @return const pointer to the first element of the first row (null if the matrix is empty).
+ */
+const double *aligned_matrix::data() const
+{
+	return m_storage.empty() ? 0 : &m_storage[0] + m_offset;
+}
+
+/// Pointer to the data.
+/**
+ * @return pointer to the first element of the first row (null if the matrix is empty).
+ */
+double *aligned_matrix::data()
+{
+	return m_storage.empty() ? 0 : &m_storage[0] + m_offset;
+}
+
+/// Const pointer to a row.
+/**
+ * @param[in] i index of the row.
+ *
+ * @return const pointer to the first element of row i.
+ */
+const double *aligned_matrix::row(size_type i) const
+{
+	pagmo_assert(i < m_rows);
+	return data() + i * m_stride;
+}
+
+/// Pointer to a row.
+/**
+ * @param[in] i index of the row.
+ *
+ * @return pointer to the first element of row i.
+ */
+double *aligned_matrix::row(size_type i)
+{
+	pagmo_assert(i < m_rows);
+	return data() + i * m_stride;
+}
+
+/// Reset dimensions.
+/**
+ * The content of the matrix is discarded and the elements are initialised to zero.
+ *
+ * @param[in] rows new number of rows.
+ * @param[in] cols new number of columns.
+ */
+void aligned_matrix::reset(size_type rows, size_type cols)
+{
+	allocate(rows,cols);
+}
+
+/// Set a row.
+/**
+ * If the size of v differs from the number of columns, the row is filled with quiet NaNs instead.
+ *
+ * @param[in] i index of the row.
+ * @param[in] v values of the row.
+ */
+void aligned_matrix::set_row(size_type i, const std::vector<double> &v)
+{
+	pagmo_assert(i < m_rows);
+	if (v.size() == m_cols) {
+		std::copy(v.begin(),v.end(),row(i));
+	} else {
+		std::fill(row(i),row(i) + m_cols,std::numeric_limits<double>::quiet_NaN());
+	}
+}
+
+/// Get a row.
+/**
+ * @param[in] i index of the row.
+ *
+ * @return copy of row i.
+ */
+std::vector<double> aligned_matrix::get_row(size_type i) const
+{
+	pagmo_assert(i < m_rows);
+	return std::vector<double>(row(i),row(i) + m_cols);
+}
+
+// Allocate a zero-initialised buffer for the given dimensions.
+void aligned_matrix::allocate(size_type rows, size_type cols)
+{
+	const size_type n_align = alignment / sizeof(double);
+	const size_type stride = ((cols + n_align - 1) / n_align) * n_align;
+	if (stride && rows > (std::numeric_limits<size_type>::max() - n_align) / stride) {
+		pagmo_throw(memory_error,"matrix dimensions are too large");
+	}
+	std::vector<double> storage((rows && stride) ? rows * stride + n_align - 1 : 0);
+	size_type offset = 0;
+	if (!storage.empty()) {
+		const size_type misalignment = reinterpret_cast<std::size_t>(&storage[0]) % alignment;
+		offset = misalignment ? (alignment - misalignment) / sizeof(double) : 0;
+	}
+	m_storage.swap(storage);
+	m_offset = offset;
+	m_rows = rows;
+	m_cols = cols;
+	m_stride = stride;
+}
+
+}}
@@ -0,0 +1,79 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_ALIGNED_MATRIX_H
+#define PAGMO_UTIL_ALIGNED_MATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+
+namespace pagmo { namespace util {
+
+/// Dense matrix of doubles with aligned rows.
+/**
+ * Row-major matrix stored in a single contiguous buffer. The beginning of the buffer is aligned to aligned_matrix::alignment bytes,
+ * and the rows are padded so that each of them starts on an aligned address as well. Hence kernels streaming over the rows
+ * can use aligned vector loads, and copying a matrix amounts to a single block copy.
+ *
+ * The padding elements have unspecified values.
+ */
+class __PAGMO_VISIBLE aligned_matrix
+{
+	public:
+		/// Size type.
+		typedef std::size_t size_type;
+		/// Alignment of the rows, in bytes.
+		static const size_type alignment = 32;
+		aligned_matrix();
+		aligned_matrix(size_type, size_type);
+		aligned_matrix(const aligned_matrix &);
+		aligned_matrix &operator=(const aligned_matrix &);
+		size_type rows() const;
+		size_type cols() const;
+		size_type stride() const;
+		const double *data() const;
+		double *data();
+		const double *row(size_type) const;
+		double *row(size_type);
+		void reset(size_type, size_type);
+		void set_row(size_type, const std::vector<double> &);
+		std::vector<double> get_row(size_type) const;
+	private:
+		void allocate(size_type, size_type);
+		// Over-allocated storage.
+		std::vector<double>	m_storage;
+		// Offset of the first aligned element in the storage.
+		size_type		m_offset;
+		size_type		m_rows;
+		size_type		m_cols;
+		// Distance between the beginnings of two consecutive rows.
+		size_type		m_stride;
+};
+
+}}
+
+#endif
@@ -0,0 +1,227 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <cstddef>
+
+#include "../exceptions.h"
+#include "lru_cache.h"
+
+namespace pagmo { namespace util {
+
+// Keys containing NaNs are kept out of the cache, as their comparisons cannot be relied upon (especially when compiling with -ffast-math).
+static bool has_nan(const lru_cache::key_type &key)
+{
+	for (lru_cache::key_type::size_type i = 0; i < key.size(); ++i) {
+		if (boost::math::isnan(key[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/// Constructor from capacity.
+/**
+ * A cache with null capacity never stores anything.
+ *
+ * @param[in] capacity maximum number of entries.
+ */
+lru_cache::lru_cache(size_type capacity):m_capacity(capacity),m_hits(0),m_misses(0) {}
+
+/// Copy constructor.
+/**
+ * The hash index refers to the entries of the copied cache, hence it is rebuilt from scratch.
+ *
+ * @param[in] other cache to be copied.
+ */
+lru_cache::lru_cache(const lru_cache &other):m_entries(other.m_entries),m_capacity(other.m_capacity),
+	m_hits(other.m_hits),m_misses(other.m_misses)
+{
+	rebuild_index();
+}
+
+/// Assignment operator.
+/**
+ * @param[in] other cache to be assigned.
+ *
+ * @return reference to this.
+ */
+lru_cache &lru_cache::operator=(const lru_cache &other)
+{
+	if (this != &other) {
+		m_entries = other.m_entries;
+		m_capacity = other.m_capacity;
+		m_hits = other.m_hits;
+		m_misses = other.m_misses;
+		rebuild_index();
+	}
+	return *this;
+}
+
+/// Lookup.
+/**
+ * If key is in the cache, its mapped value will be copied into value and the entry will become the most recently used one.
+ * Otherwise (or if key contains NaNs), value is left untouched. The outcome is recorded in the hit/miss statistics.
+ *
+ * @param[in] key key to be looked up.
+ * @param[out] value value associated to key.
+ *
+ * @return true if key was found, false otherwise.
+ */
+bool lru_cache::find(const key_type &key, mapped_type &value)
+{
+	const index_type::const_iterator it = has_nan(key) ? m_index.end() : m_index.find(key);
+	if (it == m_index.end()) {
+		++m_misses;
+		return false;
+	}
+	++m_hits;
+	m_entries.splice(m_entries.begin(),m_entries,it->second);
+	value = it->second->second;
+	return true;
+}
+
+/// Insertion.
+/**
+ * The entry will become the most recently used one. If key is already in the cache, its mapped value is replaced.
+ * Otherwise, the least recently used entry is evicted if the cache is full. Keys containing NaNs are not stored.
+ *
+ * @param[in] key key of the new entry.
+ * @param[in] value value to be associated to key.
+ */
+void lru_cache::insert(const key_type &key, const mapped_type &value)
+{
+	if (!m_capacity || has_nan(key)) {
+		return;
+	}
+	const index_type::iterator it = m_index.find(key);
+	if (it != m_index.end()) {
+		m_entries.splice(m_entries.begin(),m_entries,it->second);
+		it->second->second = value;
+		return;
+	}
+	m_entries.push_front(list_type::value_type(key,value));
+	try {
+		m_index.insert(index_type::value_type(key,m_entries.begin()));
+	} catch (...) {
+		m_entries.pop_front();
+		throw;
+	}
+	shrink();
+}
+
+/// Remove all entries.
+/**
+ * Capacity and statistics are not affected.
+ */
+void lru_cache::clear()
+{
+	m_index.clear();
+	m_entries.clear();
+}
+
+/// Number of entries.
+/**
+ * @return the number of entries currently stored in the cache.
+ */
+lru_cache::size_type lru_cache::size() const
+{
+	return m_entries.size();
+}
+
+/// Get capacity.
+/**
+ * @return the maximum number of entries.
+ */
+lru_cache::size_type lru_cache::get_capacity() const
+{
+	return m_capacity;
+}
+
+/// Set capacity.
+/**
+ * If the new capacity is smaller than the current number of entries, the least recently used entries are evicted.
+ *
+ * @param[in] capacity new maximum number of entries.
+ */
+void lru_cache::set_capacity(size_type capacity)
+{
+	m_capacity = capacity;
+	shrink();
+}
+
+/// Number of hits.
+/**
+ * @return the number of successful calls to find() since construction or since the last call to reset_statistics().
+ */
+std::size_t lru_cache::get_hits() const
+{
+	return m_hits;
+}
+
+/// Number of misses.
+/**
+ * @return the number of unsuccessful calls to find() since construction or since the last call to reset_statistics().
+ */
+std::size_t lru_cache::get_misses() const
+{
+	return m_misses;
+}
+
+/// Reset statistics.
+/**
+ * Set to zero the number of hits and misses.
+ */
+void lru_cache::reset_statistics()
+{
+	m_hits = 0;
+	m_misses = 0;
+}
+
+// Index the entries from scratch, dropping duplicate keys (only the most recently used one is kept).
+void lru_cache::rebuild_index()
+{
+	m_index.clear();
+	for (list_type::iterator it = m_entries.begin(); it != m_entries.end();) {
+		if (m_index.insert(index_type::value_type(it->first,it)).second) {
+			++it;
+		} else {
+			it = m_entries.erase(it);
+		}
+	}
+	shrink();
+}
+
+// Evict the least recently used entries until the size fits the capacity.
+void lru_cache::shrink()
+{
+	while (m_entries.size() > m_capacity) {
+		const std::size_t n_erased = m_index.erase(m_entries.back().first);
+		pagmo_assert(n_erased == 1);
+		(void)n_erased;
+		m_entries.pop_back();
+	}
+}
+
+}}
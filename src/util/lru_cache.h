@@ -0,0 +1,125 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_LRU_CACHE_H
+#define PAGMO_UTIL_LRU_CACHE_H
+
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include <cstddef>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "../config.h"
+#include "../serialization.h"
+
+namespace pagmo { namespace util {
+
+/// Least-recently-used cache of vectors of doubles.
+/**
+ * Associates vectors of doubles (e.g., decision vectors) to vectors of doubles (e.g., fitness or constraint vectors).
+ * The entries are kept in a list sorted by recency of use and indexed by a hash table, so that both lookups and insertions
+ * have constant average complexity. When the number of entries exceeds the capacity, the least recently used entry is evicted.
+ *
+ * Keys are compared element-wise with operator==(), like std::vector does, hence zeroes of different sign are considered equal
+ * (and hash to the same value). Keys containing NaNs are never stored, hence they never produce a hit.
+ *
+ * The number of hits and misses of lookups are recorded, and can be queried via get_hits() and get_misses().
+ *
+ * The class is not thread-safe: concurrent access must be synchronised externally.
+ */
+class __PAGMO_VISIBLE lru_cache
+{
+	public:
+		/// Key type.
+		typedef std::vector<double> key_type;
+		/// Mapped value type.
+		typedef std::vector<double> mapped_type;
+		/// Size type.
+		typedef std::size_t size_type;
+	private:
+		typedef std::list<std::pair<key_type,mapped_type> > list_type;
+		typedef boost::unordered_map<key_type,list_type::iterator,boost::hash<key_type> > index_type;
+	public:
+		explicit lru_cache(size_type = 0);
+		lru_cache(const lru_cache &);
+		lru_cache &operator=(const lru_cache &);
+		bool find(const key_type &, mapped_type &);
+		void insert(const key_type &, const mapped_type &);
+		void clear();
+		size_type size() const;
+		size_type get_capacity() const;
+		void set_capacity(size_type);
+		std::size_t get_hits() const;
+		std::size_t get_misses() const;
+		void reset_statistics();
+	private:
+		void rebuild_index();
+		void shrink();
+		friend class boost::serialization::access;
+		template <class Archive>
+		void save(Archive &ar, const unsigned int version) const
+		{
+			ar << m_capacity;
+			ar << m_hits;
+			ar << m_misses;
+			const size_type size = m_entries.size();
+			ar << size;
+			for (list_type::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+				custom_vector_double_save(ar,it->first,version);
+				custom_vector_double_save(ar,it->second,version);
+			}
+		}
+		template <class Archive>
+		void load(Archive &ar, const unsigned int version)
+		{
+			ar >> m_capacity;
+			ar >> m_hits;
+			ar >> m_misses;
+			size_type size;
+			ar >> size;
+			m_entries.clear();
+			for (size_type i = 0; i < size; ++i) {
+				m_entries.push_back(list_type::value_type());
+				custom_vector_double_load(ar,m_entries.back().first,version);
+				custom_vector_double_load(ar,m_entries.back().second,version);
+			}
+			rebuild_index();
+		}
+		BOOST_SERIALIZATION_SPLIT_MEMBER()
+		// Entries, from the most to the least recently used.
+		list_type	m_entries;
+		// Hash index into the entries.
+		index_type	m_index;
+		// Maximum number of entries.
+		size_type	m_capacity;
+		// Lookup statistics.
+		std::size_t	m_hits;
+		std::size_t	m_misses;
+};
+
+}}
+
+#endif
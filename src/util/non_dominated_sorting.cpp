@@ -0,0 +1,286 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <cstddef>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../types.h"
+#include "non_dominated_sorting.h"
+
+namespace pagmo { namespace util {
+
+// Lexicographic comparison of the rows of a row-major matrix. Ties are broken by row index, so that the sorting is deterministic.
+struct non_dominated_sorting::lexicographic_comparison
+{
+	lexicographic_comparison(const std::vector<double> &data, std::size_t m):m_data(data),m_m(m) {}
+	bool operator()(std::size_t a, std::size_t b) const
+	{
+		const double *ra = &m_data[a * m_m], *rb = &m_data[b * m_m];
+		for (std::size_t i = 0; i < m_m; ++i) {
+			if (ra[i] < rb[i]) {
+				return true;
+			}
+			if (rb[i] < ra[i]) {
+				return false;
+			}
+		}
+		return a < b;
+	}
+	const std::vector<double>	&m_data;
+	const std::size_t		m_m;
+};
+
+/// Compute Pareto ranks.
+/**
+ * @param[in] f fitness vectors to be sorted.
+ *
+ * @return a vector containing, for each fitness vector in f, the index of the Pareto front it belongs to.
+ *
+ * @throws value_error if the fitness vectors do not all have the same dimension.
+ */
+std::vector<std::size_t> non_dominated_sorting::compute_ranks(const std::vector<fitness_vector> &f)
+{
+	const std::size_t n = f.size();
+	std::vector<std::size_t> ranks(n,0);
+	if (!n) {
+		return ranks;
+	}
+	const std::size_t m = f[0].size();
+	// Copy the fitness vectors into a contiguous matrix, checking for NaNs along the way.
+	std::vector<double> data;
+	data.reserve(n * m);
+	for (std::size_t i = 0; i < n; ++i) {
+		if (f[i].size() != m) {
+			pagmo_throw(value_error,"fitness vectors must all have the same dimension");
+		}
+		for (std::size_t j = 0; j < m; ++j) {
+			if (boost::math::isnan(f[i][j])) {
+				return compute_ranks_pairwise(f);
+			}
+			data.push_back(f[i][j]);
+		}
+	}
+	if (!m) {
+		return ranks;
+	}
+	std::vector<std::size_t> order(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		order[i] = i;
+	}
+	std::sort(order.begin(),order.end(),lexicographic_comparison(data,m));
+	switch (m) {
+		case 1:
+			sort_1d(ranks,data,order);
+			break;
+		case 2:
+			sort_2d(ranks,data,order);
+			break;
+		default:
+			sort_ens_bs(ranks,data,order,m);
+	}
+	return ranks;
+}
+
+/// Compute Pareto ranks by pairwise comparison.
+/**
+ * Reference implementation, comparing all the pairs of fitness vectors and peeling off the fronts one after the other
+ * (as in Deb's fast non-dominated sort). Its complexity is O(M N^2) in all cases.
+ *
+ * @param[in] f fitness vectors to be sorted.
+ *
+ * @return a vector containing, for each fitness vector in f, the index of the Pareto front it belongs to.
+ *
+ * @throws value_error if the fitness vectors do not all have the same dimension.
+ */
+std::vector<std::size_t> non_dominated_sorting::compute_ranks_pairwise(const std::vector<fitness_vector> &f)
+{
+	const std::size_t n = f.size();
+	std::vector<std::size_t> ranks(n,0);
+	if (!n) {
+		return ranks;
+	}
+	const std::size_t m = f[0].size();
+	for (std::size_t i = 0; i < n; ++i) {
+		if (f[i].size() != m) {
+			pagmo_throw(value_error,"fitness vectors must all have the same dimension");
+		}
+	}
+	if (!m) {
+		return ranks;
+	}
+	std::vector<std::vector<std::size_t> > dom_list(n);
+	std::vector<std::size_t> dom_count(n,0);
+	for (std::size_t i = 0; i < n; ++i) {
+		for (std::size_t j = i + 1; j < n; ++j) {
+			if (dominates(&f[i][0],&f[j][0],m)) {
+				dom_list[i].push_back(j);
+				++dom_count[j];
+			} else if (dominates(&f[j][0],&f[i][0],m)) {
+				dom_list[j].push_back(i);
+				++dom_count[i];
+			}
+		}
+	}
+	std::vector<std::size_t> front, next;
+	for (std::size_t i = 0; i < n; ++i) {
+		if (!dom_count[i]) {
+			front.push_back(i);
+		}
+	}
+	for (std::size_t rank = 0; !front.empty(); ++rank) {
+		for (std::size_t i = 0; i < front.size(); ++i) {
+			ranks[front[i]] = rank;
+			for (std::size_t j = 0; j < dom_list[front[i]].size(); ++j) {
+				if (!--dom_count[dom_list[front[i]][j]]) {
+					next.push_back(dom_list[front[i]][j]);
+				}
+			}
+		}
+		front.swap(next);
+		next.clear();
+	}
+	return ranks;
+}
+
+/// Compute Pareto fronts.
+/**
+ * @param[in] f fitness vectors to be sorted.
+ *
+ * @return the Pareto fronts of f, from the best to the worst.
+ *
+ * @throws value_error if the fitness vectors do not all have the same dimension.
+ */
+non_dominated_sorting::fronts_type non_dominated_sorting::compute_fronts(const std::vector<fitness_vector> &f)
+{
+	return ranks_to_fronts(compute_ranks(f));
+}
+
+/// Group indices by rank.
+/**
+ * @param[in] ranks Pareto ranks, as returned by compute_ranks().
+ *
+ * @return a vector containing, for each rank, the positional indices in ranks having that rank.
+ */
+non_dominated_sorting::fronts_type non_dominated_sorting::ranks_to_fronts(const std::vector<std::size_t> &ranks)
+{
+	fronts_type retval;
+	for (std::size_t i = 0; i < ranks.size(); ++i) {
+		if (ranks[i] >= retval.size()) {
+			retval.resize(ranks[i] + 1);
+		}
+		retval[ranks[i]].push_back(i);
+	}
+	return retval;
+}
+
+// Pareto dominance of a over b, with the same semantics as problem::base::compare_fitness_impl() (NaNs never dominate nor are dominated).
+bool non_dominated_sorting::dominates(const double *a, const double *b, std::size_t m)
+{
+	bool strict = false;
+	for (std::size_t i = 0; i < m; ++i) {
+		if (!(a[i] <= b[i])) {
+			return false;
+		}
+		if (a[i] < b[i]) {
+			strict = true;
+		}
+	}
+	return strict;
+}
+
+// Single objective: ranks are given by the distinct fitness values in ascending order.
+void non_dominated_sorting::sort_1d(std::vector<std::size_t> &ranks, const std::vector<double> &data, const std::vector<std::size_t> &order)
+{
+	std::size_t rank = 0;
+	ranks[order[0]] = 0;
+	for (std::size_t k = 1; k < order.size(); ++k) {
+		if (data[order[k - 1]] < data[order[k]]) {
+			++rank;
+		}
+		ranks[order[k]] = rank;
+	}
+}
+
+// Two objectives. As the vectors are visited in lexicographic order, a vector is dominated by a front if and only if it is dominated
+// by the last vector added to that front (the one with the smallest second objective). Moreover, if a vector is dominated by a front, it is
+// dominated by all the preceding fronts, hence the front of each vector can be found by binary search.
+void non_dominated_sorting::sort_2d(std::vector<std::size_t> &ranks, const std::vector<double> &data, const std::vector<std::size_t> &order)
+{
+	std::vector<std::size_t> last;
+	for (std::size_t k = 0; k < order.size(); ++k) {
+		const std::size_t p = order[k];
+		std::size_t lo = 0, hi = last.size();
+		while (lo < hi) {
+			const std::size_t mid = lo + (hi - lo) / 2;
+			if (dominates(&data[last[mid] * 2],&data[p * 2],2)) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		if (lo == last.size()) {
+			last.push_back(p);
+		} else {
+			last[lo] = p;
+		}
+		ranks[p] = lo;
+	}
+}
+
+// Efficient non-dominated sort with binary search. Vectors visited in lexicographic order can only be dominated by vectors already
+// assigned to a front, and the fronts can be searched by bisection as in the two-objective case. Within a front, the most recently added
+// vectors are checked first, as they are the closest ones in lexicographic order.
+void non_dominated_sorting::sort_ens_bs(std::vector<std::size_t> &ranks, const std::vector<double> &data, const std::vector<std::size_t> &order, std::size_t m)
+{
+	fronts_type fronts;
+	for (std::size_t k = 0; k < order.size(); ++k) {
+		const std::size_t p = order[k];
+		const double *rp = &data[p * m];
+		std::size_t lo = 0, hi = fronts.size();
+		while (lo < hi) {
+			const std::size_t mid = lo + (hi - lo) / 2;
+			const std::vector<std::size_t> &front = fronts[mid];
+			bool dominated = false;
+			for (std::size_t i = front.size(); i > 0 && !dominated; --i) {
+				dominated = dominates(&data[front[i - 1] * m],rp,m);
+			}
+			if (dominated) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		if (lo == fronts.size()) {
+			fronts.push_back(std::vector<std::size_t>());
+		}
+		fronts[lo].push_back(p);
+		ranks[p] = lo;
+	}
+}
+
+}}
@@ -0,0 +1,79 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_NON_DOMINATED_SORTING_H
+#define PAGMO_UTIL_NON_DOMINATED_SORTING_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+#include "../types.h"
+
+namespace pagmo { namespace util {
+
+/// Non-dominated sorting.
+/**
+ * Partitions a set of fitness vectors into Pareto fronts, according to the standard Pareto dominance for minimisation: a vector
+ * dominates another one if none of its components is greater, and at least one is smaller. The first front contains the non-dominated
+ * vectors, the second front the vectors which are non-dominated once the first front is removed, and so on. The rank of a vector is
+ * the index of its front.
+ *
+ * The fitness vectors are copied into a contiguous row-major matrix and sorted lexicographically, so that every vector is processed
+ * after all the vectors that can dominate it. The algorithm is then chosen according to the number of objectives M:
+ * - for M = 1, the fronts are the groups of equal fitness values, in ascending order;
+ * - for M = 2, each vector is assigned to a front by binary search over the last vectors inserted into the fronts,
+ *   with an overall complexity of O(N log N);
+ * - for M > 2, the efficient non-dominated sort with binary search (ENS-BS) is used, whose worst-case complexity is O(M N^2) but
+ *   which in practice performs far fewer dominance checks than the pairwise comparison of all the vectors.
+ *
+ * If NaNs are present, the lexicographic order is not defined and the pairwise comparison of all the vectors is used instead.
+ *
+ * @see Zhang, X., Tian, Y., Cheng, R., Jin, Y., "An efficient approach to nondominated sorting for evolutionary multiobjective optimization",
+ * IEEE Transactions on Evolutionary Computation 19(2), 2015.
+ */
+class __PAGMO_VISIBLE non_dominated_sorting
+{
+	public:
+		/// Fronts type.
+		/**
+		 * Each front is a vector of positional indices of the input fitness vectors, in ascending order.
+		 */
+		typedef std::vector<std::vector<std::size_t> > fronts_type;
+		static std::vector<std::size_t> compute_ranks(const std::vector<fitness_vector> &);
+		static std::vector<std::size_t> compute_ranks_pairwise(const std::vector<fitness_vector> &);
+		static fronts_type compute_fronts(const std::vector<fitness_vector> &);
+		static fronts_type ranks_to_fronts(const std::vector<std::size_t> &);
+	private:
+		struct lexicographic_comparison;
+		static bool dominates(const double *, const double *, std::size_t);
+		static void sort_1d(std::vector<std::size_t> &, const std::vector<double> &, const std::vector<std::size_t> &);
+		static void sort_2d(std::vector<std::size_t> &, const std::vector<double> &, const std::vector<std::size_t> &);
+		static void sort_ens_bs(std::vector<std::size_t> &, const std::vector<double> &, const std::vector<std::size_t> &, std::size_t);
+};
+
+}}
+
+#endif
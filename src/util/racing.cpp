@@ -85,6 +85,7 @@ void racing_population::set_fc(const size_type idx, const fitness_vector &f, con
 	m_container[idx].best_f = f;
 	m_container[idx].best_c = c;
 	update_dom(idx);
+	update_extrema(idx);
 }
 
 
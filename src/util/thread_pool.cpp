@@ -0,0 +1,334 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+#include <cstddef>
+#include <deque>
+#include <exception>
+
+#ifndef _WIN32
+	#include <pthread.h>
+#endif
+
+#include "../exceptions.h"
+#include "thread_pool.h"
+
+namespace pagmo { namespace util {
+
+// Shared state of a parallel_for() invocation. It is held through a shared pointer, as helper tasks
+// may still be sitting in the queue after the loop has been completed by other threads.
+struct thread_pool::loop_state
+{
+	loop_state(std::size_t n, const body_type &body):m_n(n),m_next(0),m_done(0),m_body(body) {}
+	const std::size_t		m_n;
+	std::size_t			m_next;
+	std::size_t			m_done;
+	const body_type			m_body;
+	std::exception_ptr		m_error;
+	boost::mutex			m_mutex;
+	boost::condition_variable	m_cond;
+};
+
+// Task queue owned by a worker.
+struct thread_pool::task_queue
+{
+	std::deque<task_type>	m_tasks;
+	boost::mutex		m_mutex;
+};
+
+/// Constructor from number of workers.
+/**
+ * If n is zero, the number of workers will be set to the value returned by boost::thread::hardware_concurrency()
+ * (or to one, if the hardware concurrency cannot be determined).
+ *
+ * @param[in] n number of worker threads.
+ */
+thread_pool::thread_pool(unsigned int n):m_size(n),m_n_tasks(0),m_next_queue(0),m_stop(false),m_forked(false)
+{
+	if (!m_size) {
+		m_size = boost::thread::hardware_concurrency();
+	}
+	if (!m_size) {
+		m_size = 1;
+	}
+	for (unsigned int i = 0; i < m_size; ++i) {
+		m_queues.push_back(boost::shared_ptr<task_queue>(new task_queue()));
+	}
+	for (unsigned int i = 0; i < m_size; ++i) {
+		m_workers.create_thread(boost::bind(&thread_pool::worker_loop,this,i));
+	}
+}
+
+/// Destructor.
+/**
+ * Will wait for all the pending tasks (including those enqueued by the pending tasks themselves) to be completed and join the workers.
+ */
+thread_pool::~thread_pool()
+{
+	{
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_cond.notify_all();
+	m_workers.join_all();
+}
+
+/// Number of workers.
+/**
+ * @return the number of worker threads in the pool, or zero in a child process forked after the creation of the pool
+ * (as the worker threads do not survive the fork).
+ */
+unsigned int thread_pool::size() const
+{
+	return m_forked ? 0u : m_size;
+}
+
+/// Enqueue a task.
+/**
+ * The task will be executed asynchronously by one of the workers. If this method is called from a worker of the pool,
+ * the task is appended to the queue of the calling worker, otherwise it is appended to the queues in round-robin fashion.
+ * Exceptions thrown by the task are swallowed, hence tasks are expected to handle their own errors.
+ *
+ * @param[in] task task to be executed.
+ */
+void thread_pool::enqueue(const task_type &task)
+{
+	unsigned int idx;
+	if (m_worker_idx.get()) {
+		idx = *m_worker_idx;
+	} else {
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		idx = m_next_queue;
+		m_next_queue = (m_next_queue + 1u) % m_size;
+	}
+	// NOTE: the counter is incremented before the task is published, so that it never falls below the number of queued tasks
+	// (a worker may pop the task, and decrement the counter, as soon as the queue mutex is released).
+	{
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		++m_n_tasks;
+	}
+	try {
+		boost::lock_guard<boost::mutex> lock(m_queues[idx]->m_mutex);
+		m_queues[idx]->m_tasks.push_back(task);
+	} catch (...) {
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		--m_n_tasks;
+		throw;
+	}
+	m_cond.notify_one();
+}
+
+/// Parallel loop.
+/**
+ * Will call body(i) for each i in the [0,n[ range, distributing the iterations among the workers of the pool
+ * and the calling thread. The method returns when all the iterations have been completed. The order in which the
+ * iterations are executed is unspecified.
+ *
+ * If one or more iterations throw, the remaining iterations are skipped and the first exception
+ * is re-thrown in the calling thread.
+ *
+ * @param[in] n number of iterations.
+ * @param[in] body loop body.
+ */
+void thread_pool::parallel_for(std::size_t n, const body_type &body)
+{
+	if (!n) {
+		return;
+	}
+	const boost::shared_ptr<loop_state> state(new loop_state(n,body));
+	// The caller takes care of one share of the work, hence we need at most n - 1 helpers (none in a forked child process,
+	// where nobody would ever run them).
+	const std::size_t n_helpers = std::min<std::size_t>(size(),n - 1);
+	for (std::size_t i = 0; i < n_helpers; ++i) {
+		enqueue(boost::bind(&thread_pool::run_loop,state));
+	}
+	run_loop(state);
+	boost::unique_lock<boost::mutex> lock(state->m_mutex);
+	while (state->m_done != state->m_n) {
+		state->m_cond.wait(lock);
+	}
+	if (state->m_error) {
+		std::rethrow_exception(state->m_error);
+	}
+}
+
+/// Test if the calling thread is a worker.
+/**
+ * @return true if the calling thread is one of the workers of the pool, false otherwise.
+ */
+bool thread_pool::is_worker() const
+{
+	return m_worker_idx.get() != 0;
+}
+
+/// Run a pending task.
+/**
+ * Will take a task from the queues of the pool, as a worker would, and execute it in the calling thread. Meant to be called by the
+ * workers of the pool while waiting for the completion of other tasks, so that the tasks being waited for are not stuck
+ * in the queues. Exceptions thrown by the task are swallowed, as in the workers.
+ *
+ * @return true if a task was executed, false if the queues were empty.
+ */
+bool thread_pool::run_pending_task()
+{
+	task_type task;
+	if (!pop_task(m_worker_idx.get() ? *m_worker_idx : 0u,task)) {
+		return false;
+	}
+	try {
+		task();
+	} catch (...) {}
+	return true;
+}
+
+/// Process-wide thread pool.
+/**
+ * @return reference to a thread pool whose size matches the hardware concurrency.
+ */
+thread_pool &thread_pool::get_default()
+{
+	static thread_pool pool;
+#ifndef _WIN32
+	static const int fork_handlers = ::pthread_atfork(&thread_pool::lock_default,&thread_pool::unlock_default,&thread_pool::child_default);
+	(void)fork_handlers;
+#endif
+	return pool;
+}
+
+// Lock the mutexes of the process-wide pool before fork(), so that the child process does not inherit them locked by other threads.
+// NOTE: the mutexes are never held together by the other methods, hence no lock ordering issue arises.
+void thread_pool::lock_default()
+{
+	thread_pool &pool = get_default();
+	pool.m_mutex.lock();
+	for (unsigned int i = 0; i < pool.m_size; ++i) {
+		pool.m_queues[i]->m_mutex.lock();
+	}
+}
+
+// Unlock the mutexes of the process-wide pool after fork(), both in the parent and in the child process.
+void thread_pool::unlock_default()
+{
+	thread_pool &pool = get_default();
+	for (unsigned int i = pool.m_size; i > 0u; --i) {
+		pool.m_queues[i - 1u]->m_mutex.unlock();
+	}
+	pool.m_mutex.unlock();
+}
+
+// Unlock the mutexes of the process-wide pool after fork() in the child process, and mark the pool as having no workers.
+void thread_pool::child_default()
+{
+	unlock_default();
+	get_default().m_forked = true;
+}
+
+// Claim and execute loop iterations until there are none left.
+void thread_pool::run_loop(const boost::shared_ptr<loop_state> &state)
+{
+	while (true) {
+		std::size_t i;
+		bool skip;
+		{
+			boost::lock_guard<boost::mutex> lock(state->m_mutex);
+			if (state->m_next == state->m_n) {
+				return;
+			}
+			i = state->m_next++;
+			skip = static_cast<bool>(state->m_error);
+		}
+		if (!skip) {
+			try {
+				state->m_body(i);
+			} catch (...) {
+				boost::lock_guard<boost::mutex> lock(state->m_mutex);
+				if (!state->m_error) {
+					state->m_error = std::current_exception();
+				}
+			}
+		}
+		boost::lock_guard<boost::mutex> lock(state->m_mutex);
+		if (++state->m_done == state->m_n) {
+			state->m_cond.notify_all();
+		}
+	}
+}
+
+// Take a task from the queue of worker idx or, if it is empty, steal one from the other queues.
+bool thread_pool::pop_task(unsigned int idx, task_type &task)
+{
+	bool found = false;
+	for (unsigned int i = 0; i < m_size && !found; ++i) {
+		task_queue &queue = *m_queues[(idx + i) % m_size];
+		boost::lock_guard<boost::mutex> lock(queue.m_mutex);
+		if (queue.m_tasks.empty()) {
+			continue;
+		}
+		if (i) {
+			task.swap(queue.m_tasks.back());
+			queue.m_tasks.pop_back();
+		} else {
+			task.swap(queue.m_tasks.front());
+			queue.m_tasks.pop_front();
+		}
+		found = true;
+	}
+	if (found) {
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		pagmo_assert(m_n_tasks);
+		--m_n_tasks;
+	}
+	return found;
+}
+
+// Main loop of the worker threads.
+void thread_pool::worker_loop(unsigned int idx)
+{
+	m_worker_idx.reset(new unsigned int(idx));
+	while (true) {
+		task_type task;
+		if (pop_task(idx,task)) {
+			try {
+				task();
+			} catch (...) {}
+			continue;
+		}
+		boost::unique_lock<boost::mutex> lock(m_mutex);
+		while (!m_stop && !m_n_tasks) {
+			m_cond.wait(lock);
+		}
+		if (!m_n_tasks) {
+			pagmo_assert(m_stop);
+			return;
+		}
+	}
+}
+
+}}
@@ -0,0 +1,113 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_THREAD_POOL_H
+#define PAGMO_UTIL_THREAD_POOL_H
+
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "../config.h"
+
+namespace pagmo { namespace util {
+
+/// Fixed-size work-stealing thread pool.
+/**
+ * A set of worker threads, each one owning a queue of tasks. Tasks enqueued from within a worker go to the queue of that worker,
+ * tasks enqueued from other threads are distributed among the queues in round-robin fashion. Workers consume their own queue
+ * in FIFO order and, when it is empty, steal the most recently enqueued tasks from the queues of the other workers.
+ * Hence tasks which re-enqueue themselves (e.g., the evolution of an island, one generation at a time) tend to stay
+ * on the same worker, while idle workers keep on taking load off the busy ones. The workers are started on construction
+ * and joined on destruction, after all the queues have been drained.
+ *
+ * The parallel_for() method distributes the iterations of a loop among the workers. The calling thread
+ * takes part in the execution of the loop, hence parallel_for() can safely be invoked from within a task
+ * already running in the pool: if all the workers are busy, the loop will simply be executed serially by the caller.
+ *
+ * Tasks waiting for the completion of other tasks of the same pool (e.g., the evolution of an island which evolves an archipelago of its own)
+ * must not block the worker running them, as the awaited tasks might be queued behind them. Such tasks can use is_worker() and run_pending_task()
+ * to help the pool while waiting (see base_island::join()).
+ *
+ * A process-wide pool, sized according to the hardware concurrency, is available via get_default().
+ * On POSIX systems, the mutexes of the process-wide pool are held across fork(), so that the pool can still be used in a child process
+ * forked by a multi-threaded program (see pagmo::process_island). As the worker threads do not survive the fork, in the child process
+ * size() returns zero, parallel_for() executes all the iterations in the calling thread without enqueueing helper tasks,
+ * and the tasks enqueued with enqueue() are never executed.
+ */
+class __PAGMO_VISIBLE thread_pool: private boost::noncopyable
+{
+	public:
+		/// Task type.
+		typedef boost::function<void ()> task_type;
+		/// Loop body type for parallel_for().
+		typedef boost::function<void (std::size_t)> body_type;
+		explicit thread_pool(unsigned int = 0);
+		~thread_pool();
+		unsigned int size() const;
+		void enqueue(const task_type &);
+		void parallel_for(std::size_t, const body_type &);
+		bool is_worker() const;
+		bool run_pending_task();
+		static thread_pool &get_default();
+	private:
+		struct loop_state;
+		struct task_queue;
+		void worker_loop(unsigned int);
+		bool pop_task(unsigned int, task_type &);
+		static void run_loop(const boost::shared_ptr<loop_state> &);
+		static void lock_default();
+		static void unlock_default();
+		static void child_default();
+		// Number of workers.
+		unsigned int					m_size;
+		// Task queues, one per worker.
+		std::vector<boost::shared_ptr<task_queue> >	m_queues;
+		// Index of the worker running the current thread (null outside the workers of this pool).
+		boost::thread_specific_ptr<unsigned int>	m_worker_idx;
+		// Mutex and condition variable used by idle workers to wait for new tasks. They protect the following data members.
+		boost::mutex					m_mutex;
+		boost::condition_variable			m_cond;
+		// Number of tasks sitting in the queues.
+		std::size_t					m_n_tasks;
+		// Queue receiving the next task enqueued from outside the pool.
+		unsigned int					m_next_queue;
+		// Shutdown flag.
+		bool						m_stop;
+		// Set in a child process forked after the creation of the pool, where the workers are not running.
+		bool						m_forked;
+		// Worker threads.
+		boost::thread_group				m_workers;
+};
+
+}}
+
+#endif
@@ -22,13 +22,151 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "../src/pagmo.h"
 
 using namespace pagmo;
 
+// Size of the serialized state of a population.
+template <class OArchive>
+static std::size_t state_size(population &pop)
+{
+	std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
+	{
+		OArchive oa(oss,boost::archive::no_header);
+		population::state_proxy proxy(pop);
+		oa << proxy;
+	}
+	return oss.str().size();
+}
+
+// Compare the size of the messages and the latency of the evolution round trips for the available payload formats.
+static void benchmark_formats()
+{
+	problem::ackley prob(100);
+	population pop(prob,100);
+	std::cout << "State of " << pop.size() << " individuals of dimension " << prob.get_dimension() << ": "
+		<< state_size<boost::archive::text_oarchive>(pop) << " bytes (text), "
+		<< state_size<boost::archive::binary_oarchive>(pop) << " bytes (binary)" << std::endl;
+	const mpi_environment::archive_format formats[] = {mpi_environment::text_format, mpi_environment::binary_format};
+	const char *names[] = {"text", "binary"};
+	for (int i = 0; i < 2; ++i) {
+		mpi_environment::set_archive_format(formats[i]);
+		archipelago a;
+		for (int j = 0; j < 3; ++j) {
+			a.push_back(mpi_island(algorithm::null(),prob,100));
+		}
+		// Bind the sessions before timing.
+		a.evolve(1);
+		a.join();
+		const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+		for (int j = 0; j < 100; ++j) {
+			a.evolve(1);
+			a.join();
+		}
+		const boost::posix_time::time_duration elapsed = boost::posix_time::microsec_clock::local_time() - start;
+		std::cout << "Average round trip (" << names[i] << "): " << elapsed.total_microseconds() / 100 << " us" << std::endl;
+	}
+	mpi_environment::set_archive_format(mpi_environment::binary_format);
+}
+
+// Measure the latency of the evolution round trips with tiny payloads, dominated by the communication overhead.
+static void benchmark_latency()
+{
+	archipelago a;
+	for (int j = 0; j < 3; ++j) {
+		a.push_back(mpi_island(algorithm::null(),problem::dejong(1),1));
+	}
+	a.evolve(1);
+	a.join();
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	for (int j = 0; j < 1000; ++j) {
+		a.evolve(1);
+		a.join();
+	}
+	const boost::posix_time::time_duration elapsed = boost::posix_time::microsec_clock::local_time() - start;
+	std::cout << "Average round trip (tiny payload): " << elapsed.total_microseconds() / 1000 << " us" << std::endl;
+}
+
+// Send a request to the first slot of the first worker, binding the session (with the population pop) or evolving it, and
+// closing the dropped sessions. Return true if the worker evolved the session.
+static bool send_request(int kind, unsigned long session, unsigned long seq, const std::vector<std::pair<unsigned long,unsigned long> > &dropped,
+	population &pop)
+{
+	mpi_environment::request_header header;
+	header.m_kind = kind;
+	header.m_session = session;
+	header.m_seq = seq;
+	header.m_dropped = dropped;
+	std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
+	oss.put(static_cast<char>(mpi_environment::binary_format));
+	{
+		boost::archive::binary_oarchive oa(oss,boost::archive::no_header);
+		oa << header;
+		if (kind == mpi_environment::bind_request) {
+			const algorithm::monte_carlo algo(1);
+			const population *pop_ptr = &pop;
+			const algorithm::base *algo_ptr = &algo;
+			oa << pop_ptr;
+			oa << algo_ptr;
+		} else {
+			population::state_proxy proxy(pop);
+			oa << proxy;
+		}
+	}
+	std::string reply;
+	mpi_environment::exchange(oss.str(),reply,1,0);
+	std::istringstream iss(reply,std::ios_base::in | std::ios_base::binary);
+	iss.ignore(1);
+	boost::archive::binary_iarchive ia(iss,boost::archive::no_header);
+	bool ok;
+	ia >> ok;
+	return ok;
+}
+
+// The requests of different sessions are sent concurrently, hence a worker can receive the drop of a session before the
+// last request of the session sent before the drop, or after a request re-binding the dropped session. Reproduce both orders.
+static int test_eviction()
+{
+	population pop(problem::dejong(1),1);
+	const std::vector<std::pair<unsigned long,unsigned long> > none;
+	// NOTE: these identifiers are not used by the islands.
+	const unsigned long x = 1000000ul, y = 1000001ul, z = 1000002ul;
+	// The drop of x overtakes the evolution of x it follows: x must stay open until that evolution, and be closed afterwards.
+	bool ok = send_request(mpi_environment::bind_request,x,0,none,pop);
+	ok = ok && send_request(mpi_environment::bind_request,y,0,std::vector<std::pair<unsigned long,unsigned long> >(1,std::make_pair(x,1ul)),pop);
+	ok = ok && send_request(mpi_environment::evolve_request,x,1,none,pop);
+	if (!ok) {
+		std::cout << "session closed before the request preceding its drop" << std::endl;
+		return 1;
+	}
+	if (send_request(mpi_environment::evolve_request,x,2,none,pop)) {
+		std::cout << "dropped session leaked on the worker" << std::endl;
+		return 1;
+	}
+	// The re-bind of z overtakes a drop of z sent before it: the new session must stay open.
+	ok = send_request(mpi_environment::bind_request,z,0,none,pop);
+	ok = ok && send_request(mpi_environment::bind_request,z,1,none,pop);
+	ok = ok && send_request(mpi_environment::evolve_request,y,1,std::vector<std::pair<unsigned long,unsigned long> >(1,std::make_pair(z,0ul)),pop);
+	ok = ok && send_request(mpi_environment::evolve_request,z,2,none,pop);
+	if (!ok) {
+		std::cout << "re-bound session closed by an earlier drop" << std::endl;
+		return 1;
+	}
+	std::cout << "session eviction passes" << std::endl;
+	return 0;
+}
+
 int main()
 {
-	mpi_environment env;
+	// Run two evolutions at a time on each process, in order to exercise the worker-side thread pools.
+	mpi_environment env(2);
 	problem::dejong prob(1);
 	algorithm::monte_carlo algo(1);
 	archipelago a;
@@ -42,5 +180,10 @@ int main()
 	}
 	a.evolve(100);
 	a.join();
+	if (test_eviction()) {
+		return 1;
+	}
+	benchmark_formats();
+	benchmark_latency();
 	return 0;
 }
@@ -97,6 +97,8 @@ int main()
 	algos_new.push_back(algorithm::bee_colony().clone());
 	algos.push_back(algorithm::cmaes(gen,0.5, 0.5, 0.5, 0.5, 0.7, 1e-5, 1e-5, false).clone());
 	algos_new.push_back(algorithm::cmaes().clone());
+	algos.push_back(algorithm::cmaes_restart(algorithm::cmaes(gen,0.5, 0.5, 0.5, 0.5, 0.7, 1e-5, 1e-5, false),2,algorithm::cmaes_restart::BIPOP,3).clone());
+	algos_new.push_back(algorithm::cmaes_restart().clone());
 	algos.push_back(algorithm::cs(gen*10,0.02,0.3,0.3).clone());
 	algos_new.push_back(algorithm::cs().clone());
 	algos.push_back(algorithm::de(gen,0.9,0.9,3).clone());
@@ -24,12 +24,19 @@
 
 // Test for getters and setters
 
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <algorithm>
 #include <cmath>
 #include <vector>
 #include <cassert>
+#include <cstdio>
+#include <fstream>
 #include "../src/pagmo.h"
+#include "../src/util/thread_pool.h"
 
 using namespace pagmo;
 
@@ -50,6 +57,341 @@ int test_distribution_type() {
 	return 0;
 }
 
+// Islands are evolved on a thread pool: many more islands than threads must be evolved concurrently, and evolutions must be interruptible.
+int test_evolution() {
+	archipelago a(algorithm::de(5),problem::ackley(5),64,20,topology::ring());
+	a.evolve(3);
+	a.join();
+	if (a.busy()) {
+		std::cout << "archipelago still busy after join" << std::endl;
+		return 1;
+	}
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		if (a.get_island(i)->get_population().problem().get_fevals() <= 20) {
+			std::cout << "island " << i << " has not been evolved" << std::endl;
+			return 1;
+		}
+	}
+	island isl(algorithm::de(5),problem::ackley(5),20);
+	isl.evolve_t(100000);
+	isl.interrupt();
+	if (isl.busy() || isl.get_evolution_time() >= 100000) {
+		std::cout << "island evolution has not been interrupted" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Migration must take place for every combination of distribution type and migration direction, and the state of the
+// migration mailboxes must survive copies and serialization.
+int test_migration() {
+	const archipelago::distribution_type types[] = {archipelago::point_to_point, archipelago::broadcast};
+	const archipelago::migration_direction dirs[] = {archipelago::source, archipelago::destination};
+	for (int i = 0; i < 2; ++i) {
+		for (int j = 0; j < 2; ++j) {
+			archipelago a(algorithm::de(2),problem::ackley(5),32,10,topology::fully_connected(),types[i],dirs[j]);
+			a.set_seeds(42);
+			a.evolve(5);
+			a.join();
+			if (a.dump_migr_history().empty()) {
+				std::cout << "no migration with distribution type " << i << " and migration direction " << j << std::endl;
+				return 1;
+			}
+			archipelago b(a);
+			std::stringstream ss;
+			{
+				boost::archive::text_oarchive oa(ss);
+				oa << b;
+			}
+			archipelago c;
+			{
+				boost::archive::text_iarchive ia(ss);
+				ia >> c;
+			}
+			c.clear_migr_history();
+			c.evolve(2);
+			c.join();
+			if (c.get_size() != a.get_size() || c.dump_migr_history().empty()) {
+				std::cout << "no migration after deserialization with distribution type " << i << " and migration direction " << j << std::endl;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+// Migration history sink counting the records.
+struct count_records
+{
+	explicit count_records(std::size_t &count):m_count(count) {}
+	void operator()(population::size_type, archipelago::size_type, archipelago::size_type) const
+	{
+		++m_count;
+	}
+	std::size_t &m_count;
+};
+
+// The in-memory migration history must be bounded by its capacity, while the sink must receive every record.
+int test_migr_history() {
+	archipelago a(algorithm::de(2),problem::ackley(5),16,10,topology::fully_connected(),archipelago::broadcast,archipelago::destination);
+	if (a.get_migr_history_capacity() != archipelago::default_migr_hist_capacity) {
+		std::cout << "wrong default migration history capacity" << std::endl;
+		return 1;
+	}
+	std::size_t n_records = 0;
+	a.set_migr_history_sink(count_records(n_records));
+	a.set_migr_history_capacity(20);
+	a.evolve(10);
+	a.join();
+	std::istringstream iss(a.dump_migr_history());
+	std::size_t n_lines = 0;
+	for (std::string line; std::getline(iss,line);) {
+		++n_lines;
+	}
+	if (n_records <= 20 || n_lines != 20) {
+		std::cout << "migration history is not bounded: " << n_records << " records, " << n_lines << " kept" << std::endl;
+		return 1;
+	}
+	a.set_migr_history_capacity(5);
+	archipelago b(a);
+	if (b.get_migr_history_capacity() != 5 || b.dump_migr_history() != a.dump_migr_history()) {
+		std::cout << "migration history not copied" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Total number of objective function evaluations performed by the islands.
+static unsigned int total_fevals(const archipelago &a)
+{
+	unsigned int retval = 0;
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		retval += a.get_island(i)->get_population().problem().get_fevals();
+	}
+	return retval;
+}
+
+// Immigrants must be re-evaluated only when moving between islands holding different problems.
+int test_immigrants_evaluation() {
+	// The null algorithm performs no evaluation, hence all evaluations come from migration.
+	archipelago a(algorithm::null(),problem::zdt(1,10),8,10,topology::fully_connected(),archipelago::broadcast,archipelago::destination);
+	unsigned int fevals = total_fevals(a);
+	a.evolve(3);
+	a.join();
+	if (a.dump_migr_history().empty() || total_fevals(a) != fevals) {
+		std::cout << "immigrants re-evaluated in homogeneous archipelago" << std::endl;
+		return 1;
+	}
+	// ZDT1 and ZDT2 differ in the problem number, which is compared by problem::zdt::equality_operator_extra().
+	// NOTE: the evaluation cache of the problems absorbs repeated evaluations of the same immigrants, hence count
+	// the evaluations of the first migration only.
+	a.set_island(0,island(algorithm::null(),problem::zdt(2,10),10));
+	fevals = total_fevals(a);
+	a.evolve(1);
+	a.join();
+	if (total_fevals(a) == fevals) {
+		std::cout << "immigrants not re-evaluated in heterogeneous archipelago" << std::endl;
+		return 1;
+	}
+	// Fitness carried over by the immigrants must match the one of the destination problem.
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		const population pop = a.get_island(i)->get_population();
+		for (population::size_type j = 0; j < pop.size(); ++j) {
+			if (pop.get_individual(j).cur_f != pop.problem().objfun(pop.get_individual(j).cur_x)) {
+				std::cout << "wrong fitness of individual " << j << " on island " << i << std::endl;
+				return 1;
+			}
+		}
+	}
+	// Problems not guaranteeing exact equality always need their immigrants re-evaluated.
+	archipelago b(algorithm::null(),problem::dejong(10),4,10,topology::fully_connected(),archipelago::broadcast,archipelago::destination);
+	fevals = total_fevals(b);
+	b.evolve(3);
+	b.join();
+	if (total_fevals(b) == fevals) {
+		std::cout << "immigrants not re-evaluated among problems without exact equality" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Islands evolved with a budget of evaluations must perform at least that many evaluations each, and their champions must be
+// available while they are evolving.
+int test_async_evolution() {
+	archipelago a((topology::ring()));
+	for (int i = 0; i < 4; ++i) {
+		if (i % 2) {
+			a.push_back(island(algorithm::sga(1),problem::ackley(10),20));
+		} else {
+			a.push_back(island(algorithm::de(1),problem::ackley(10),20));
+		}
+	}
+	std::vector<unsigned int> fevals;
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		fevals.push_back(a.get_island(i)->get_problem()->get_fevals());
+	}
+	a.evolve_fevals(1000);
+	a.join();
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		if (a.get_island(i)->get_problem()->get_fevals() - fevals[i] < 1000) {
+			std::cout << "island " << i << " has not exhausted its budget of evaluations" << std::endl;
+			return 1;
+		}
+	}
+	// An algorithm which does not evaluate the objective function must not evolve forever.
+	island null_isl(algorithm::null(),problem::ackley(10),20);
+	null_isl.evolve_fevals(1000);
+	null_isl.join();
+	// Champions must be readable during the evolution.
+	// NOTE: get_size() joins the archipelago, hence it must be called before starting the evolution.
+	const archipelago::size_type size = a.get_size();
+	const std::vector<population::champion_type> start = a.get_champions();
+	a.evolve_fevals(1 << 30);
+	const std::vector<population::champion_type> current = a.get_champions();
+	if (!a.busy() || current.size() != size) {
+		std::cout << "champions not available during the evolution" << std::endl;
+		return 1;
+	}
+	a.interrupt();
+	for (archipelago::size_type i = 0; i < size; ++i) {
+		if (current[i].f.size() != 1 || a.get_island(i)->get_champion().f != a.get_island(i)->get_population().champion().f ||
+			a.get_island(i)->get_champion().f[0] > start[i].f[0])
+		{
+			std::cout << "wrong champion of island " << i << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Check that two archipelagos hold the same islands.
+static bool same_islands(const archipelago &a, const archipelago &b)
+{
+	if (a.get_size() != b.get_size()) {
+		return false;
+	}
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		const population pa = a.get_island(i)->get_population(), pb = b.get_island(i)->get_population();
+		if (pa.size() != pb.size() || pa.champion().x != pb.champion().x ||
+			a.get_island(i)->get_algorithm()->get_name() != b.get_island(i)->get_algorithm()->get_name())
+		{
+			return false;
+		}
+		for (population::size_type j = 0; j < pa.size(); ++j) {
+			if (pa.get_individual(j).cur_x != pb.get_individual(j).cur_x || pa.get_individual(j).cur_f != pb.get_individual(j).cur_f ||
+				pa.get_individual(j).best_x != pb.get_individual(j).best_x)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+int test_checkpoint() {
+	const std::string prefix("test_archipelago_checkpoint");
+	archipelago a(algorithm::de(1),problem::ackley(10),3,20);
+	a.set_checkpoint(prefix,0);
+	a.evolve(3);
+	a.join();
+	// With a null interval, the islands are saved in the background at the end of each iteration.
+	archipelago b;
+	b.load_checkpoint(prefix);
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		if (a.get_island(i)->get_evolution_time() != b.get_island(i)->get_evolution_time()) {
+			std::cout << "evolution time of island " << i << " not restored" << std::endl;
+			return 1;
+		}
+		if (a.get_island(i)->get_problem()->get_fevals() != b.get_island(i)->get_problem()->get_fevals() ||
+			a.get_island(i)->get_problem()->get_cevals() != b.get_island(i)->get_problem()->get_cevals())
+		{
+			std::cout << "evaluation counters of island " << i << " not restored" << std::endl;
+			return 1;
+		}
+	}
+	if (!same_islands(a,b)) {
+		std::cout << "islands not restored from the checkpoint" << std::endl;
+		return 1;
+	}
+	// The random number generators are restored too, hence the restored archipelago evolves like the original one.
+	a.evolve(2);
+	b.evolve(2);
+	if (!same_islands(a,b)) {
+		std::cout << "restored archipelago does not evolve like the original one" << std::endl;
+		return 1;
+	}
+	// Islands which have not evolved since their last write are not written again.
+	std::remove((prefix + ".island0").c_str());
+	a.checkpoint();
+	if (std::ifstream((prefix + ".island0").c_str())) {
+		std::cout << "unchanged island written again" << std::endl;
+		return 1;
+	}
+	// A change of structure rewrites the structure file, and the island files become stale.
+	a.set_algorithm(1,algorithm::sga(1));
+	a.checkpoint();
+	b.load_checkpoint(prefix);
+	if (!same_islands(a,b)) {
+		std::cout << "structure not restored from the checkpoint" << std::endl;
+		return 1;
+	}
+	std::remove((prefix + ".archipelago").c_str());
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		std::remove((prefix + ".island" + boost::lexical_cast<std::string>(i)).c_str());
+	}
+	return 0;
+}
+
+// The problems and the migration mailboxes are restored too: islands evolved one at a time, with migration, evolve like the original ones.
+int test_checkpoint_migration() {
+	const std::string prefix("test_archipelago_checkpoint_migration");
+	archipelago a(algorithm::de(1),problem::ackley(10),3,20,topology::ring());
+	a.set_checkpoint(prefix,0);
+	a.evolve_batch(2,1,false);
+	a.join();
+	if (a.dump_migr_history().empty()) {
+		std::cout << "no migration before the checkpoint" << std::endl;
+		return 1;
+	}
+	archipelago b;
+	b.load_checkpoint(prefix);
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		if (a.get_island(i)->get_population().problem().get_fevals() != b.get_island(i)->get_population().problem().get_fevals()) {
+			std::cout << "problem of island " << i << " not restored" << std::endl;
+			return 1;
+		}
+	}
+	a.evolve_batch(2,1,false);
+	b.evolve_batch(2,1,false);
+	if (!same_islands(a,b)) {
+		std::cout << "restored archipelago does not migrate like the original one" << std::endl;
+		return 1;
+	}
+	std::remove((prefix + ".archipelago").c_str());
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		std::remove((prefix + ".island" + boost::lexical_cast<std::string>(i)).c_str());
+	}
+	return 0;
+}
+
+// Islands evolving archipelagos of their own (as algorithm::pade does) must not deadlock, even when they keep all the workers of the
+// thread pool busy (e.g., with a pool of a single thread).
+int test_nested_evolution() {
+	std::vector<island> islands;
+	for (unsigned int i = 0; i < util::thread_pool::get_default().size(); ++i) {
+		islands.push_back(island(algorithm::pade(2,1),problem::zdt(1,10),20));
+	}
+	for (std::vector<island>::size_type i = 0; i < islands.size(); ++i) {
+		islands[i].evolve(1);
+	}
+	for (std::vector<island>::size_type i = 0; i < islands.size(); ++i) {
+		islands[i].join();
+	}
+	std::cout << "nested evolution passes" << std::endl;
+	return 0;
+}
+
 int main() {
-	return test_distribution_type();
+	return test_distribution_type() || test_evolution() || test_migration() || test_migr_history() || test_immigrants_evaluation() ||
+		test_async_evolution() || test_checkpoint() || test_checkpoint_migration() || test_nested_evolution();
 }
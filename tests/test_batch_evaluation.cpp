@@ -0,0 +1,326 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the batch evaluation of problems and for the thread pool backing it.
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/pagmo.h"
+#include "../src/util/thread_pool.h"
+#include "test.h"
+
+using namespace pagmo;
+
+static void square_entry(std::vector<double> &v, std::size_t i)
+{
+	v[i] = static_cast<double>(i) * static_cast<double>(i);
+}
+
+static void throw_on_entry(std::size_t i)
+{
+	if (i == 7) {
+		throw std::runtime_error("failed");
+	}
+}
+
+// The thread pool must run every iteration exactly once and propagate exceptions to the caller.
+int test_thread_pool()
+{
+	util::thread_pool pool(4);
+	std::vector<double> v(1000,-1.);
+	pool.parallel_for(v.size(),boost::bind(square_entry,boost::ref(v),_1));
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		if (v[i] != static_cast<double>(i) * static_cast<double>(i)) {
+			std::cout << "thread_pool::parallel_for failed at iteration " << i << std::endl;
+			return 1;
+		}
+	}
+	try {
+		pool.parallel_for(100,throw_on_entry);
+		std::cout << "thread_pool::parallel_for did not propagate the exception" << std::endl;
+		return 1;
+	} catch (const std::runtime_error &) {}
+	std::cout << "thread_pool passes" << std::endl;
+	return 0;
+}
+
+// Wait for flag to be set by another task of pool, helping the pool in the meantime.
+static void wait_flag(util::thread_pool &pool, const bool &flag, boost::mutex &mutex)
+{
+	while (true) {
+		{
+			boost::lock_guard<boost::mutex> lock(mutex);
+			if (flag) {
+				return;
+			}
+		}
+		if (!pool.run_pending_task()) {
+			boost::this_thread::yield();
+		}
+	}
+}
+
+static void set_flag(bool &flag, boost::mutex &mutex)
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+	flag = true;
+}
+
+// Enqueue a task, and wait for it while helping the pool.
+static void nested_task(util::thread_pool &pool, bool &inner, bool &outer, boost::mutex &mutex)
+{
+	pool.enqueue(boost::bind(set_flag,boost::ref(inner),boost::ref(mutex)));
+	wait_flag(pool,inner,mutex);
+	set_flag(outer,mutex);
+}
+
+// A task of a single-thread pool waiting for a task queued behind it must not deadlock when it helps the pool.
+int test_nested_tasks()
+{
+	util::thread_pool pool(1);
+	if (pool.is_worker()) {
+		std::cout << "thread_pool::is_worker failed" << std::endl;
+		return 1;
+	}
+	bool inner = false, outer = false;
+	boost::mutex mutex;
+	pool.enqueue(boost::bind(nested_task,boost::ref(pool),boost::ref(inner),boost::ref(outer),boost::ref(mutex)));
+	boost::unique_lock<boost::mutex> lock(mutex);
+	while (!outer) {
+		lock.unlock();
+		boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+		lock.lock();
+	}
+	std::cout << "thread_pool nested tasks pass" << std::endl;
+	return 0;
+}
+
+// Ackley problem which can be evaluated only from the thread which created it, like the problems implemented in Python.
+class thread_bound_problem: public problem::ackley
+{
+	public:
+		thread_bound_problem():problem::ackley(10),m_thread(boost::this_thread::get_id()) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new thread_bound_problem(*this));
+		}
+		bool parallel_batch() const
+		{
+			return false;
+		}
+	protected:
+		void objfun_impl(fitness_vector &f, const decision_vector &x) const
+		{
+			if (boost::this_thread::get_id() != m_thread) {
+				pagmo_throw(std::runtime_error,"evaluation from a thread of the pool");
+			}
+			problem::ackley::objfun_impl(f,x);
+		}
+	private:
+		boost::thread::id m_thread;
+};
+
+// Meta-problems must evaluate their batches serially when the original problem requires so.
+int test_thread_bound(const problem::base &prob)
+{
+	if (prob.parallel_batch()) {
+		std::cout << prob.get_name() << " does not forward parallel_batch()" << std::endl;
+		return 1;
+	}
+	population pop(prob,50);
+	std::vector<decision_vector> x;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(pop.get_individual(i).cur_x);
+	}
+	std::vector<fitness_vector> f;
+	try {
+		prob.clone()->batch_objfun(f,x);
+	} catch (const std::runtime_error &e) {
+		std::cout << prob.get_name() << " batch evaluation failed: " << e.what() << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << " serial batch evaluation passes" << std::endl;
+	return 0;
+}
+
+// Batch evaluation must be equivalent to serial evaluation, and must play well with the cache.
+int test_batch(const problem::base &prob)
+{
+	const problem::base_ptr serial = prob.clone(), batch = prob.clone();
+	// Problems may be evaluated during construction (e.g., to compute the fitness of the known optima).
+	const unsigned int fevals = batch->get_fevals();
+	population pop(prob,50);
+	std::vector<decision_vector> x;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(pop.get_individual(i).cur_x);
+	}
+	std::vector<fitness_vector> f;
+	std::vector<constraint_vector> c;
+	batch->batch_objfun(f,x);
+	batch->batch_compute_constraints(c,x);
+	if (f.size() != x.size() || c.size() != x.size()) {
+		std::cout << prob.get_name() << " batch sizes failed" << std::endl;
+		return 1;
+	}
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		if (f[i] != serial->objfun(x[i]) || c[i] != serial->compute_constraints(x[i])) {
+			std::cout << prob.get_name() << " batch evaluation failed at index " << i << std::endl;
+			PRINT_VEC(f[i]);
+			PRINT_VEC(serial->objfun(x[i]));
+			return 1;
+		}
+	}
+	if (batch->get_fevals() - fevals != x.size() || batch->get_fevals() != serial->get_fevals() || batch->get_cevals() != serial->get_cevals()) {
+		std::cout << prob.get_name() << " batch evaluation counters failed" << std::endl;
+		return 1;
+	}
+	// Re-evaluating the most recent decision vectors must hit the cache.
+	const std::vector<decision_vector> last(x.end() - problem::base::cache_capacity,x.end());
+	batch->batch_objfun(f,last);
+	if (batch->get_fevals() - fevals != x.size()) {
+		std::cout << prob.get_name() << " batch evaluation cache failed" << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << " batch evaluation passes" << std::endl;
+	return 0;
+}
+
+static void evaluate_entry(const problem::base &prob, const std::vector<decision_vector> &x, std::vector<fitness_vector> &f, std::size_t i)
+{
+	f[i] = prob.objfun(x[i]);
+}
+
+// A thread-safe problem must be usable concurrently from multiple threads, without any clone.
+int test_shared(const problem::base &prob)
+{
+	if (!prob.thread_safe()) {
+		std::cout << prob.get_name() << " is expected to be thread-safe" << std::endl;
+		return 1;
+	}
+	const problem::base_ptr shared = prob.clone(), serial = prob.clone();
+	const unsigned int fevals = shared->get_fevals();
+	population pop(prob,200);
+	std::vector<decision_vector> x;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(pop.get_individual(i).cur_x);
+	}
+	std::vector<fitness_vector> f(x.size());
+	util::thread_pool pool(4);
+	pool.parallel_for(x.size(),boost::bind(evaluate_entry,boost::cref(*shared),boost::cref(x),boost::ref(f),_1));
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		if (f[i] != serial->objfun(x[i])) {
+			std::cout << prob.get_name() << " concurrent evaluation failed at index " << i << std::endl;
+			return 1;
+		}
+	}
+	if (shared->get_fevals() - fevals != x.size()) {
+		std::cout << prob.get_name() << " concurrent evaluation counter failed" << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << " concurrent evaluation passes" << std::endl;
+	return 0;
+}
+
+// Evolutions evaluating whole generations in batch must be the same as the serial ones.
+template <class Algorithm>
+int test_batch_evolution(const Algorithm &algo, const problem::base &prob)
+{
+	Algorithm serial(algo), batch(algo);
+	serial.reset_rngs(42);
+	batch.reset_rngs(42);
+	serial.set_batch_evaluation(false);
+	batch.set_batch_evaluation(true);
+	population serial_pop(prob,40);
+	population batch_pop(serial_pop);
+	for (int i = 0; i < 3; ++i) {
+		serial.evolve(serial_pop);
+		batch.evolve(batch_pop);
+	}
+	for (population::size_type i = 0; i < serial_pop.size(); ++i) {
+		if (serial_pop.get_individual(i).cur_x != batch_pop.get_individual(i).cur_x ||
+			serial_pop.get_individual(i).cur_v != batch_pop.get_individual(i).cur_v ||
+			serial_pop.get_individual(i).cur_f != batch_pop.get_individual(i).cur_f)
+		{
+			std::cout << algo.get_name() << " batch evolution differs from the serial one at individual " << i << std::endl;
+			return 1;
+		}
+	}
+	std::cout << algo.get_name() << " batch evolution passes" << std::endl;
+	return 0;
+}
+
+// Swarm evolutions must evaluate each particle once per generation, and commit consistent current and best fitness vectors.
+template <class Algorithm>
+int test_swarm_evolution(const Algorithm &algo, int gen, const problem::base &prob)
+{
+	population pop(prob,30,123);
+	const unsigned int fevals = pop.problem().get_fevals();
+	algo.evolve(pop);
+	if (pop.problem().get_fevals() - fevals != gen * pop.size()) {
+		std::cout << algo.get_name() << " performed " << pop.problem().get_fevals() - fevals << " evaluations instead of " << gen * pop.size() << std::endl;
+		return 1;
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const population::individual_type &ind = pop.get_individual(i);
+		if (ind.cur_f != pop.problem().objfun(ind.cur_x) || ind.best_f != pop.problem().objfun(ind.best_x) ||
+			pop.problem().compare_fitness(ind.cur_f,ind.best_f))
+		{
+			std::cout << algo.get_name() << " committed inconsistent vectors at individual " << i << std::endl;
+			return 1;
+		}
+	}
+	std::cout << algo.get_name() << " swarm evolution passes" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = test_thread_pool();
+	res = res || test_nested_tasks();
+	res = res || test_batch(problem::ackley(10));
+	res = res || test_batch(problem::zdt(1,30));
+	res = res || test_batch(problem::luksan_vlcek_1(10));
+	res = res || test_batch(problem::inventory(7,15,123));
+	res = res || test_shared(problem::rastrigin(20));
+	res = res || test_thread_bound(problem::shifted(thread_bound_problem()));
+	res = res || test_thread_bound(problem::rotated(thread_bound_problem()));
+	res = res || test_thread_bound(problem::noisy(thread_bound_problem()));
+	res = res || test_thread_bound(problem::robust(thread_bound_problem()));
+	res = res || test_batch_evolution(algorithm::de(20),problem::ackley(10));
+	res = res || test_batch_evolution(algorithm::jde(20),problem::rosenbrock(10));
+	res = res || test_batch_evolution(algorithm::de_1220(20),problem::ackley(10));
+	res = res || test_batch_evolution(algorithm::mde_pbx(20),problem::rastrigin(10));
+	res = res || test_swarm_evolution(algorithm::pso(20),20,problem::ackley(10));
+	res = res || test_swarm_evolution(algorithm::pso(20,0.7298,2.05,2.05,0.5,6,3),20,problem::rosenbrock(10));
+	res = res || test_swarm_evolution(algorithm::pso_generational(20),20,problem::ackley(10));
+	res = res || test_swarm_evolution(algorithm::pso_generational(20,0.7298,2.05,2.05,0.5,1,1),20,problem::rosenbrock(10));
+	return res;
+}
@@ -0,0 +1,148 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the restarts of cmaes.
+
+#include <iostream>
+
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Restarting cmaes must never worsen the champion of the population, whatever the strategy.
+int test_restarts(algorithm::cmaes_restart::restart_type type, const problem::base &prob)
+{
+	algorithm::cmaes_restart algo(algorithm::cmaes(100),4,type);
+	algo.reset_rngs(42);
+	population pop(prob,10,123);
+	const population::champion_type start = pop.champion();
+	const unsigned int fevals = pop.problem().get_fevals();
+	algo.evolve(pop);
+	if (pop.size() != 10 || !prob.compare_fc(pop.champion().f,pop.champion().c,start.f,start.c)) {
+		std::cout << algo.get_name() << " (" << type << ") did not improve the champion on " << prob.get_name() << std::endl;
+		return 1;
+	}
+	// Each of the 5 runs evaluates at least a generation of 5 individuals on a copy of the problem.
+	if (pop.problem().get_fevals() - fevals < 25u) {
+		std::cout << algo.get_name() << " (" << type << ") did not report its evaluations on " << prob.get_name() << std::endl;
+		return 1;
+	}
+	std::cout << algo.get_name() << " (" << type << ") on " << prob.get_name() << ": " << pop.champion().f[0] << std::endl;
+	return 0;
+}
+
+// Ackley problem counting the evaluations performed by the instance itself (copies start counting from zero).
+class counting_problem: public problem::ackley
+{
+	public:
+		counting_problem():problem::ackley(5),m_count(0) {}
+		counting_problem(const counting_problem &p):problem::ackley(p),m_count(0) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new counting_problem(*this));
+		}
+		bool thread_safe() const
+		{
+			return false;
+		}
+		mutable unsigned int m_count;
+	protected:
+		void objfun_impl(fitness_vector &f, const decision_vector &x) const
+		{
+			++m_count;
+			problem::ackley::objfun_impl(f,x);
+		}
+};
+
+// The restarts evolve copies of the population: the individuals they bring back are already evaluated, and must not be
+// evaluated again by the problem of the population.
+int test_no_reevaluation()
+{
+	algorithm::cmaes_restart algo(algorithm::cmaes(50),4,algorithm::cmaes_restart::IPOP);
+	algo.reset_rngs(42);
+	population pop(counting_problem(),10,123);
+	const population::champion_type start = pop.champion();
+	const unsigned int count = dynamic_cast<const counting_problem &>(pop.problem()).m_count;
+	algo.evolve(pop);
+	if (!pop.problem().compare_fc(pop.champion().f,pop.champion().c,start.f,start.c) || pop.champion().f == start.f) {
+		std::cout << "cmaes_restart did not bring back any individual" << std::endl;
+		return 1;
+	}
+	if (dynamic_cast<const counting_problem &>(pop.problem()).m_count != count) {
+		std::cout << "cmaes_restart re-evaluated the individuals brought back by the restarts" << std::endl;
+		return 1;
+	}
+	std::cout << "cmaes_restart re-evaluation passes" << std::endl;
+	return 0;
+}
+
+// On stochastic problems each generation is appended to the population after a batch evaluation.
+int test_stochastic()
+{
+	problem::noisy prob(problem::ackley(5),3,0,0.1);
+	algorithm::cmaes algo(20);
+	population pop(prob,10,123);
+	algo.evolve(pop);
+	if (pop.size() != 10) {
+		std::cout << "cmaes changed the population size on a stochastic problem" << std::endl;
+		return 1;
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		if (pop.get_individual(i).cur_f != pop.problem().objfun(pop.get_individual(i).cur_x)) {
+			std::cout << "cmaes stored a wrong fitness on a stochastic problem at individual " << i << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "cmaes on stochastic problem passes" << std::endl;
+	return 0;
+}
+
+// Invalid parameters must be rejected.
+int test_parameters()
+{
+	try {
+		algorithm::cmaes_restart algo(algorithm::cmaes(),-1);
+		std::cout << "negative number of restarts accepted" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	try {
+		algorithm::cmaes_restart algo(algorithm::cmaes(),1,algorithm::cmaes_restart::IPOP,0.5);
+		std::cout << "population size increase factor smaller than 1 accepted" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	return 0;
+}
+
+int main()
+{
+	int res = test_parameters();
+	res = res || test_restarts(algorithm::cmaes_restart::IPOP,problem::rastrigin(5));
+	res = res || test_restarts(algorithm::cmaes_restart::BIPOP,problem::rastrigin(5));
+	res = res || test_restarts(algorithm::cmaes_restart::IPOP,problem::schwefel(5));
+	res = res || test_restarts(algorithm::cmaes_restart::BIPOP,problem::schwefel(5));
+	res = res || test_stochastic();
+	res = res || test_no_reevaluation();
+	return res;
+}
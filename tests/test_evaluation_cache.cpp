@@ -0,0 +1,166 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the LRU cache and for the evaluation caches of problems.
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "../src/pagmo.h"
+#include "../src/util/lru_cache.h"
+#include "test.h"
+
+using namespace pagmo;
+
+static std::vector<double> key(double x)
+{
+	return std::vector<double>(3,x);
+}
+
+// Entries must be evicted in least-recently-used order, and copies must be independent.
+int test_lru_cache()
+{
+	util::lru_cache cache(3);
+	std::vector<double> v;
+	for (int i = 0; i < 3; ++i) {
+		cache.insert(key(i),key(10 * i));
+	}
+	// Touch 0, so that 1 becomes the least recently used entry.
+	if (!cache.find(key(0),v) || v != key(0)) {
+		std::cout << "lru_cache lookup failed" << std::endl;
+		return 1;
+	}
+	cache.insert(key(3),key(30));
+	if (cache.size() != 3u || cache.find(key(1),v) || !cache.find(key(0),v) || !cache.find(key(2),v) || !cache.find(key(3),v)) {
+		std::cout << "lru_cache eviction failed" << std::endl;
+		return 1;
+	}
+	// Zeroes of different sign are the same key.
+	cache.insert(key(0.),key(-1.));
+	if (!cache.find(key(-0.),v) || v != key(-1.) || cache.size() != 3u) {
+		std::cout << "lru_cache signed zero lookup failed" << std::endl;
+		return 1;
+	}
+	if (cache.get_hits() != 5u || cache.get_misses() != 1u) {
+		std::cout << "lru_cache statistics failed" << std::endl;
+		return 1;
+	}
+	// Keys containing NaNs must not be stored.
+	for (int i = 0; i < 10; ++i) {
+		std::vector<double> nan_key(key(i));
+		nan_key[1] = std::numeric_limits<double>::quiet_NaN();
+		cache.insert(nan_key,key(i));
+		if (cache.find(nan_key,v) || cache.size() != 3u) {
+			std::cout << "lru_cache NaN key insertion failed" << std::endl;
+			return 1;
+		}
+	}
+	if (!cache.find(key(0.),v) || !cache.find(key(2),v) || !cache.find(key(3),v)) {
+		std::cout << "lru_cache lookup after NaN key insertion failed" << std::endl;
+		return 1;
+	}
+	util::lru_cache copy(cache);
+	cache.clear();
+	if (!copy.find(key(3),v) || v != key(30) || cache.find(key(3),v)) {
+		std::cout << "lru_cache copy failed" << std::endl;
+		return 1;
+	}
+	copy.set_capacity(1);
+	if (copy.size() != 1u || !copy.find(key(3),v)) {
+		std::cout << "lru_cache shrinking failed" << std::endl;
+		return 1;
+	}
+	std::stringstream ss;
+	{
+		boost::archive::text_oarchive oa(ss);
+		oa << copy;
+	}
+	util::lru_cache loaded;
+	{
+		boost::archive::text_iarchive ia(ss);
+		ia >> loaded;
+	}
+	if (loaded.get_capacity() != 1u || !loaded.find(key(3),v) || v != key(30)) {
+		std::cout << "lru_cache serialization failed" << std::endl;
+		return 1;
+	}
+	std::cout << "lru_cache passes" << std::endl;
+	return 0;
+}
+
+// With a large enough cache, re-evaluating a whole population must not call the objective function again.
+int test_problem_cache(const problem::base &prob)
+{
+	const problem::base_ptr p = prob.clone();
+	population pop(prob,100);
+	// Problems may be evaluated during construction (e.g., to compute the fitness of the known optima).
+	const unsigned int fevals = p->get_fevals();
+	const std::size_t hits = p->get_cache_hits(), misses = p->get_cache_misses();
+	p->set_cache_capacity(pop.size());
+	if (p->get_cache_capacity() != pop.size()) {
+		std::cout << prob.get_name() << " cache capacity setter failed" << std::endl;
+		return 1;
+	}
+	for (int r = 0; r < 2; ++r) {
+		for (population::size_type i = 0; i < pop.size(); ++i) {
+			if (p->objfun(pop.get_individual(i).cur_x) != pop.get_individual(i).cur_f) {
+				std::cout << prob.get_name() << " cached evaluation failed at index " << i << std::endl;
+				return 1;
+			}
+		}
+	}
+	if (p->get_fevals() - fevals != pop.size() || p->get_cache_misses() - misses != pop.size() || p->get_cache_hits() - hits != pop.size()) {
+		std::cout << prob.get_name() << " cache statistics failed" << std::endl;
+		return 1;
+	}
+	// Caches are emptied, but their capacity is kept.
+	p->reset_caches();
+	p->objfun(pop.get_individual(0).cur_x);
+	if (p->get_fevals() - fevals != pop.size() + 1u || p->get_cache_capacity() != pop.size()) {
+		std::cout << prob.get_name() << " cache reset failed" << std::endl;
+		return 1;
+	}
+	// A null capacity disables caching.
+	p->set_cache_capacity(0);
+	p->objfun(pop.get_individual(0).cur_x);
+	if (p->get_fevals() - fevals != pop.size() + 2u) {
+		std::cout << prob.get_name() << " cache disabling failed" << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << " cache passes" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = test_lru_cache();
+	res = res || test_problem_cache(problem::ackley(10));
+	res = res || test_problem_cache(problem::zdt(1,30));
+	return res;
+}
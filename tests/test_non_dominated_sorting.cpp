@@ -0,0 +1,147 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the non-dominated sorting of fitness vectors and populations.
+
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "../src/pagmo.h"
+#include "../src/rng.h"
+#include "../src/util/non_dominated_sorting.h"
+#include "test.h"
+
+using namespace pagmo;
+
+// The fast sorting must produce the same ranks as the pairwise comparison of all the vectors. Fitness values
+// are drawn from a small set of integers when n_values is not null, in order to produce ties and duplicates.
+int test_ranks(std::size_t n, std::size_t m, unsigned int n_values)
+{
+	rng_double drng(static_cast<boost::uint32_t>(n * 10 + m));
+	std::vector<fitness_vector> f(n,fitness_vector(m));
+	for (std::size_t i = 0; i < n; ++i) {
+		for (std::size_t j = 0; j < m; ++j) {
+			f[i][j] = n_values ? static_cast<double>(static_cast<unsigned int>(drng() * n_values)) : drng();
+		}
+	}
+	const std::vector<std::size_t> ranks = util::non_dominated_sorting::compute_ranks(f), ref = util::non_dominated_sorting::compute_ranks_pairwise(f);
+	if (ranks != ref) {
+		std::cout << "ranks failed with n = " << n << ", m = " << m << ", n_values = " << n_values << std::endl;
+		return 1;
+	}
+	// The fronts must be consistent with the ranks.
+	const util::non_dominated_sorting::fronts_type fronts = util::non_dominated_sorting::compute_fronts(f);
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < fronts.size(); ++i) {
+		for (std::size_t j = 0; j < fronts[i].size(); ++j, ++count) {
+			if (ranks[fronts[i][j]] != i) {
+				std::cout << "fronts failed with n = " << n << ", m = " << m << ", n_values = " << n_values << std::endl;
+				return 1;
+			}
+		}
+	}
+	if (count != n) {
+		std::cout << "fronts size failed with n = " << n << ", m = " << m << ", n_values = " << n_values << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Fitness vectors of different dimensions must be rejected.
+int test_wrong_dimension()
+{
+	std::vector<fitness_vector> f(3,fitness_vector(2));
+	f[1].push_back(0.);
+	try {
+		util::non_dominated_sorting::compute_ranks(f);
+		std::cout << "compute_ranks accepted fitness vectors of different dimensions" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	return 0;
+}
+
+// The Pareto ranks of a population must match the ranks obtained by peeling off the non-dominated individuals according to compare_fc().
+int test_population_ranks(const problem::base &prob)
+{
+	population pop(prob,100,123);
+	pop.update_pareto_information();
+	std::vector<population::size_type> ref(pop.size());
+	std::vector<bool> assigned(pop.size(),false);
+	population::size_type n_assigned = 0;
+	for (population::size_type rank = 0; n_assigned < pop.size(); ++rank) {
+		std::vector<population::size_type> front;
+		for (population::size_type i = 0; i < pop.size(); ++i) {
+			if (assigned[i]) {
+				continue;
+			}
+			bool dominated = false;
+			for (population::size_type j = 0; j < pop.size() && !dominated; ++j) {
+				const population::individual_type &ind_i = pop.get_individual(i), &ind_j = pop.get_individual(j);
+				dominated = !assigned[j] && prob.compare_fc(ind_j.best_f,ind_j.best_c,ind_i.best_f,ind_i.best_c);
+			}
+			if (!dominated) {
+				front.push_back(i);
+			}
+		}
+		for (population::size_type i = 0; i < front.size(); ++i) {
+			ref[front[i]] = rank;
+			assigned[front[i]] = true;
+		}
+		n_assigned += front.size();
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		if (pop.get_pareto_rank(i) != ref[i]) {
+			std::cout << prob.get_name() << " Pareto rank failed at index " << i << std::endl;
+			return 1;
+		}
+	}
+	std::cout << prob.get_name() << " Pareto ranks pass" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = test_wrong_dimension();
+	const std::size_t sizes[] = {0, 1, 2, 10, 100, 500};
+	const unsigned int n_values[] = {0, 2, 5};
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(std::size_t); ++i) {
+		for (std::size_t m = 1; m <= 5; ++m) {
+			for (std::size_t k = 0; k < sizeof(n_values) / sizeof(unsigned int); ++k) {
+				res = res || test_ranks(sizes[i],m,n_values[k]);
+			}
+		}
+	}
+	if (!res) {
+		std::cout << "ranks pass" << std::endl;
+	}
+	res = res || test_population_ranks(problem::zdt(1,10));
+	res = res || test_population_ranks(problem::dtlz(2,10,3));
+	res = res || test_population_ranks(problem::fon());
+	res = res || test_population_ranks(problem::cec2009(1,10,true));
+	res = res || test_population_ranks(problem::luksan_vlcek_1(10));
+	return res;
+}
@@ -0,0 +1,401 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the bookkeeping of the population class.
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/pagmo.h"
+#include "test.h"
+
+using namespace pagmo;
+
+// Setting an individual with known fitness and constraints must be equivalent to setting it via evaluation,
+// without evaluating the problem.
+int test_set_x_known_fc(const problem::base &prob)
+{
+	population pop1(prob,20,123), pop2(prob,20,123), other(prob,20,456);
+	const unsigned int fevals = pop2.problem().get_fevals(), cevals = pop2.problem().get_cevals();
+	for (population::size_type i = 0; i < pop1.size(); ++i) {
+		const population::individual_type &ind = other.get_individual(i);
+		pop1.set_x(i,ind.cur_x);
+		pop2.set_x(i,ind.cur_x,ind.cur_f,ind.cur_c);
+	}
+	if (pop2.problem().get_fevals() != fevals || pop2.problem().get_cevals() != cevals) {
+		std::cout << prob.get_name() << " set_x with known fitness evaluated the problem" << std::endl;
+		return 1;
+	}
+	for (population::size_type i = 0; i < pop1.size(); ++i) {
+		const population::individual_type &ind1 = pop1.get_individual(i), &ind2 = pop2.get_individual(i);
+		if (ind1.cur_f != ind2.cur_f || ind1.cur_c != ind2.cur_c || ind1.best_x != ind2.best_x || ind1.best_f != ind2.best_f ||
+			pop1.get_domination_count(i) != pop2.get_domination_count(i) || pop1.get_domination_list(i) != pop2.get_domination_list(i))
+		{
+			std::cout << prob.get_name() << " set_x with known fitness failed at index " << i << std::endl;
+			return 1;
+		}
+	}
+	if (pop1.champion().x != pop2.champion().x) {
+		std::cout << prob.get_name() << " set_x with known fitness failed to update the champion" << std::endl;
+		return 1;
+	}
+	// The same goes for appending individuals.
+	const unsigned int fevals_push = pop2.problem().get_fevals();
+	for (population::size_type i = 0; i < 5; ++i) {
+		const population::individual_type &ind = other.get_individual(i);
+		pop1.push_back(ind.cur_x);
+		pop2.push_back(ind.cur_x,ind.cur_f,ind.cur_c);
+	}
+	if (pop2.problem().get_fevals() != fevals_push || pop1.size() != pop2.size() || pop1.champion().x != pop2.champion().x ||
+		pop1.get_individual(pop1.size() - 1).best_f != pop2.get_individual(pop2.size() - 1).best_f)
+	{
+		std::cout << prob.get_name() << " push_back with known fitness failed" << std::endl;
+		return 1;
+	}
+	// Vectors with wrong dimensions must be rejected.
+	try {
+		pop2.set_x(0,other.get_individual(0).cur_x,fitness_vector(prob.get_f_dimension() + 1),other.get_individual(0).cur_c);
+		std::cout << prob.get_name() << " set_x with known fitness accepted a wrong fitness dimension" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	try {
+		pop2.push_back(other.get_individual(0).cur_x,fitness_vector(prob.get_f_dimension() + 1),other.get_individual(0).cur_c);
+		std::cout << prob.get_name() << " push_back with known fitness accepted a wrong fitness dimension" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	if (pop2.size() != pop1.size()) {
+		std::cout << prob.get_name() << " failed push_back with known fitness modified the population" << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << " set_x with known fitness passes" << std::endl;
+	return 0;
+}
+
+// Setting a whole individual must be equivalent to setting its best and current decision vectors in turn, without evaluating the problem.
+int test_set_individual(const problem::base &prob)
+{
+	population pop1(prob,20,123), pop2(prob,20,123), other(prob,20,456);
+	const unsigned int fevals = pop2.problem().get_fevals();
+	for (population::size_type i = 0; i < pop1.size(); ++i) {
+		// Use the better of the two individuals as best, the other as current.
+		const population::individual_type &a = pop1.get_individual(i), &b = other.get_individual(i);
+		const bool a_better = prob.compare_fc(a.cur_f,a.cur_c,b.cur_f,b.cur_c);
+		const population::individual_type &best = a_better ? a : b, &cur = a_better ? b : a;
+		population::individual_type ind;
+		ind.cur_x = cur.cur_x;
+		ind.cur_v = cur.cur_v;
+		ind.cur_f = cur.cur_f;
+		ind.cur_c = cur.cur_c;
+		ind.best_x = best.cur_x;
+		ind.best_f = best.cur_f;
+		ind.best_c = best.cur_c;
+		pop1.set_x(i,ind.best_x,ind.best_f,ind.best_c);
+		pop1.set_x(i,ind.cur_x,ind.cur_f,ind.cur_c);
+		pop1.set_v(i,ind.cur_v);
+		pop2.set_individual(i,ind);
+	}
+	if (pop2.problem().get_fevals() != fevals) {
+		std::cout << prob.get_name() << " set_individual evaluated the problem" << std::endl;
+		return 1;
+	}
+	for (population::size_type i = 0; i < pop1.size(); ++i) {
+		const population::individual_type &ind1 = pop1.get_individual(i), &ind2 = pop2.get_individual(i);
+		if (ind1.cur_x != ind2.cur_x || ind1.cur_v != ind2.cur_v || ind1.cur_f != ind2.cur_f || ind1.best_x != ind2.best_x ||
+			ind1.best_f != ind2.best_f || pop1.get_domination_count(i) != pop2.get_domination_count(i))
+		{
+			std::cout << prob.get_name() << " set_individual failed at index " << i << std::endl;
+			return 1;
+		}
+	}
+	if (pop1.champion().x != pop2.champion().x || pop1.get_best_idx() != pop2.get_best_idx()) {
+		std::cout << prob.get_name() << " set_individual failed to update the champion" << std::endl;
+		return 1;
+	}
+	// Individuals with wrong dimensions must be rejected.
+	population::individual_type ind = pop2.get_individual(0);
+	ind.cur_v.push_back(0.);
+	try {
+		pop2.set_individual(0,ind);
+		std::cout << prob.get_name() << " set_individual accepted a wrong velocity dimension" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	std::cout << prob.get_name() << " set_individual passes" << std::endl;
+	return 0;
+}
+
+// Check the domination information of pop against a brute-force computation.
+static int check_domination(const population &pop)
+{
+	const problem::base &prob = pop.problem();
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		population::size_type count = 0;
+		std::vector<population::size_type> list;
+		for (population::size_type j = 0; j < pop.size(); ++j) {
+			const population::individual_type &ind_i = pop.get_individual(i), &ind_j = pop.get_individual(j);
+			if (prob.compare_fc(ind_j.best_f,ind_j.best_c,ind_i.best_f,ind_i.best_c)) {
+				++count;
+			}
+			if (prob.compare_fc(ind_i.best_f,ind_i.best_c,ind_j.best_f,ind_j.best_c)) {
+				list.push_back(j);
+			}
+		}
+		std::vector<population::size_type> pop_list(pop.get_domination_list(i));
+		std::sort(pop_list.begin(),pop_list.end());
+		if (pop.get_domination_count(i) != count || pop_list != list) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Domination information must be correct regardless of the number of individuals modified between two accesses.
+int test_domination(const problem::base &prob)
+{
+	population pop(prob,40,123), other(prob,60,456);
+	if (check_domination(pop)) {
+		std::cout << prob.get_name() << " domination after construction failed" << std::endl;
+		return 1;
+	}
+	population::size_type k = 0;
+	// Modify an increasing number of individuals between checks, so that both the incremental and the full updates are exercised.
+	for (population::size_type n_mod = 1; n_mod <= pop.size(); n_mod *= 2) {
+		for (population::size_type i = 0; i < n_mod; ++i, ++k) {
+			pop.set_x((k * 7) % pop.size(),other.get_individual(k % other.size()).cur_x);
+		}
+		if (check_domination(pop)) {
+			std::cout << prob.get_name() << " domination after " << n_mod << " modifications failed" << std::endl;
+			return 1;
+		}
+	}
+	// Erasures and insertions with outdated domination information.
+	pop.set_x(3,other.get_individual(0).cur_x);
+	pop.set_x(10,other.get_individual(1).cur_x);
+	pop.erase(5);
+	pop.erase(9);
+	pop.push_back(other.get_individual(2).cur_x);
+	if (check_domination(pop)) {
+		std::cout << prob.get_name() << " domination after erasure failed" << std::endl;
+		return 1;
+	}
+	// Copies must carry the outdated information along.
+	pop.set_x(0,other.get_individual(3).cur_x);
+	const population copy(pop);
+	if (check_domination(copy)) {
+		std::cout << prob.get_name() << " domination after copy failed" << std::endl;
+		return 1;
+	}
+	// The human-readable representation must display up-to-date information.
+	pop.set_x(1,other.get_individual(4).cur_x);
+	pop.set_x(2,other.get_individual(5).cur_x);
+	const std::string repr = pop.human_readable();
+	pop.get_domination_count(0);
+	if (repr != pop.human_readable()) {
+		std::cout << prob.get_name() << " domination in human-readable representation failed" << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << " domination passes" << std::endl;
+	return 0;
+}
+
+// Check the structure-of-arrays representation of pop against its individuals.
+static int check_soa(const population &pop)
+{
+	const population::soa_type &soa = pop.get_soa();
+	const util::aligned_matrix *matrices[] = {&soa.cur_x, &soa.cur_v, &soa.cur_c, &soa.cur_f, &soa.best_x, &soa.best_c, &soa.best_f};
+	for (std::size_t k = 0; k < sizeof(matrices) / sizeof(matrices[0]); ++k) {
+		if (matrices[k]->rows() != pop.size() || (matrices[k]->data() &&
+			reinterpret_cast<std::size_t>(matrices[k]->data()) % util::aligned_matrix::alignment != 0))
+		{
+			return 1;
+		}
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const population::individual_type &ind = pop.get_individual(i);
+		if (soa.cur_x.get_row(i) != ind.cur_x || soa.cur_v.get_row(i) != ind.cur_v || soa.cur_c.get_row(i) != ind.cur_c ||
+			soa.cur_f.get_row(i) != ind.cur_f || soa.best_x.get_row(i) != ind.best_x || soa.best_c.get_row(i) != ind.best_c ||
+			soa.best_f.get_row(i) != ind.best_f)
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// The structure-of-arrays representation must follow the modifications of the population.
+int test_soa(const problem::base &prob)
+{
+	population pop(prob,30,123), other(prob,30,456);
+	if (check_soa(pop)) {
+		std::cout << prob.get_name() << " structure-of-arrays after construction failed" << std::endl;
+		return 1;
+	}
+	pop.set_x(3,other.get_individual(0).cur_x);
+	pop.set_v(7,other.get_individual(1).cur_v);
+	if (check_soa(pop)) {
+		std::cout << prob.get_name() << " structure-of-arrays after modification failed" << std::endl;
+		return 1;
+	}
+	pop.set_x(1,other.get_individual(2).cur_x);
+	pop.push_back(other.get_individual(3).cur_x);
+	pop.erase(0);
+	pop.erase(pop.size() - 1);
+	pop.push_back(other.get_individual(4).cur_x);
+	if (check_soa(pop)) {
+		std::cout << prob.get_name() << " structure-of-arrays after erasure failed" << std::endl;
+		return 1;
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		pop.set_x(i,other.get_individual(i).cur_x);
+	}
+	pop.set_x(2,other.get_individual(5).cur_x);
+	const population copy(pop);
+	if (check_soa(copy) || check_soa(pop)) {
+		std::cout << prob.get_name() << " structure-of-arrays after copy failed" << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << " structure-of-arrays passes" << std::endl;
+	return 0;
+}
+
+// Check the positions of the best and worst individuals of pop against a linear scan (ties go to the lowest position).
+static int check_extrema(const population &pop)
+{
+	const problem::base &prob = pop.problem();
+	population::size_type best = 0, worst = 0;
+	for (population::size_type i = 1; i < pop.size(); ++i) {
+		const population::individual_type &ind = pop.get_individual(i);
+		if (prob.compare_fc(ind.cur_f,ind.cur_c,pop.get_individual(best).cur_f,pop.get_individual(best).cur_c)) {
+			best = i;
+		}
+		if (prob.compare_fc(pop.get_individual(worst).cur_f,pop.get_individual(worst).cur_c,ind.cur_f,ind.cur_c)) {
+			worst = i;
+		}
+	}
+	return pop.get_best_idx() != best || pop.get_worst_idx() != worst;
+}
+
+// The positions of the best and worst individuals must follow the modifications of the population, including ties.
+int test_extrema(const problem::base &prob)
+{
+	population pop(prob,30,123), other(prob,30,456);
+	if (check_extrema(pop)) {
+		std::cout << prob.get_name() << " best/worst after construction failed" << std::endl;
+		return 1;
+	}
+	for (population::size_type k = 0; k < 200; ++k) {
+		const population::size_type i = (k * 7) % pop.size();
+		if (k % 3) {
+			pop.set_x(i,other.get_individual(k % other.size()).cur_x);
+		} else {
+			// Copy another individual, creating a tie.
+			const population::individual_type ind = pop.get_individual((k * 11) % pop.size());
+			pop.set_x(i,ind.cur_x,ind.cur_f,ind.cur_c);
+		}
+		if (check_extrema(pop)) {
+			std::cout << prob.get_name() << " best/worst after modification " << k << " failed" << std::endl;
+			return 1;
+		}
+	}
+	const population::size_type best = pop.get_best_idx();
+	pop.erase(best == 0 ? 1 : 0);
+	pop.erase(pop.get_worst_idx());
+	pop.push_back(other.get_individual(0).cur_x);
+	pop.erase(pop.get_best_idx());
+	const population copy(pop);
+	if (check_extrema(pop) || check_extrema(copy)) {
+		std::cout << prob.get_name() << " best/worst after erasure failed" << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << " best/worst passes" << std::endl;
+	return 0;
+}
+
+// Transferring the state of a population must reproduce it in a population holding its own copy of the problem.
+template <class OArchive, class IArchive>
+int test_state_proxy(const problem::base &prob)
+{
+	population pop(prob,20,123), other(prob,5,456);
+	pop.set_x(3,other.get_individual(0).cur_x);
+	std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+	{
+		OArchive oa(ss);
+		population::state_proxy proxy(pop);
+		oa << proxy;
+	}
+	{
+		IArchive ia(ss);
+		population::state_proxy proxy(other);
+		ia >> proxy;
+	}
+	if (other.size() != pop.size() || other.champion().x != pop.champion().x || check_soa(other) || check_domination(other)) {
+		std::cout << prob.get_name() << " state transfer failed" << std::endl;
+		return 1;
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		if (other.get_individual(i).cur_x != pop.get_individual(i).cur_x || other.get_individual(i).best_f != pop.get_individual(i).best_f ||
+			other.get_pareto_rank(i) != pop.get_pareto_rank(i))
+		{
+			std::cout << prob.get_name() << " state transfer failed at individual " << i << std::endl;
+			return 1;
+		}
+	}
+	// The random number generators are part of the state.
+	pop.reinit(0);
+	other.reinit(0);
+	if (other.get_individual(0).cur_x != pop.get_individual(0).cur_x) {
+		std::cout << prob.get_name() << " state transfer of random number generators failed" << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << " state transfer passes" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = test_set_x_known_fc(problem::ackley(10));
+	res = res || test_set_x_known_fc(problem::zdt(1,10));
+	res = res || test_set_x_known_fc(problem::luksan_vlcek_1(10));
+	res = res || test_set_individual(problem::ackley(10));
+	res = res || test_set_individual(problem::luksan_vlcek_1(10));
+	res = res || test_domination(problem::zdt(1,10));
+	res = res || test_domination(problem::dtlz(2,10,3));
+	res = res || test_domination(problem::luksan_vlcek_1(10));
+	res = res || test_soa(problem::ackley(10));
+	res = res || test_soa(problem::zdt(1,10));
+	res = res || test_soa(problem::luksan_vlcek_1(10));
+	res = res || test_extrema(problem::ackley(10));
+	res = res || test_extrema(problem::luksan_vlcek_1(10));
+	res = res || test_state_proxy<boost::archive::text_oarchive,boost::archive::text_iarchive>(problem::ackley(10));
+	res = res || test_state_proxy<boost::archive::text_oarchive,boost::archive::text_iarchive>(problem::zdt(1,10));
+	res = res || test_state_proxy<boost::archive::binary_oarchive,boost::archive::binary_iarchive>(problem::ackley(10));
+	res = res || test_state_proxy<boost::archive::binary_oarchive,boost::archive::binary_iarchive>(problem::zdt(1,10));
+	return res;
+}
@@ -0,0 +1,299 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the process island.
+
+#include <boost/bind.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../src/pagmo.h"
+#include "../src/util/thread_pool.h"
+
+using namespace pagmo;
+
+// Ackley problem crashing when evaluated in a process other than the one which created it.
+class crash_problem: public problem::ackley
+{
+	public:
+		crash_problem():problem::ackley(10),m_pid(static_cast<int>(::getpid())) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new crash_problem(*this));
+		}
+		std::string get_name() const
+		{
+			return "Crash problem";
+		}
+	protected:
+		void objfun_impl(fitness_vector &f, const decision_vector &x) const
+		{
+			if (static_cast<int>(::getpid()) != m_pid) {
+				std::abort();
+			}
+			problem::ackley::objfun_impl(f,x);
+		}
+	private:
+		friend class boost::serialization::access;
+		template <class Archive>
+		void serialize(Archive &ar, const unsigned int)
+		{
+			ar & boost::serialization::base_object<problem::ackley>(*this);
+			ar & m_pid;
+		}
+		int m_pid;
+};
+
+BOOST_CLASS_EXPORT(crash_problem)
+
+// Ackley problem slowing down the evaluations performed in a process other than the one which created it.
+class slow_problem: public problem::ackley
+{
+	public:
+		slow_problem():problem::ackley(10),m_pid(static_cast<int>(::getpid())) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new slow_problem(*this));
+		}
+		std::string get_name() const
+		{
+			return "Slow problem";
+		}
+	protected:
+		void objfun_impl(fitness_vector &f, const decision_vector &x) const
+		{
+			if (static_cast<int>(::getpid()) != m_pid) {
+				::usleep(50000);
+			}
+			problem::ackley::objfun_impl(f,x);
+		}
+	private:
+		friend class boost::serialization::access;
+		template <class Archive>
+		void serialize(Archive &ar, const unsigned int)
+		{
+			ar & boost::serialization::base_object<problem::ackley>(*this);
+			ar & m_pid;
+		}
+		int m_pid;
+};
+
+BOOST_CLASS_EXPORT(slow_problem)
+
+static bool same_population(const population &p1, const population &p2)
+{
+	if (p1.size() != p2.size()) {
+		return false;
+	}
+	for (population::size_type i = 0; i < p1.size(); ++i) {
+		if (p1.get_individual(i).cur_x != p2.get_individual(i).cur_x || p1.get_individual(i).cur_f != p2.get_individual(i).cur_f ||
+			p1.get_individual(i).cur_v != p2.get_individual(i).cur_v || p1.get_individual(i).best_x != p2.get_individual(i).best_x ||
+			p1.get_individual(i).best_f != p2.get_individual(i).best_f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// The evolutions performed in the worker process must be the same as the evolutions performed locally, both when the session
+// is bound and when it is reused.
+int test_equivalence()
+{
+	const population pop(problem::ackley(10),20);
+	algorithm::de algo(5);
+	island local_isl(algo,pop);
+	process_island process_isl(algo,pop);
+	for (int i = 0; i < 3; ++i) {
+		local_isl.evolve(1);
+		process_isl.evolve(1);
+		local_isl.join();
+		process_isl.join();
+		if (!same_population(local_isl.get_population(),process_isl.get_population())) {
+			std::cout << "evolution " << i << " in the worker process differs from the local one" << std::endl;
+			return 1;
+		}
+	}
+	// Changing the algorithm re-binds the session.
+	const algorithm::sga sga(1);
+	local_isl.set_algorithm(sga);
+	process_isl.set_algorithm(sga);
+	local_isl.evolve(2);
+	process_isl.evolve(2);
+	local_isl.join();
+	process_isl.join();
+	if (!same_population(local_isl.get_population(),process_isl.get_population())) {
+		std::cout << "evolution after the change of algorithm differs from the local one" << std::endl;
+		return 1;
+	}
+	// A larger population does not fit in the shared region of the worker process, and a new one is forked.
+	// NOTE: the algorithm is reset as well, as the new worker process starts from the state of the algorithm of the island.
+	const population large_pop(problem::ackley(10),200);
+	local_isl.set_population(large_pop);
+	process_isl.set_population(large_pop);
+	local_isl.set_algorithm(algo);
+	process_isl.set_algorithm(algo);
+	for (int i = 0; i < 2; ++i) {
+		local_isl.evolve(1);
+		process_isl.evolve(1);
+		local_isl.join();
+		process_isl.join();
+		if (!same_population(local_isl.get_population(),process_isl.get_population())) {
+			std::cout << "evolution " << i << " of the larger population differs from the local one" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "process island equivalence passes" << std::endl;
+	return 0;
+}
+
+// A crash of the worker process must leave the island usable, with its population untouched.
+int test_crash()
+{
+	process_island isl(algorithm::de(1),crash_problem(),20);
+	const population pop = isl.get_population();
+	for (int i = 0; i < 2; ++i) {
+		isl.evolve(1);
+		isl.join();
+		if (!same_population(pop,isl.get_population())) {
+			std::cout << "population modified by a crashed evolution" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "process island crash passes" << std::endl;
+	return 0;
+}
+
+// Process islands must migrate like the other islands.
+int test_archipelago()
+{
+	archipelago a((topology::ring()));
+	for (int i = 0; i < 4; ++i) {
+		a.push_back(process_island(algorithm::de(10),problem::ackley(10),20));
+	}
+	const std::vector<population::champion_type> start = a.get_champions();
+	a.evolve(5);
+	a.join();
+	if (a.dump_migr_history().empty()) {
+		std::cout << "no migration among process islands" << std::endl;
+		return 1;
+	}
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		if (a.get_island(i)->get_population().champion().f[0] > start[i].f[0]) {
+			std::cout << "process island " << i << " has not been evolved" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "process island archipelago passes" << std::endl;
+	return 0;
+}
+
+// Process islands waiting for their worker processes must not keep the workers of the thread pool busy.
+int test_blocking()
+{
+	archipelago a;
+	for (unsigned int i = 0; i < util::thread_pool::get_default().size(); ++i) {
+		a.push_back(process_island(algorithm::de(1),slow_problem(),10));
+	}
+	a.evolve(1);
+	island isl(algorithm::de(1),problem::ackley(10),10);
+	isl.evolve(1);
+	isl.join();
+	if (!a.busy()) {
+		std::cout << "island evolution held up by process islands" << std::endl;
+		return 1;
+	}
+	a.join();
+	std::cout << "process island blocking passes" << std::endl;
+	return 0;
+}
+
+// The evaluations performed by the worker process must be reported to the problem of the island.
+int test_fevals()
+{
+	process_island isl(algorithm::de(1),problem::ackley(10),20);
+	const unsigned int start = isl.get_population().problem().get_fevals();
+	isl.evolve_fevals(200);
+	isl.join();
+	if (isl.get_population().problem().get_fevals() - start < 200u) {
+		std::cout << "evaluations of the worker process not reported to the island" << std::endl;
+		return 1;
+	}
+	std::cout << "process island evaluations pass" << std::endl;
+	return 0;
+}
+
+static void mark_iteration(std::vector<int> &done, std::size_t i)
+{
+	++done[i];
+}
+
+// In a forked child the process-wide pool has no workers: loops must run inline, without enqueueing helper tasks nobody would run.
+int test_forked_pool()
+{
+	util::thread_pool &pool = util::thread_pool::get_default();
+	const pid_t pid = ::fork();
+	if (pid < 0) {
+		std::cout << "cannot fork" << std::endl;
+		return 1;
+	}
+	if (!pid) {
+		std::vector<int> done(100,0);
+		pool.parallel_for(done.size(),boost::bind(&mark_iteration,boost::ref(done),_1));
+		bool ok = pool.size() == 0u;
+		for (std::vector<int>::size_type i = 0; i < done.size(); ++i) {
+			ok = ok && done[i] == 1;
+		}
+		// Batch evaluation must work as well.
+		problem::ackley prob(10);
+		population pop(prob,20);
+		std::vector<decision_vector> x;
+		for (population::size_type i = 0; i < pop.size(); ++i) {
+			x.push_back(pop.get_individual(i).cur_x);
+		}
+		std::vector<fitness_vector> f;
+		prob.batch_objfun(f,x);
+		ok = ok && f.size() == x.size();
+		::_exit(ok ? 0 : 1);
+	}
+	int status;
+	::waitpid(pid,&status,0);
+	if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+		std::cout << "the thread pool is not usable in a forked child process" << std::endl;
+		return 1;
+	}
+	std::cout << "forked thread pool passes" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_equivalence() || test_crash() || test_archipelago() || test_blocking() || test_fevals() || test_forked_pool();
+}